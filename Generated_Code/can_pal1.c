@@ -63,7 +63,7 @@ const can_instance_t can_pal1_instance = {CAN_INST_TYPE_FLEXCAN, 0U};
 
 /*! @brief User configuration structure */
 const can_user_config_t can_pal1_Config0 = {
-    .maxBuffNum = 2UL,
+    .maxBuffNum = 8UL,
     .mode = CAN_NORMAL_MODE,
     .peClkSrc = CAN_CLK_SOURCE_OSC,
     .enableFD = false,
@@ -40,6 +40,9 @@ is aborted and LPSPI_STATUS_SBC_UJA_TIMEOUT error is reported. */
 #define SBC_UJA_COUNT_ID_REG           4U
 #define SBC_UJA_COUNT_MASK             4U
 #define SBC_UJA_COUNT_DMASK            8U
+
+#define SBC_UJA_BATCH_MAX_OPS          16U /*!< Maximum number of register
+accesses in one batched transfer. Each access is one 16 bit LPSPI frame. */
 /*******************************************************************************
  * Enumerations
  ******************************************************************************/
@@ -1479,6 +1482,28 @@ typedef struct{
     sbc_evn_capt_t events;                /*!< Event capture registers. */
 }sbc_status_group_t;
 
+/*!
+* @brief Register access of a batched transfer.
+* A write access sends data to the register, a read access stores
+* the register content to data.
+*
+* Implements    : sbc_reg_op_t_Class
+*/
+typedef struct{
+    sbc_register_t regName;               /*!< Register to access. */
+    bool isWrite;                         /*!< Write data to the register. */
+    uint8_t data;                         /*!< Data written or read. */
+}sbc_reg_op_t;
+
+/*!
+* @brief Completion callback of SBC_BatchTransferStart.
+* It is called from the LPSPI interrupt when all accesses are done.
+*
+* Implements    : sbc_batch_callback_t_Class
+*/
+typedef void (*sbc_batch_callback_t)(sbc_reg_op_t* ops, uint8_t count,
+        status_t status, void* param);
+
 /*******************************************************************************
  * API
  ******************************************************************************/
@@ -1950,4 +1975,74 @@ status_t SBC_DataTransfer(const sbc_register_t regName,
  */
 void SBC_FeedWatchdog(void);
 
+/*!
+ * @brief This function executes register accesses in one LPSPI transfer.
+ * Every access is a separate 16 bit SBC message, the chip select is
+ * released between frames by the LPSPI, so the accesses run back to back
+ * without CPU intervention. The shadow registers are updated.
+ *
+ * @param ops  register accesses, read data is stored back to it.
+ * @param count  number of accesses, 1 to SBC_UJA_BATCH_MAX_OPS.
+ * @return An error code or SBC_UJA_STAT_SUCCESS
+ */
+status_t SBC_BatchTransfer(sbc_reg_op_t* const ops, const uint8_t count);
+
+/*!
+ * @brief This function starts register accesses in one LPSPI transfer
+ * and returns immediately. The ops array must stay valid until the
+ * callback is called or SBC_GetBatchStatus does not return STATUS_BUSY.
+ *
+ * @param ops  register accesses, read data is stored back to it.
+ * @param count  number of accesses, 1 to SBC_UJA_BATCH_MAX_OPS.
+ * @param callback  called from the LPSPI interrupt at the end, can be NULL.
+ * @param param  parameter passed to the callback.
+ * @return An error code or SBC_UJA_STAT_SUCCESS
+ */
+status_t SBC_BatchTransferStart(sbc_reg_op_t* const ops, const uint8_t count,
+        const sbc_batch_callback_t callback, void* const param);
+
+/*!
+ * @brief This function returns the result of the last batched transfer.
+ *
+ * @return STATUS_BUSY while the transfer runs, otherwise its result.
+ */
+status_t SBC_GetBatchStatus(void);
+
+/*!
+ * @brief This function writes a configuration register to the shadow
+ * registers only. The register is marked dirty and written to the device
+ * by SBC_ShadowFlush.
+ *
+ * @param regName  configuration register.
+ * @param data  new register value.
+ * @return STATUS_ERROR if the register is not cached, otherwise
+ * SBC_UJA_STAT_SUCCESS
+ */
+status_t SBC_ShadowWrite(const sbc_register_t regName, const uint8_t data);
+
+/*!
+ * @brief This function reads a configuration register. The shadow register
+ * is returned if it is valid, otherwise the device is read.
+ *
+ * @param regName  register for reading.
+ * @param data  pointer for storing the register value.
+ * @return An error code or SBC_UJA_STAT_SUCCESS
+ */
+status_t SBC_ShadowRead(const sbc_register_t regName, uint8_t* const data);
+
+/*!
+ * @brief This function writes all dirty shadow registers to the device
+ * in batched transfers.
+ *
+ * @return An error code or SBC_UJA_STAT_SUCCESS
+ */
+status_t SBC_ShadowFlush(void);
+
+/*!
+ * @brief This function marks all shadow registers invalid, the next read
+ * of every register goes to the device. Use it after the SBC was reset
+ * without the MCU. Pending shadow writes are discarded.
+ */
+void SBC_ShadowInvalidate(void);
+
 #endif /* SOURCES_SBC_SBC_UJA_116X_H_ */
@@ -53,8 +53,17 @@
 
 #include "sbc_uja116x_driver.h"
 #include "clock_manager.h"
+#include "interrupt_manager.h"
 #include "osif.h"
 
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Shadow registers cover the 7 bit register address space. */
+#define SBC_UJA_SHADOW_SIZE            0x80U
+#define SBC_UJA_SHADOW_VALID           0x01U /* Shadow register equals the device. */
+#define SBC_UJA_SHADOW_DIRTY           0x02U /* Written by SBC_ShadowWrite, not flushed. */
+
 /*******************************************************************************
  * Variables - for internal use only.
  ******************************************************************************/
@@ -64,12 +73,31 @@ typedef struct{
     bool isInit;
 }drv_config_t;
 
+typedef struct{
+    sbc_reg_op_t* ops;
+    uint8_t count;
+    sbc_batch_callback_t callback;
+    void* callbackParam;
+    spi_callback_t spiCallback;        /* LPSPI callback restored at the end. */
+    void* spiCallbackParam;
+    volatile status_t status;
+    uint8_t txBuff[2U * SBC_UJA_BATCH_MAX_OPS];
+    uint8_t rxBuff[2U * SBC_UJA_BATCH_MAX_OPS];
+}batch_state_t;
+
 /*******************************************************************************
  * Variables
  ******************************************************************************/
 /* Structure for storing SBC internal runtime data. */
 static drv_config_t g_drvConfig;
 
+/* Batched transfer in progress or finished last. */
+static batch_state_t g_batch;
+
+/* Shadow copies of configuration registers, indexed by register address. */
+static uint8_t g_shadowReg[SBC_UJA_SHADOW_SIZE];
+static volatile uint8_t g_shadowFlags[SBC_UJA_SHADOW_SIZE];
+
 /*******************************************************************************
  * Private Functions
  ******************************************************************************/
@@ -79,6 +107,18 @@ static status_t sbc_read_can_others(sbc_can_conf_t* const can);
 static void sbc_clean_events_status(sbc_evn_capt_t *event);
 static status_t sbc_change_factories_direct(const sbc_factories_conf_t* const factory);
 static uint8_t sbc_get_factories_crc(uint8_t* data);
+static bool sbc_shadow_is_cached(const sbc_register_t regName);
+static void sbc_shadow_update(const sbc_register_t regName, const uint8_t data,
+        const bool isWrite);
+static status_t sbc_batch_lock(void);
+static void sbc_batch_prepare(sbc_reg_op_t* const ops, const uint8_t count);
+static status_t sbc_batch_finish(status_t status);
+static void sbc_batch_spi_callback(void *driverState, spi_event_t event, void *userData);
+static void sbc_decode_main_status(const uint8_t data, sbc_main_status_t* const mainStatus);
+static void sbc_decode_watchdog_status(const uint8_t data, sbc_wtdog_status_t* const watchdogStatus);
+static void sbc_decode_supply_status(const uint8_t data, sbc_supply_status_t* const supStatus);
+static void sbc_decode_can_status(const uint8_t data, sbc_trans_stat_t* const transStatus);
+static void sbc_decode_events_status(const uint8_t* const data, sbc_evn_capt_t* const events);
 
 /*******************************************************************************
  * Code
@@ -95,6 +135,9 @@ void SBC_InitDriver(const uint32_t lpspiInstance)
 {
     /* Set initial value */
     g_drvConfig.lpspiIntace = lpspiInstance;
+    g_batch.status = STATUS_SUCCESS;
+    /* Device registers are unknown until read or written. */
+    SBC_ShadowInvalidate();
     /* Device is being initialized. */
     g_drvConfig.isInit = true;
     /* Waiting while device leaves reset mode - no SPI access allowed. */
@@ -1033,9 +1076,7 @@ status_t SBC_GetMainStatus(sbc_main_status_t* const mainStatus)
 
         if(spiStat == STATUS_SUCCESS)
         {
-            mainStatus->otws = (sbc_main_otws_t)(readData & SBC_UJA_MAIN_OTWS_MASK);
-            mainStatus->nms = (sbc_main_nms_t)(readData & SBC_UJA_MAIN_NMS_MASK);
-            mainStatus->rss = (sbc_main_rss_t)(readData & SBC_UJA_MAIN_RSS_MASK);
+            sbc_decode_main_status(readData, mainStatus);
         }
 
     if(spiStat != STATUS_SUCCESS)
@@ -1071,9 +1112,7 @@ status_t SBC_GetWatchdogStatus(sbc_wtdog_status_t* const watchdogStatus)
 
     if(spiStat == STATUS_SUCCESS)
     {
-        watchdogStatus->fnms = (sbc_wtdog_stat_fnms_t)(readData & SBC_UJA_WTDOG_STAT_FNMS_MASK);
-        watchdogStatus->sdms = (sbc_wtdog_stat_sdms_t)(readData & SBC_UJA_WTDOG_STAT_SDMS_MASK);
-        watchdogStatus->wds = (sbc_wtdog_stat_wds_t)(readData & SBC_UJA_WTDOG_STAT_WDS_MASK);
+        sbc_decode_watchdog_status(readData, watchdogStatus);
         /* Clear fnnms and sdmms register. */
         readData &=  (uint8_t)~SBC_UJA_WTDOG_STAT_FNMS_MASK;
         readData &=  (uint8_t)~SBC_UJA_WTDOG_STAT_SDMS_MASK;
@@ -1113,8 +1152,7 @@ status_t SBC_GetSupplyStatus(sbc_supply_status_t* const supStatus)
 
     if(spiStat == STATUS_SUCCESS)
     {
-        supStatus->v2s = (sbc_supply_stat_v2s_t)(readData & SBC_UJA_SUPPLY_STAT_V2S_MASK);
-        supStatus->v1s = (sbc_supply_stat_v1s_t)(readData & SBC_UJA_SUPPLY_STAT_V1S_MASK);
+        sbc_decode_supply_status(readData, supStatus);
         /* Clear Supply status. */
         readData &= (uint8_t)~SBC_UJA_SUPPLY_STAT_V2S_MASK;
         readData &= (uint8_t)~SBC_UJA_SUPPLY_STAT_V1S_MASK;
@@ -1155,13 +1193,7 @@ status_t SBC_GetCanStatus(sbc_trans_stat_t* const transStatus)
 
     if(spiStat == STATUS_SUCCESS)
     {
-        transStatus->cts = (sbc_trans_stat_cts_t)(readData & SBC_UJA_TRANS_STAT_CTS_MASK);
-        transStatus->cpnerr = (sbc_trans_stat_cpnerr_t)(readData & SBC_UJA_TRANS_STAT_CPNERR_MASK);
-        transStatus->cpns = (sbc_trans_stat_cpns_t)(readData & SBC_UJA_TRANS_STAT_CPNS_MASK);
-        transStatus->coscs = (sbc_trans_stat_coscs_t)(readData & SBC_UJA_TRANS_STAT_COSCS_MASK);
-        transStatus->cbss = (sbc_trans_stat_cbss_t)(readData & SBC_UJA_TRANS_STAT_CBSS_MASK);
-        transStatus->vcs = (sbc_trans_stat_vcs_t)(readData & SBC_UJA_TRANS_STAT_VCS_MASK);
-        transStatus->cfs = (sbc_trans_stat_cfs_t)(readData & SBC_UJA_TRANS_STAT_CFS_MASK);
+        sbc_decode_can_status(readData, transStatus);
     }
 
     if(spiStat != STATUS_SUCCESS)
@@ -1225,83 +1257,31 @@ status_t SBC_GetEventsStatus(sbc_evn_capt_t* const events)
 {
     status_t ujaStat = STATUS_SUCCESS;
     status_t spiStat = STATUS_SUCCESS;
+    uint8_t readData[5] = {0U, 0U, 0U, 0U, 0U};
+    uint8_t i;
+    sbc_reg_op_t ops[5] = {
+        {SBC_UJA_GL_EVNT_STAT, false, 0U},
+        {SBC_UJA_SYS_EVNT_STAT, false, 0U},
+        {SBC_UJA_SUP_EVNT_STAT, false, 0U},
+        {SBC_UJA_TRANS_EVNT_STAT, false, 0U},
+        {SBC_UJA_WAKE_EVNT_STAT, false, 0U}
+    };
 
     DEV_ASSERT(events != NULL);
 
     /* Clean events statuses structure. */
     sbc_clean_events_status(events);
-    /* Global event status. */
-    uint8_t readData = 0U;
-    spiStat = SBC_DataTransfer(SBC_UJA_GL_EVNT_STAT, NULL, &readData );
-
-    sbc_gl_evnt_stat_t* glEvent = &events->glEvnt;
+    /* All event capture registers in one transfer, this is faster than
+     * reading the global event status first. */
+    spiStat = SBC_BatchTransfer(ops, 5U);
 
     if(spiStat == STATUS_SUCCESS)
     {
-        glEvent->wpe = (sbc_gl_evnt_stat_wpe_t)(readData & SBC_UJA_GL_EVNT_STAT_WPE_MASK);
-        glEvent->trxe = (sbc_gl_evnt_stat_trxe_t)(readData & SBC_UJA_GL_EVNT_STAT_TRXE_MASK);
-        glEvent->supe = (sbc_gl_evnt_stat_supe_t)(readData & SBC_UJA_GL_EVNT_STAT_SUPE_MASK);
-        glEvent->syse = (sbc_gl_evnt_stat_syse_t)(readData & SBC_UJA_GL_EVNT_STAT_SYSE_MASK);
-    }
-
-    /* System event status. */
-    readData = 0;
-    /* Test if System event occurred. */
-    if(glEvent->syse == SBC_UJA_GL_EVNT_STAT_SYSE)
-    {
-        spiStat = SBC_DataTransfer(SBC_UJA_SYS_EVNT_STAT, NULL, &readData );
-        if(spiStat == STATUS_SUCCESS)
+        for(i = 0U; i < 5U; i++)
         {
-            sbc_sys_evnt_stat_t* sysEvent = &events->sysEvnt;
-            sysEvent->po = (sbc_sys_evnt_stat_po_t)(readData & SBC_UJA_SYS_EVNT_STAT_PO_MASK);
-            sysEvent->otw = (sbc_sys_evnt_stat_otw_t)(readData & SBC_UJA_SYS_EVNT_STAT_OTW_MASK);
-            sysEvent->spif = (sbc_sys_evnt_stat_spif_t)(readData & SBC_UJA_SYS_EVNT_STAT_SPIF_MASK);
-            sysEvent->wdf = (sbc_sys_evnt_stat_wdf_t)(readData & SBC_UJA_SYS_EVNT_STAT_WDF_MASK);
-        }
-    }
-    /* Supply event status. */
-    readData = 0;
-    /* Test if Supply event occurred. */
-    if(glEvent->supe == SBC_UJA_GL_EVNT_STAT_SUPE)
-    {
-        spiStat = SBC_DataTransfer(SBC_UJA_SUP_EVNT_STAT, NULL, &readData );
-        if(spiStat == STATUS_SUCCESS)
-        {
-            sbc_sup_evnt_stat_t* supEvent = &events->supEvnt;
-            supEvent->v2o = (sbc_sup_evnt_stat_v2o_t)(readData & SBC_UJA_SUP_EVNT_STAT_V2O_MASK);
-            supEvent->v2u = (sbc_sup_evnt_stat_v2u_t)(readData & SBC_UJA_SUP_EVNT_STAT_V2U_MASK);
-            supEvent->v1u = (sbc_sup_evnt_stat_v1u_t)(readData & SBC_UJA_SUP_EVNT_STAT_V1U_MASK);
-        }
-    }
-
-    /* Transceiver event status. */
-    readData = 0;
-    /* Test if Transceiver event occurred. */
-    if(glEvent->trxe == SBC_UJA_GL_EVNT_STAT_TRXE)
-    {
-        spiStat = SBC_DataTransfer(SBC_UJA_TRANS_EVNT_STAT, NULL, &readData );
-        if(spiStat == STATUS_SUCCESS)
-        {
-            sbc_trans_evnt_stat_t* transEvent = &events->transEvnt;
-            transEvent->pnfde = (sbc_trans_evnt_stat_pnfde_t)(readData & SBC_UJA_TRANS_EVNT_STAT_PNFDE_MASK);
-            transEvent->cbs = (sbc_trans_evnt_stat_cbs_t)(readData & SBC_UJA_TRANS_EVNT_STAT_CBS_MASK);
-            transEvent->cf = (sbc_trans_evnt_stat_cf_t)(readData & SBC_UJA_TRANS_EVNT_STAT_CF_MASK);
-            transEvent->cw = (sbc_trans_evnt_stat_cw_t)(readData & SBC_UJA_TRANS_EVNT_STAT_CW_MASK);
-        }
-    }
-
-    /* WAKE pin event status. */
-    readData = 0;
-    /* Test if WAKE pin event occurred. */
-    if(glEvent->wpe == SBC_UJA_GL_EVNT_STAT_WPE)
-    {
-        spiStat = SBC_DataTransfer(SBC_UJA_WAKE_EVNT_STAT, NULL, &readData );
-        if(spiStat == STATUS_SUCCESS)
-        {
-            sbc_wake_evnt_stat_t* wakeEvent = &events->wakePinEvnt;
-            wakeEvent->wpr = (sbc_wake_evnt_stat_wpr_t)(readData & SBC_UJA_WAKE_EVNT_STAT_WPR_MASK);
-            wakeEvent->wpf = (sbc_wake_evnt_stat_wpf_t)(readData & SBC_UJA_WAKE_EVNT_STAT_WPF_MASK);
+            readData[i] = ops[i].data;
         }
+        sbc_decode_events_status(readData, events);
     }
 
     if(spiStat != STATUS_SUCCESS)
@@ -1398,6 +1378,8 @@ status_t SBC_CleanEvents(const sbc_evn_capt_t* const events)
  * It reads all status registers: Main status and Watchdog status,
  * Supply voltage status,  Transceiver status, WAKE pin status,
  * Event capture registers.
+ * All registers are read in one batched transfer, the latched Watchdog and
+ * Supply status bits are cleared in the same transfer.
  *
  * The following is an example of how to read all registers by passing status
  * parameter to SBC_GetAllStatus function:
@@ -1409,34 +1391,48 @@ status_t SBC_CleanEvents(const sbc_evn_capt_t* const events)
 status_t SBC_GetAllStatus(sbc_status_group_t* const status)
 {
     status_t ujaStat = STATUS_SUCCESS;
+    status_t spiStat = STATUS_SUCCESS;
+    uint8_t readData[5] = {0U, 0U, 0U, 0U, 0U};
+    uint8_t i;
+    /* Writing 0 clears the R/W status bits, the others are read only. */
+    sbc_reg_op_t ops[12] = {
+        {SBC_UJA_MAIN, false, 0U},
+        {SBC_UJA_WTDOG_STAT, false, 0U},
+        {SBC_UJA_WTDOG_STAT, true, 0U},
+        {SBC_UJA_SUPPLY_STAT, false, 0U},
+        {SBC_UJA_SUPPLY_STAT, true, 0U},
+        {SBC_UJA_TRANS_STAT, false, 0U},
+        {SBC_UJA_WAKE_STAT, false, 0U},
+        {SBC_UJA_GL_EVNT_STAT, false, 0U},
+        {SBC_UJA_SYS_EVNT_STAT, false, 0U},
+        {SBC_UJA_SUP_EVNT_STAT, false, 0U},
+        {SBC_UJA_TRANS_EVNT_STAT, false, 0U},
+        {SBC_UJA_WAKE_EVNT_STAT, false, 0U}
+    };
 
     DEV_ASSERT(status != NULL);
 
-    ujaStat = SBC_GetMainStatus(&status->mainS);
-
-    if(ujaStat == STATUS_SUCCESS)
-    {
-        ujaStat = SBC_GetWatchdogStatus(&status->wtdog);
-    }
-
-    if(ujaStat == STATUS_SUCCESS)
-    {
-        ujaStat = SBC_GetSupplyStatus(&status->supply);
-    }
+    spiStat = SBC_BatchTransfer(ops, 12U);
 
-    if(ujaStat == STATUS_SUCCESS)
+    if(spiStat == STATUS_SUCCESS)
     {
-        ujaStat = SBC_GetCanStatus(&status->trans);
-    }
+        sbc_decode_main_status(ops[0].data, &status->mainS);
+        sbc_decode_watchdog_status(ops[1].data, &status->wtdog);
+        sbc_decode_supply_status(ops[3].data, &status->supply);
+        sbc_decode_can_status(ops[5].data, &status->trans);
+        status->wakePin = (sbc_wake_stat_wpvs_t)(ops[6].data & SBC_UJA_WAKE_STAT_WPVS_MASK);
 
-    if(ujaStat == STATUS_SUCCESS)
-    {
-        ujaStat = SBC_GetWakeStatus(&status->wakePin);
+        for(i = 0U; i < 5U; i++)
+        {
+            readData[i] = ops[7U + i].data;
+        }
+        sbc_clean_events_status(&status->events);
+        sbc_decode_events_status(readData, &status->events);
     }
 
-    if(ujaStat == STATUS_SUCCESS)
+    if(spiStat != STATUS_SUCCESS)
     {
-        ujaStat = SBC_GetEventsStatus(&status->events);
+        ujaStat = SBC_COMM_ERROR;
     }
 
     return ujaStat;
@@ -1614,6 +1610,8 @@ status_t SBC_ChangeFactoriesSettings(const sbc_factories_conf_t* const newConf)
  * This function send 8 bites to SBC device register according device address
  * which is selected. This transfer uses 16bit LSPI. CS polarity - active low,
  * clock phase on second edge. Clock polarity active high.
+ * Reads of configuration registers return the shadow register without SPI
+ * access when it is valid, see SBC_ShadowRead.
  *
  * The following is an example of how to send data to SBC device by passing
  * sendData parameter to SBC_DataTransfer function:
@@ -1637,27 +1635,41 @@ status_t SBC_DataTransfer(const sbc_register_t regName,
     uint8_t readOnlyMask = 0x00U;
     uint8_t readData[2] = {0U, 0U};
 
-    /* Test if there is data for sending. */
-    if(sendData == NULL)
+    if((sendData == NULL) && sbc_shadow_is_cached(regName)
+       && ((g_shadowFlags[(uint8_t)regName] & SBC_UJA_SHADOW_VALID) != 0U))
     {
-       /* This transfer is read only. */
-       readOnlyMask = 0x01U;
-       command[0] = 0U;
+        readData[0] = g_shadowReg[(uint8_t)regName];
     }
     else
     {
-        command[0] = *sendData;
-    }
+        /* Test if there is data for sending. */
+        if(sendData == NULL)
+        {
+           /* This transfer is read only. */
+           readOnlyMask = 0x01U;
+           command[0] = 0U;
+        }
+        else
+        {
+            command[0] = *sendData;
+        }
 
-    /* Address of device with read only bit. */
-    command[1] = (uint8_t)((SBC_UJA_REG_ADDR_F(regName) | readOnlyMask) & 0xFFU);
+        /* Address of device with read only bit. */
+        command[1] = (uint8_t)((SBC_UJA_REG_ADDR_F(regName) | readOnlyMask) & 0xFFU);
 
-    status = LPSPI_DRV_MasterTransferBlocking(g_drvConfig.lpspiIntace, command,
-            readData, 2U, SBC_UJA_TIMEOUT );
+        status = LPSPI_DRV_MasterTransferBlocking(g_drvConfig.lpspiIntace, command,
+                readData, 2U, SBC_UJA_TIMEOUT );
 
-    if( readData[1] != command[1])
-    {
-        status = SBC_COMM_ERROR;
+        if( readData[1] != command[1])
+        {
+            status = SBC_COMM_ERROR;
+        }
+
+        if(status == STATUS_SUCCESS)
+        {
+            sbc_shadow_update(regName, (sendData != NULL) ? command[0] : readData[0],
+                    (sendData != NULL));
+        }
     }
 
     /* Copy content of register to receive data. */
@@ -1669,6 +1681,228 @@ status_t SBC_DataTransfer(const sbc_register_t regName,
     return status;
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SBC_BatchTransfer
+ * Description   : This function executes register accesses in one LPSPI
+ * transfer. Each access is a 16 bit frame, the LPSPI releases the chip select
+ * between frames, so every frame is a separate SBC message. Read data is
+ * stored to the ops array and the shadow registers are updated.
+ *
+ * The following is an example of how to read Main status and clear
+ * Watchdog status in one transfer:
+ *  sbc_reg_op_t ops[2] = {{SBC_UJA_MAIN, false, 0U},
+ *                         {SBC_UJA_WTDOG_STAT, true, 0U}};
+ *  status_t status = SBC_BatchTransfer(ops, 2U);
+ *
+ * Implements    : SBC_BatchTransfer_Activity
+ *END**************************************************************************/
+status_t SBC_BatchTransfer(sbc_reg_op_t* const ops, const uint8_t count)
+{
+    status_t status = STATUS_SUCCESS;
+
+    DEV_ASSERT(ops != NULL);
+    DEV_ASSERT((count > 0U) && (count <= SBC_UJA_BATCH_MAX_OPS));
+
+    status = sbc_batch_lock();
+
+    if(status == STATUS_SUCCESS)
+    {
+        sbc_batch_prepare(ops, count);
+        g_batch.callback = NULL;
+
+        status = LPSPI_DRV_MasterTransferBlocking(g_drvConfig.lpspiIntace,
+                g_batch.txBuff, g_batch.rxBuff, (uint16_t)(2U * count), SBC_UJA_TIMEOUT);
+
+        status = sbc_batch_finish(status);
+    }
+
+    return status;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SBC_BatchTransferStart
+ * Description   : This function starts register accesses in one LPSPI
+ * transfer and returns immediately. The LPSPI callback is replaced for the
+ * duration of the transfer, the callback is called from the LPSPI interrupt
+ * after the read data is stored to the ops array.
+ *
+ * Implements    : SBC_BatchTransferStart_Activity
+ *END**************************************************************************/
+status_t SBC_BatchTransferStart(sbc_reg_op_t* const ops, const uint8_t count,
+        const sbc_batch_callback_t callback, void* const param)
+{
+    status_t status = STATUS_SUCCESS;
+    lpspi_state_t* lpspiState = g_lpspiStatePtr[g_drvConfig.lpspiIntace];
+
+    DEV_ASSERT(ops != NULL);
+    DEV_ASSERT((count > 0U) && (count <= SBC_UJA_BATCH_MAX_OPS));
+    DEV_ASSERT(lpspiState != NULL);
+
+    status = sbc_batch_lock();
+
+    if(status == STATUS_SUCCESS)
+    {
+        sbc_batch_prepare(ops, count);
+        g_batch.callback = callback;
+        g_batch.callbackParam = param;
+
+        /* No other transfer may complete between installing the callback
+         * and starting the transfer. */
+        INT_SYS_DisableIRQGlobal();
+        if(lpspiState->isTransferInProgress)
+        {
+            status = STATUS_BUSY;
+        }
+        else
+        {
+            g_batch.spiCallback = lpspiState->callback;
+            g_batch.spiCallbackParam = lpspiState->callbackParam;
+            lpspiState->callback = sbc_batch_spi_callback;
+            lpspiState->callbackParam = NULL;
+
+            status = LPSPI_DRV_MasterTransfer(g_drvConfig.lpspiIntace,
+                    g_batch.txBuff, g_batch.rxBuff, (uint16_t)(2U * count));
+            if(status != STATUS_SUCCESS)
+            {
+                lpspiState->callback = g_batch.spiCallback;
+                lpspiState->callbackParam = g_batch.spiCallbackParam;
+            }
+        }
+        INT_SYS_EnableIRQGlobal();
+
+        if(status != STATUS_SUCCESS)
+        {
+            /* Release the batch buffers. */
+            g_batch.status = SBC_COMM_ERROR;
+        }
+    }
+
+    return status;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SBC_GetBatchStatus
+ * Description   : This function returns STATUS_BUSY while a batched transfer
+ * runs, otherwise the result of the last one.
+ *
+ * Implements    : SBC_GetBatchStatus_Activity
+ *END**************************************************************************/
+status_t SBC_GetBatchStatus(void)
+{
+    return g_batch.status;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SBC_ShadowWrite
+ * Description   : This function writes a configuration register to the
+ * shadow registers and marks it dirty. Several registers can be changed this
+ * way and written to the device by SBC_ShadowFlush in one transfer.
+ * Until then the shadow value is returned by reads and kept over direct
+ * writes of the register.
+ *
+ * Implements    : SBC_ShadowWrite_Activity
+ *END**************************************************************************/
+status_t SBC_ShadowWrite(const sbc_register_t regName, const uint8_t data)
+{
+    status_t status = STATUS_SUCCESS;
+
+    if(sbc_shadow_is_cached(regName))
+    {
+        g_shadowReg[(uint8_t)regName] = data;
+        g_shadowFlags[(uint8_t)regName] = SBC_UJA_SHADOW_VALID | SBC_UJA_SHADOW_DIRTY;
+    }
+    else
+    {
+        status = STATUS_ERROR;
+    }
+
+    return status;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SBC_ShadowRead
+ * Description   : This function reads a register. Valid shadow registers
+ * are returned without SPI access, including values not flushed yet.
+ *
+ * Implements    : SBC_ShadowRead_Activity
+ *END**************************************************************************/
+status_t SBC_ShadowRead(const sbc_register_t regName, uint8_t* const data)
+{
+    DEV_ASSERT(data != NULL);
+
+    return SBC_DataTransfer(regName, NULL, data);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SBC_ShadowFlush
+ * Description   : This function writes all dirty shadow registers to the
+ * device, SBC_UJA_BATCH_MAX_OPS registers per transfer in address order.
+ * Registers which fail to be written stay dirty.
+ *
+ * Implements    : SBC_ShadowFlush_Activity
+ *END**************************************************************************/
+status_t SBC_ShadowFlush(void)
+{
+    status_t status = STATUS_SUCCESS;
+    sbc_reg_op_t ops[SBC_UJA_BATCH_MAX_OPS];
+    uint8_t count = 0U;
+    uint8_t addr = 0U;
+    uint8_t i;
+
+    while((status == STATUS_SUCCESS) && (addr < SBC_UJA_SHADOW_SIZE))
+    {
+        if((g_shadowFlags[addr] & SBC_UJA_SHADOW_DIRTY) != 0U)
+        {
+            ops[count].regName = (sbc_register_t)addr;
+            ops[count].isWrite = true;
+            ops[count].data = g_shadowReg[addr];
+            /* A new SBC_ShadowWrite during the transfer sets it again. */
+            g_shadowFlags[addr] = SBC_UJA_SHADOW_VALID;
+            count++;
+        }
+        addr++;
+
+        if((count == SBC_UJA_BATCH_MAX_OPS) || ((addr == SBC_UJA_SHADOW_SIZE) && (count > 0U)))
+        {
+            status = SBC_BatchTransfer(ops, count);
+            if(status != STATUS_SUCCESS)
+            {
+                for(i = 0U; i < count; i++)
+                {
+                    g_shadowFlags[(uint8_t)ops[i].regName] = SBC_UJA_SHADOW_VALID | SBC_UJA_SHADOW_DIRTY;
+                }
+            }
+            count = 0U;
+        }
+    }
+
+    return status;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SBC_ShadowInvalidate
+ * Description   : This function marks all shadow registers invalid and
+ * discards pending shadow writes.
+ *
+ * Implements    : SBC_ShadowInvalidate_Activity
+ *END**************************************************************************/
+void SBC_ShadowInvalidate(void)
+{
+    uint8_t addr;
+
+    for(addr = 0U; addr < SBC_UJA_SHADOW_SIZE; addr++)
+    {
+        g_shadowFlags[addr] = 0U;
+    }
+}
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : sbc_write_can_others
@@ -1875,3 +2109,363 @@ static status_t sbc_change_factories_direct(const sbc_factories_conf_t* const fa
 
     return ujaStat;
 }
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : sbc_shadow_is_cached
+ * Description   : This function is internal function. It is not accessible outside
+ * this file. It returns true for configuration registers which are changed
+ * only by SPI writes, so their shadow registers stay valid. Status, event,
+ * mode and MTPNV registers are always read from the device.
+ *
+ *END**************************************************************************/
+static bool sbc_shadow_is_cached(const sbc_register_t regName)
+{
+    bool cached;
+
+    switch(regName)
+    {
+        case SBC_UJA_WTDOG_CTR:
+        case SBC_UJA_FAIL_SAFE:
+        case SBC_UJA_SYSTEM_EVNT:
+        case SBC_UJA_MEMORY_0:
+        case SBC_UJA_MEMORY_1:
+        case SBC_UJA_MEMORY_2:
+        case SBC_UJA_MEMORY_3:
+        case SBC_UJA_LOCK:
+        case SBC_UJA_REGULATOR:
+        case SBC_UJA_SUPPLY_EVNT:
+        case SBC_UJA_CAN:
+        case SBC_UJA_TRANS_EVNT:
+        case SBC_UJA_DAT_RATE:
+        case SBC_UJA_IDENTIF_0:
+        case SBC_UJA_IDENTIF_1:
+        case SBC_UJA_IDENTIF_2:
+        case SBC_UJA_IDENTIF_3:
+        case SBC_UJA_MASK_0:
+        case SBC_UJA_MASK_1:
+        case SBC_UJA_MASK_2:
+        case SBC_UJA_MASK_3:
+        case SBC_UJA_FRAME_CTR:
+        case SBC_UJA_DAT_MASK_0:
+        case SBC_UJA_DAT_MASK_1:
+        case SBC_UJA_DAT_MASK_2:
+        case SBC_UJA_DAT_MASK_3:
+        case SBC_UJA_DAT_MASK_4:
+        case SBC_UJA_DAT_MASK_5:
+        case SBC_UJA_DAT_MASK_6:
+        case SBC_UJA_DAT_MASK_7:
+        case SBC_UJA_WAKE_EN:
+            cached = true;
+            break;
+        default:
+            cached = false;
+            break;
+    }
+
+    return cached;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : sbc_shadow_update
+ * Description   : This function is internal function. It is not accessible outside
+ * this file. It updates the shadow register after a successful access.
+ * Dirty shadow registers keep the value not flushed yet. A write to a
+ * register which may be locked invalidates it, the device ignores writes
+ * to locked address areas. A write to a partial networking register
+ * invalidates the CAN control register, the device clears PNCOK.
+ *
+ *END**************************************************************************/
+static void sbc_shadow_update(const sbc_register_t regName, const uint8_t data,
+        const bool isWrite)
+{
+    uint8_t addr = (uint8_t)regName;
+    uint8_t lockMask = 0U;
+
+    if(isWrite)
+    {
+        if((addr >= (uint8_t)SBC_UJA_MEMORY_0) && (addr <= (uint8_t)SBC_UJA_MEMORY_3))
+        {
+            lockMask = SBC_UJA_LOCK_LK0C_MASK;
+        }
+        else if((addr >= (uint8_t)SBC_UJA_DAT_MASK_0) && (addr <= (uint8_t)SBC_UJA_DAT_MASK_7))
+        {
+            lockMask = SBC_UJA_LOCK_LK6C_MASK;
+        }
+        else if((addr >= 0x10U) && (addr <= 0x5FU))
+        {
+            /* One lock bit per 16 registers from 0x10. */
+            lockMask = (uint8_t)(1U << (addr >> 4U));
+        }
+        else
+        {
+            lockMask = 0U;
+        }
+
+        if(((addr >= (uint8_t)SBC_UJA_DAT_RATE) && (addr <= (uint8_t)SBC_UJA_FRAME_CTR))
+           || (lockMask == SBC_UJA_LOCK_LK6C_MASK))
+        {
+            g_shadowFlags[(uint8_t)SBC_UJA_CAN] &= (uint8_t)~SBC_UJA_SHADOW_VALID;
+        }
+    }
+
+    if(sbc_shadow_is_cached(regName) && ((g_shadowFlags[addr] & SBC_UJA_SHADOW_DIRTY) == 0U))
+    {
+        if((lockMask != 0U) && (((g_shadowFlags[(uint8_t)SBC_UJA_LOCK] & SBC_UJA_SHADOW_VALID) == 0U)
+           || ((g_shadowReg[(uint8_t)SBC_UJA_LOCK] & lockMask) != 0U)))
+        {
+            g_shadowFlags[addr] = 0U;
+        }
+        else
+        {
+            g_shadowReg[addr] = data;
+            g_shadowFlags[addr] = SBC_UJA_SHADOW_VALID;
+        }
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : sbc_batch_lock
+ * Description   : This function is internal function. It is not accessible outside
+ * this file. It takes the batch buffers, STATUS_BUSY is returned while
+ * another batched transfer uses them.
+ *
+ *END**************************************************************************/
+static status_t sbc_batch_lock(void)
+{
+    status_t status = STATUS_SUCCESS;
+
+    INT_SYS_DisableIRQGlobal();
+    if(g_batch.status == STATUS_BUSY)
+    {
+        status = STATUS_BUSY;
+    }
+    else
+    {
+        g_batch.status = STATUS_BUSY;
+    }
+    INT_SYS_EnableIRQGlobal();
+
+    return status;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : sbc_batch_prepare
+ * Description   : This function is internal function. It is not accessible outside
+ * this file. It fills the transmit buffer, two bytes per frame in the same
+ * order as SBC_DataTransfer: data, then address with read only bit.
+ *
+ *END**************************************************************************/
+static void sbc_batch_prepare(sbc_reg_op_t* const ops, const uint8_t count)
+{
+    uint8_t i;
+
+    g_batch.ops = ops;
+    g_batch.count = count;
+
+    for(i = 0U; i < count; i++)
+    {
+        if(ops[i].isWrite)
+        {
+            g_batch.txBuff[2U * i] = ops[i].data;
+            g_batch.txBuff[(2U * i) + 1U] = SBC_UJA_REG_ADDR_F(ops[i].regName);
+        }
+        else
+        {
+            g_batch.txBuff[2U * i] = 0U;
+            g_batch.txBuff[(2U * i) + 1U] = (uint8_t)(SBC_UJA_REG_ADDR_F(ops[i].regName) | 0x01U);
+        }
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : sbc_batch_finish
+ * Description   : This function is internal function. It is not accessible outside
+ * this file. It checks that the device echoed every address, stores read
+ * data, updates the shadow registers and releases the batch buffers.
+ *
+ *END**************************************************************************/
+static status_t sbc_batch_finish(status_t status)
+{
+    sbc_reg_op_t* ops = g_batch.ops;
+    uint8_t i;
+
+    for(i = 0U; (i < g_batch.count) && (status == STATUS_SUCCESS); i++)
+    {
+        if(g_batch.rxBuff[(2U * i) + 1U] != g_batch.txBuff[(2U * i) + 1U])
+        {
+            status = SBC_COMM_ERROR;
+        }
+    }
+
+    if(status == STATUS_SUCCESS)
+    {
+        for(i = 0U; i < g_batch.count; i++)
+        {
+            if(!ops[i].isWrite)
+            {
+                ops[i].data = g_batch.rxBuff[2U * i];
+            }
+            sbc_shadow_update(ops[i].regName, ops[i].data, ops[i].isWrite);
+        }
+    }
+    else
+    {
+        status = SBC_COMM_ERROR;
+    }
+
+    g_batch.status = status;
+
+    return status;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : sbc_batch_spi_callback
+ * Description   : This function is internal function. It is not accessible outside
+ * this file. It is the LPSPI callback of SBC_BatchTransferStart, it restores
+ * the LPSPI callback and calls the batch callback.
+ *
+ *END**************************************************************************/
+static void sbc_batch_spi_callback(void *driverState, spi_event_t event, void *userData)
+{
+    lpspi_state_t* lpspiState = (lpspi_state_t*)driverState;
+    status_t status = STATUS_SUCCESS;
+
+    (void)event;
+    (void)userData;
+
+    lpspiState->callback = g_batch.spiCallback;
+    lpspiState->callbackParam = g_batch.spiCallbackParam;
+
+    if(lpspiState->status != LPSPI_TRANSFER_OK)
+    {
+        status = STATUS_ERROR;
+    }
+
+    status = sbc_batch_finish(status);
+
+    if(g_batch.callback != NULL)
+    {
+        g_batch.callback(g_batch.ops, g_batch.count, status, g_batch.callbackParam);
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : sbc_decode_main_status
+ * Description   : This function is internal function. It is not accessible outside
+ * this file. It decodes the Main status register.
+ *
+ *END**************************************************************************/
+static void sbc_decode_main_status(const uint8_t data, sbc_main_status_t* const mainStatus)
+{
+    mainStatus->otws = (sbc_main_otws_t)(data & SBC_UJA_MAIN_OTWS_MASK);
+    mainStatus->nms = (sbc_main_nms_t)(data & SBC_UJA_MAIN_NMS_MASK);
+    mainStatus->rss = (sbc_main_rss_t)(data & SBC_UJA_MAIN_RSS_MASK);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : sbc_decode_watchdog_status
+ * Description   : This function is internal function. It is not accessible outside
+ * this file. It decodes the Watchdog status register.
+ *
+ *END**************************************************************************/
+static void sbc_decode_watchdog_status(const uint8_t data, sbc_wtdog_status_t* const watchdogStatus)
+{
+    watchdogStatus->fnms = (sbc_wtdog_stat_fnms_t)(data & SBC_UJA_WTDOG_STAT_FNMS_MASK);
+    watchdogStatus->sdms = (sbc_wtdog_stat_sdms_t)(data & SBC_UJA_WTDOG_STAT_SDMS_MASK);
+    watchdogStatus->wds = (sbc_wtdog_stat_wds_t)(data & SBC_UJA_WTDOG_STAT_WDS_MASK);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : sbc_decode_supply_status
+ * Description   : This function is internal function. It is not accessible outside
+ * this file. It decodes the Supply voltage status register.
+ *
+ *END**************************************************************************/
+static void sbc_decode_supply_status(const uint8_t data, sbc_supply_status_t* const supStatus)
+{
+    supStatus->v2s = (sbc_supply_stat_v2s_t)(data & SBC_UJA_SUPPLY_STAT_V2S_MASK);
+    supStatus->v1s = (sbc_supply_stat_v1s_t)(data & SBC_UJA_SUPPLY_STAT_V1S_MASK);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : sbc_decode_can_status
+ * Description   : This function is internal function. It is not accessible outside
+ * this file. It decodes the Transceiver status register.
+ *
+ *END**************************************************************************/
+static void sbc_decode_can_status(const uint8_t data, sbc_trans_stat_t* const transStatus)
+{
+    transStatus->cts = (sbc_trans_stat_cts_t)(data & SBC_UJA_TRANS_STAT_CTS_MASK);
+    transStatus->cpnerr = (sbc_trans_stat_cpnerr_t)(data & SBC_UJA_TRANS_STAT_CPNERR_MASK);
+    transStatus->cpns = (sbc_trans_stat_cpns_t)(data & SBC_UJA_TRANS_STAT_CPNS_MASK);
+    transStatus->coscs = (sbc_trans_stat_coscs_t)(data & SBC_UJA_TRANS_STAT_COSCS_MASK);
+    transStatus->cbss = (sbc_trans_stat_cbss_t)(data & SBC_UJA_TRANS_STAT_CBSS_MASK);
+    transStatus->vcs = (sbc_trans_stat_vcs_t)(data & SBC_UJA_TRANS_STAT_VCS_MASK);
+    transStatus->cfs = (sbc_trans_stat_cfs_t)(data & SBC_UJA_TRANS_STAT_CFS_MASK);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : sbc_decode_events_status
+ * Description   : This function is internal function. It is not accessible outside
+ * this file. It decodes the Event capture registers from Global event status
+ * to WAKE pin event status. Event registers are decoded only if the Global
+ * event status reports them, events must be cleaned before.
+ *
+ *END**************************************************************************/
+static void sbc_decode_events_status(const uint8_t* const data, sbc_evn_capt_t* const events)
+{
+    sbc_gl_evnt_stat_t* glEvent = &events->glEvnt;
+
+    glEvent->wpe = (sbc_gl_evnt_stat_wpe_t)(data[0] & SBC_UJA_GL_EVNT_STAT_WPE_MASK);
+    glEvent->trxe = (sbc_gl_evnt_stat_trxe_t)(data[0] & SBC_UJA_GL_EVNT_STAT_TRXE_MASK);
+    glEvent->supe = (sbc_gl_evnt_stat_supe_t)(data[0] & SBC_UJA_GL_EVNT_STAT_SUPE_MASK);
+    glEvent->syse = (sbc_gl_evnt_stat_syse_t)(data[0] & SBC_UJA_GL_EVNT_STAT_SYSE_MASK);
+
+    /* Test if System event occurred. */
+    if(glEvent->syse == SBC_UJA_GL_EVNT_STAT_SYSE)
+    {
+        sbc_sys_evnt_stat_t* sysEvent = &events->sysEvnt;
+        sysEvent->po = (sbc_sys_evnt_stat_po_t)(data[1] & SBC_UJA_SYS_EVNT_STAT_PO_MASK);
+        sysEvent->otw = (sbc_sys_evnt_stat_otw_t)(data[1] & SBC_UJA_SYS_EVNT_STAT_OTW_MASK);
+        sysEvent->spif = (sbc_sys_evnt_stat_spif_t)(data[1] & SBC_UJA_SYS_EVNT_STAT_SPIF_MASK);
+        sysEvent->wdf = (sbc_sys_evnt_stat_wdf_t)(data[1] & SBC_UJA_SYS_EVNT_STAT_WDF_MASK);
+    }
+
+    /* Test if Supply event occurred. */
+    if(glEvent->supe == SBC_UJA_GL_EVNT_STAT_SUPE)
+    {
+        sbc_sup_evnt_stat_t* supEvent = &events->supEvnt;
+        supEvent->v2o = (sbc_sup_evnt_stat_v2o_t)(data[2] & SBC_UJA_SUP_EVNT_STAT_V2O_MASK);
+        supEvent->v2u = (sbc_sup_evnt_stat_v2u_t)(data[2] & SBC_UJA_SUP_EVNT_STAT_V2U_MASK);
+        supEvent->v1u = (sbc_sup_evnt_stat_v1u_t)(data[2] & SBC_UJA_SUP_EVNT_STAT_V1U_MASK);
+    }
+
+    /* Test if Transceiver event occurred. */
+    if(glEvent->trxe == SBC_UJA_GL_EVNT_STAT_TRXE)
+    {
+        sbc_trans_evnt_stat_t* transEvent = &events->transEvnt;
+        transEvent->pnfde = (sbc_trans_evnt_stat_pnfde_t)(data[3] & SBC_UJA_TRANS_EVNT_STAT_PNFDE_MASK);
+        transEvent->cbs = (sbc_trans_evnt_stat_cbs_t)(data[3] & SBC_UJA_TRANS_EVNT_STAT_CBS_MASK);
+        transEvent->cf = (sbc_trans_evnt_stat_cf_t)(data[3] & SBC_UJA_TRANS_EVNT_STAT_CF_MASK);
+        transEvent->cw = (sbc_trans_evnt_stat_cw_t)(data[3] & SBC_UJA_TRANS_EVNT_STAT_CW_MASK);
+    }
+
+    /* Test if WAKE pin event occurred. */
+    if(glEvent->wpe == SBC_UJA_GL_EVNT_STAT_WPE)
+    {
+        sbc_wake_evnt_stat_t* wakeEvent = &events->wakePinEvnt;
+        wakeEvent->wpr = (sbc_wake_evnt_stat_wpr_t)(data[4] & SBC_UJA_WAKE_EVNT_STAT_WPR_MASK);
+        wakeEvent->wpf = (sbc_wake_evnt_stat_wpf_t)(data[4] & SBC_UJA_WAKE_EVNT_STAT_WPF_MASK);
+    }
+}
@@ -150,6 +150,8 @@ typedef void (*i2s_callback_t)(i2s_event_t event, void *userData);
 typedef enum {
     CAN_EVENT_RX_COMPLETE,     /*!< A frame was received in the configured Rx buffer. */
     CAN_EVENT_TX_COMPLETE,     /*!< A frame was sent from the configured Tx buffer. */
+    CAN_EVENT_WAKEUP_TIMEOUT,  /*!< A Pretended Networking wake up occurred due to timeout. */
+    CAN_EVENT_WAKEUP_MATCH,    /*!< A Pretended Networking wake up occurred due to a matching frame. */
 } can_event_t;
 
 /*! @brief Callback for all peripherals which support CAN features
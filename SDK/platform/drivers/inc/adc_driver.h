@@ -323,6 +323,27 @@ typedef struct
     uint16_t userOffset;  /*!< User-configurable Offset (2's complement, subtracted from result) */
 } adc_calibration_t;
 
+/*!
+ * @brief Defines the auto-calibration results
+ *
+ * This structure holds the registers written by the auto-calibration
+ * sequence, so they can be saved and restored without calibrating again.
+ *
+ * Implements : adc_auto_calibration_t_Class
+ */
+typedef struct
+{
+    uint16_t clps;        /*!< General Calibration Value S */
+    uint16_t clp3;        /*!< Plus-Side General Calibration Value 3 */
+    uint16_t clp2;        /*!< Plus-Side General Calibration Value 2 */
+    uint16_t clp1;        /*!< Plus-Side General Calibration Value 1 */
+    uint16_t clp0;        /*!< Plus-Side General Calibration Value 0 */
+    uint16_t clpx;        /*!< Plus-Side General Calibration Value X */
+    uint16_t clp9;        /*!< Plus-Side General Calibration Value 9 */
+    uint16_t gain;        /*!< Gain */
+    uint16_t offset;      /*!< Offset Correction */
+} adc_auto_calibration_t;
+
 /*!
  * @brief Defines the trigger latch clear method
  * Implements : adc_latch_clear_t_Class
@@ -651,10 +672,10 @@ void ADC_DRV_GetChanResult(const uint32_t instance,
  * These methods control the Calibration feature of the ADC.
  *
  * The ADC_DRV_AutoCalibration() method can be called to execute a calibration
- * sequence, or a calibration can be retrieved with the ADC_DRV_GetUserCalibration()
+ * sequence, and its results can be retrieved with ADC_DRV_GetAutoCalibration()
  * and saved to non-volatile storage, to avoid calibration on every power-on.
- * The calibration structure can be written with the ADC_DRV_ConfigUserCalibration()
- * method.
+ * They are written back with ADC_DRV_ConfigAutoCalibration(). The user gain
+ * and offset are set independently with ADC_DRV_ConfigUserCalibration().
  */
 /*! @{*/
 
@@ -669,6 +690,31 @@ void ADC_DRV_GetChanResult(const uint32_t instance,
  */
 void ADC_DRV_AutoCalibration(const uint32_t instance);
 
+/*!
+ * @brief Gets the results of the last Auto-Calibration
+ *
+ * This function returns the calibration registers written by the
+ * Auto-Calibration sequence.
+ *
+ * @param[in] instance instance number
+ * @param[out] config the calibration results
+ */
+void ADC_DRV_GetAutoCalibration(const uint32_t instance,
+                                adc_auto_calibration_t * const config);
+
+/*!
+ * @brief Restores saved Auto-Calibration results
+ *
+ * This function writes the calibration registers with results saved by
+ * ADC_DRV_GetAutoCalibration(), instead of running ADC_DRV_AutoCalibration().
+ * The converter must be idle.
+ *
+ * @param[in] instance instance number
+ * @param[in] config the calibration results
+ */
+void ADC_DRV_ConfigAutoCalibration(const uint32_t instance,
+                                   const adc_auto_calibration_t * const config);
+
 /*!
  * @brief Initializes the User Calibration configuration structure
  *
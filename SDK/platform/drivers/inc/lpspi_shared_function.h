@@ -150,6 +150,9 @@ typedef struct
     spi_callback_t callback;             /*!< Select the callback to transfer complete */
     void *callbackParam;                 /*!< Select additional callback parameters if it's necessary */
     uint32_t dummy;                      /*!< This field is used for the cases when TX is NULL and LPSPI is in DMA mode */
+    void (*txFill)(uint32_t instance);   /*!< TX FIFO fill routine, chosen at transfer start for the frame
+                                              size, the tx buffer alignment and a NULL tx buffer */
+    void (*rxDrain)(uint32_t instance);  /*!< RX FIFO drain routine, chosen at transfer start */
 } lpspi_state_t;
 
 /*******************************************************************************
@@ -192,6 +195,12 @@ void LPSPI_DRV_FillupTxBuffer(uint32_t instance);
  */
 void LPSPI_DRV_ReadRXBuffer(uint32_t instance);
 
+/*!
+ * @brief Choose the FIFO fill and drain routines of an interrupt transfer.
+ * Call once the buffers and the frame size of the transfer are set.
+ */
+void LPSPI_DRV_SelectFifoRoutines(lpspi_state_t * lpspiState);
+
 /*!
  * @brief Disable the TEIE interrupts at the end of a transfer.
  * Disable the interrupts and clear the status for transmit/receive errors.
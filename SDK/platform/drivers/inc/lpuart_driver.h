@@ -113,6 +113,9 @@ typedef struct
                                               and the callback is called when all the bytes have been transferred. */
     void * txCallbackParam;              /*!< Transmit callback parameter pointer.*/
     lpuart_transfer_type_t transferType; /*!< Type of LPUART transfer (interrupt/dma based) */
+#if FEATURE_LPUART_FIFO_SIZE > 0U
+    bool fifoEnable;                     /*!< True if the interrupts move up to a FIFO of chars. */
+#endif
 #if FEATURE_LPUART_HAS_DMA_ENABLE
     uint8_t rxDMAChannel;                /*!< DMA channel number for DMA-based rx. */
     uint8_t txDMAChannel;                /*!< DMA channel number for DMA-based tx. */
@@ -123,6 +126,19 @@ typedef struct
     volatile status_t receiveStatus;     /*!< Status of last driver receive operation */
 } lpuart_state_t;
 
+/*! @brief Baud rate divider settings chosen by LPUART_DRV_PlanBaudRate
+ *
+ * Implements : lpuart_baud_plan_t_Class
+ */
+typedef struct
+{
+    uint8_t osr;                  /*!< Oversampling ratio, 4 to 32 */
+    uint16_t sbr;                 /*!< Baud rate modulo divisor, 1 to 8191 */
+    bool bothEdge;                /*!< Both edge sampling, required for an OSR of 4 to 7 */
+    uint32_t achievedBaudRate;    /*!< Resulting baud rate, rounded to the nearest integer */
+    int32_t errorPpm;             /*!< (achieved - desired) / desired, in parts per million */
+} lpuart_baud_plan_t;
+
 /*! @brief LPUART configuration structure
  *
  * Implements : lpuart_user_config_t_Class
@@ -141,6 +157,11 @@ typedef struct
                                                       If DMA mode isn't used this field will be ignored. */
     uint8_t txDMAChannel;                        /*!< Channel number for DMA tx channel.
                                                       If DMA mode isn't used this field will be ignored. */
+#if FEATURE_LPUART_FIFO_SIZE > 0U
+    bool fifoEnable;                             /*!< Use the tx/rx FIFOs with watermarks, so that each
+                                                      interrupt moves up to a FIFO of chars.
+                                                      If interrupt mode isn't used this field will be ignored. */
+#endif
 } lpuart_user_config_t;
 
 /*******************************************************************************
@@ -390,10 +411,28 @@ status_t LPUART_DRV_AbortReceivingData(uint32_t instance);
  *
  * @param instance  LPUART instance number.
  * @param desiredBaudRate LPUART desired baud rate.
- * @return STATUS_BUSY if called during an on-going transfer, STATUS_SUCCESS otherwise
+ * @return STATUS_BUSY if called during an on-going transfer, STATUS_ERROR if the
+ *         clock is too slow for the baud rate, STATUS_SUCCESS otherwise
  */
 status_t LPUART_DRV_SetBaudRate(uint32_t instance, uint32_t desiredBaudRate);
 
+/*!
+ * @brief Computes the closest LPUART baud rate settings.
+ *
+ * This function tries every oversampling ratio from 4 to 32 with the two
+ * divisors around the ideal one, against the LPUART clock as configured in
+ * the clock manager, and returns the pair with the lowest error. On a tie
+ * the highest oversampling ratio is kept. LPUART_DRV_SetBaudRate programs
+ * the same settings.
+ *
+ * @param instance  LPUART instance number.
+ * @param desiredBaudRate LPUART desired baud rate.
+ * @param[out] plan Chosen settings and achieved error.
+ * @return STATUS_ERROR if the clock is off or too slow for the baud rate,
+ *         STATUS_SUCCESS otherwise
+ */
+status_t LPUART_DRV_PlanBaudRate(uint32_t instance, uint32_t desiredBaudRate, lpuart_baud_plan_t * plan);
+
 /*!
  * @brief Returns the LPUART baud rate.
  *
@@ -631,6 +631,56 @@ void ADC_DRV_AutoCalibration(const uint32_t instance)
     ADC_SetSampleTime(base, sampletime);
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : ADC_DRV_GetAutoCalibration
+ * Description   : This function returns the calibration registers written
+ * by the Auto-Calibration sequence.
+ *
+ *END**************************************************************************/
+void ADC_DRV_GetAutoCalibration(const uint32_t instance,
+                                adc_auto_calibration_t * const config)
+{
+    DEV_ASSERT(instance < ADC_INSTANCE_COUNT);
+    DEV_ASSERT(config != NULL);
+
+    const ADC_Type * const base = s_adcBase[instance];
+    config->clps   = (uint16_t)base->CLPS;
+    config->clp3   = (uint16_t)base->CLP3;
+    config->clp2   = (uint16_t)base->CLP2;
+    config->clp1   = (uint16_t)base->CLP1;
+    config->clp0   = (uint16_t)base->CLP0;
+    config->clpx   = (uint16_t)base->CLPX;
+    config->clp9   = (uint16_t)base->CLP9;
+    config->gain   = (uint16_t)base->G;
+    config->offset = (uint16_t)base->OFS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : ADC_DRV_ConfigAutoCalibration
+ * Description   : This function restores saved Auto-Calibration results
+ * instead of running the calibration sequence.
+ *
+ *END**************************************************************************/
+void ADC_DRV_ConfigAutoCalibration(const uint32_t instance,
+                                   const adc_auto_calibration_t * const config)
+{
+    DEV_ASSERT(instance < ADC_INSTANCE_COUNT);
+    DEV_ASSERT(config != NULL);
+
+    ADC_Type * const base = s_adcBase[instance];
+    base->CLPS = (uint32_t)config->clps & ADC_CLPS_CLPS_MASK;
+    base->CLP3 = (uint32_t)config->clp3 & ADC_CLP3_CLP3_MASK;
+    base->CLP2 = (uint32_t)config->clp2 & ADC_CLP2_CLP2_MASK;
+    base->CLP1 = (uint32_t)config->clp1 & ADC_CLP1_CLP1_MASK;
+    base->CLP0 = (uint32_t)config->clp0 & ADC_CLP0_CLP0_MASK;
+    base->CLPX = (uint32_t)config->clpx & ADC_CLPX_CLPX_MASK;
+    base->CLP9 = (uint32_t)config->clp9 & ADC_CLP9_CLP9_MASK;
+    base->G    = (uint32_t)config->gain & ADC_G_G_MASK;
+    base->OFS  = (uint32_t)config->offset & ADC_OFS_OFS_MASK;
+}
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : ADC_DRV_InitUserCalibrationStruct
@@ -76,6 +76,18 @@
 
 static clock_manager_state_t g_clockState;
 
+/*! @brief Frequency cache
+ *         Frequencies returned by CLOCK_DRV_GetFreq, indexed by clock name. An entry is
+ *         valid while its bit is set in g_clockFreqValid. Every function changing the SCG,
+ *         SIM, PCC or PMC settings clears the bitmap and advances g_clockFreqGeneration, so
+ *         a frequency decoded across a change is not stored. Zero frequencies are not cached.
+ */
+#define CLOCK_FREQ_VALID_WORDS   ((((uint32_t)CLOCK_NAME_COUNT) + 31U) >> 5U)
+
+static uint32_t g_clockFreqCache[CLOCK_NAME_COUNT];
+static uint32_t g_clockFreqValid[CLOCK_FREQ_VALID_WORDS];
+static volatile uint32_t g_clockFreqGeneration;
+
 /* This frequency values should be set by different boards. */
 /* SIM */
 uint32_t g_TClkFreq[NUMBER_OF_TCLK_INPUTS];      /* TCLKx clocks    */
@@ -539,6 +551,10 @@ static status_t CLOCK_SYS_CheckPCCClock(clock_names_t clockName);
 
 static void CLOCK_SYS_SetClockGate(clock_names_t peripheralClock, bool gating);
 
+static status_t CLOCK_SYS_DecodeFreq(clock_names_t clockName, uint32_t * frequency);
+
+static void CLOCK_SYS_FillFreqCache(void);
+
 /*******************************************************************************
  * Code
  ******************************************************************************/
@@ -582,6 +598,8 @@ status_t CLOCK_DRV_Init(clock_manager_user_config_t const * config)
         CLOCK_SYS_SetPmcConfiguration(&cfg->pmcConfig);
     }
 
+    CLOCK_SYS_InvalidateFreqCache();
+
     return result;
 }
 
@@ -1737,7 +1755,9 @@ static status_t CLOCK_SYS_GetPccClockFreq(clock_names_t clockName,
 /*FUNCTION**********************************************************************
  *
  * Function Name : CLOCK_DRV_GetFreq
- * Description   : This function returns the frequency of a given clock
+ * Description   : This function returns the frequency of a given clock. A
+ * frequency decoded once is served from the cache until the next change of the
+ * clock configuration.
  *
  * Implements CLOCK_DRV_GetFreq_Activity
  * END**************************************************************************/
@@ -1745,6 +1765,52 @@ status_t CLOCK_DRV_GetFreq(clock_names_t clockName,
                            uint32_t * frequency)
 {
     status_t returnCode;
+    uint32_t freq = 0U;
+    uint32_t generation;
+    uint32_t word = ((uint32_t)clockName) >> 5U;
+    uint32_t mask = 1UL << (((uint32_t)clockName) & 31U);
+
+    if ((clockName < PCC_END_OF_CLOCKS) && ((g_clockFreqValid[word] & mask) != 0U))
+    {
+        freq = g_clockFreqCache[clockName];
+        returnCode = STATUS_SUCCESS;
+    }
+    else
+    {
+        generation = g_clockFreqGeneration;
+        returnCode = CLOCK_SYS_DecodeFreq(clockName, &freq);
+
+        if ((returnCode == STATUS_SUCCESS) && (freq != 0U))
+        {
+            INT_SYS_DisableIRQGlobal();
+            /* Skip the store if the configuration changed while decoding */
+            if (generation == g_clockFreqGeneration)
+            {
+                g_clockFreqCache[clockName] = freq;
+                g_clockFreqValid[word] |= mask;
+            }
+            INT_SYS_EnableIRQGlobal();
+        }
+    }
+
+    /* If frequency reference is provided, write this value */
+    if (frequency != NULL)
+    {
+        *frequency = freq;
+    }
+
+    return returnCode;
+}
+
+/*FUNCTION**********************************************************************
+ * Function Name : CLOCK_SYS_DecodeFreq
+ * Description   : Internal function used by CLOCK_DRV_GetFreq function, decodes
+ * the frequency of a clock name from the SCG, SIM and PCC registers.
+ * END**************************************************************************/
+static status_t CLOCK_SYS_DecodeFreq(clock_names_t clockName,
+                                     uint32_t * frequency)
+{
+    status_t returnCode;
 
     /* Frequency of the clock name from SCG */
     if (clockName < SCG_END_OF_CLOCKS)
@@ -3264,6 +3330,8 @@ void CLOCK_DRV_SetModuleClock(clock_names_t peripheralClock, const module_clk_co
     {
     	CLOCK_SYS_SetClockGate(peripheralClock, moduleClkCfg->gating);
     }
+
+    CLOCK_SYS_InvalidateFreqCache();
 }
 
 /*FUNCTION**********************************************************************
@@ -3436,6 +3504,9 @@ status_t CLOCK_DRV_SetSystemClock(const pwr_modes_t * mode,
     {
         retCode = CLOCK_SYS_SetSystemClockConfig(sysClockMode,&sysClockConfig);
     }
+
+    CLOCK_SYS_InvalidateFreqCache();
+
     return retCode;
 }
 
@@ -3862,6 +3933,8 @@ status_t CLOCK_DRV_SetClockSource(clock_names_t clockSource, const clock_source_
             break;
     }
 
+    CLOCK_SYS_InvalidateFreqCache();
+
     return retCode;
 }
 
@@ -3969,6 +4042,9 @@ status_t CLOCK_SYS_UpdateConfiguration(uint8_t targetConfigIndex,
     }
 
     if(successfulSetConfig){
+        /* Drivers reading their clock in the "AFTER" notification hit the cache. */
+        CLOCK_SYS_FillFreqCache();
+
         notifyStruct.notifyType = CLOCK_MANAGER_NOTIFY_AFTER;
 
         for (callbackIdx=0; callbackIdx<g_clockState.callbackNum; callbackIdx++)
@@ -4077,6 +4153,45 @@ status_t CLOCK_SYS_SetConfiguration(clock_manager_user_config_t const * config)
     return CLOCK_DRV_Init(config);
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CLOCK_SYS_InvalidateFreqCache
+ * Description   : Drops every cached frequency. Called after the clock
+ * registers have been written, and by the application after a run mode
+ * change made through the SMC.
+ *
+ *END**************************************************************************/
+void CLOCK_SYS_InvalidateFreqCache(void)
+{
+    uint32_t i;
+
+    INT_SYS_DisableIRQGlobal();
+
+    g_clockFreqGeneration++;
+    for (i = 0U; i < CLOCK_FREQ_VALID_WORDS; i++)
+    {
+        g_clockFreqValid[i] = 0U;
+    }
+
+    INT_SYS_EnableIRQGlobal();
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CLOCK_SYS_FillFreqCache
+ * Description   : Decodes the frequency of every clock name into the cache.
+ *
+ *END**************************************************************************/
+static void CLOCK_SYS_FillFreqCache(void)
+{
+    uint32_t clockName;
+
+    for (clockName = 0U; clockName < ((uint32_t)PCC_END_OF_CLOCKS); clockName++)
+    {
+        (void)CLOCK_DRV_GetFreq((clock_names_t)clockName, NULL);
+    }
+}
+
 
 
 /*******************************************************************************
@@ -974,6 +974,14 @@ clock_manager_callback_user_config_t* CLOCK_SYS_GetErrorCallback(void);
  */
 status_t CLOCK_SYS_GetFreq(clock_names_t clockName, uint32_t *frequency);
 
+/*!
+ * @brief Drops the frequencies cached by CLOCK_DRV_GetFreq.
+ *
+ * The clock manager functions do it themselves. Call it after changing the
+ * clocks without them, e.g. a run mode switch through SMC_PMCTRL.
+ */
+void CLOCK_SYS_InvalidateFreqCache(void);
+
 
 #if defined (__cplusplus)
 }
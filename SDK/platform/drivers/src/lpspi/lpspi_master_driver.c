@@ -198,6 +198,10 @@ status_t LPSPI_DRV_MasterInit(uint32_t instance, lpspi_state_t * lpspiState,
     }
     /* When TX is null the value sent on the bus will be 0 */
     lpspiState->dummy = 0;
+    /* Byte-wise FIFO routines until the first interrupt transfer chooses its own */
+    lpspiState->txBuff = NULL;
+    lpspiState->rxBuff = NULL;
+    LPSPI_DRV_SelectFifoRoutines(lpspiState);
     /* Initialize the semaphore */
     errorCode = OSIF_SemaCreate(&(lpspiState->lpspiSemaphore), 0);
     DEV_ASSERT(errorCode == STATUS_SUCCESS);
@@ -746,6 +750,8 @@ static status_t LPSPI_DRV_MasterStartTransfer(uint32_t instance,
         {
             lpspiState->txCount++;
         }
+        /* Specialised FIFO routines for the frame size and the buffers of this transfer */
+        LPSPI_DRV_SelectFifoRoutines(lpspiState);
 
         /* Update transfer status */
         lpspiState->isTransferInProgress = true;
@@ -926,7 +932,7 @@ void LPSPI_DRV_MasterIRQHandler(uint32_t instance)
     {
         if (lpspiState->rxCount != (uint16_t)0)
         {
-            LPSPI_DRV_ReadRXBuffer(instance);
+            lpspiState->rxDrain(instance);
         }
     }
     /* Transmit data */
@@ -934,7 +940,7 @@ void LPSPI_DRV_MasterIRQHandler(uint32_t instance)
     {
         if ((lpspiState->txCount != (uint16_t)0))
         {
-            LPSPI_DRV_FillupTxBuffer(instance);
+            lpspiState->txFill(instance);
         }
     }
     if (lpspiState->txCount == (uint16_t)0)
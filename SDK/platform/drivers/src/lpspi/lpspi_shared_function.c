@@ -231,6 +231,304 @@ void LPSPI_DRV_ReadRXBuffer(uint32_t instance)
     }
 }
 
+/*!
+ * @brief Number of words the fill routines may write, for a FIFO word of width bytes.
+ * In continuous mode the last byte of txCount stands for the command word negating the PCS.
+ */
+static inline uint32_t LPSPI_DRV_TxWords(const lpspi_state_t * lpspiState, uint32_t width, uint32_t space)
+{
+    uint32_t bytes = lpspiState->txCount;
+    uint32_t words;
+
+    if ((lpspiState->isPcsContinuous == true) && (bytes != 0U))
+    {
+        bytes--;
+    }
+    words = bytes / width;
+
+    return (words < space) ? words : space;
+}
+
+/*!
+ * @brief Account for the bytes written, then negate the PCS of a continuous transfer
+ * if all the data is in the FIFO and a slot is left for the command word.
+ */
+static inline void LPSPI_DRV_TxAdvance(lpspi_state_t * lpspiState, LPSPI_Type * base,
+                                       uint32_t bytes, uint32_t spaceLeft)
+{
+    lpspiState->txCount = (uint16_t)(lpspiState->txCount - bytes);
+    if ((lpspiState->isPcsContinuous == true) && (lpspiState->txCount == 1U) && (spaceLeft != 0U))
+    {
+        /* Disable continuous PCS */
+        LPSPI_ClearContCBit(base);
+        lpspiState->txCount = 0U;
+    }
+}
+
+/*!
+ * @brief Fill the TX FIFO from a buffer of 8 bits frames.
+ */
+static void LPSPI_DRV_TxFill8(uint32_t instance)
+{
+    lpspi_state_t * lpspiState = g_lpspiStatePtr[instance];
+    LPSPI_Type *base = g_lpspiBase[instance];
+    const uint8_t *txBuff = lpspiState->txBuff;
+    uint32_t space = (uint32_t)lpspiState->fifoSize - LPSPI_ReadTxCount(base);
+    uint32_t words = LPSPI_DRV_TxWords(lpspiState, 1U, space);
+    uint32_t n = words;
+
+    /* The FIFO holds 4 words */
+    while (n >= 4U)
+    {
+        base->TDR = txBuff[0];
+        base->TDR = txBuff[1];
+        base->TDR = txBuff[2];
+        base->TDR = txBuff[3];
+        txBuff += 4U;
+        n -= 4U;
+    }
+    while (n != 0U)
+    {
+        base->TDR = *txBuff;
+        txBuff++;
+        n--;
+    }
+    lpspiState->txBuff = txBuff;
+    LPSPI_DRV_TxAdvance(lpspiState, base, words, space - words);
+}
+
+/*!
+ * @brief Fill the TX FIFO from a 16 bits aligned buffer of 9 to 16 bits frames.
+ */
+static void LPSPI_DRV_TxFill16(uint32_t instance)
+{
+    lpspi_state_t * lpspiState = g_lpspiStatePtr[instance];
+    LPSPI_Type *base = g_lpspiBase[instance];
+    const uint16_t *txBuff = (const uint16_t *)lpspiState->txBuff;
+    uint32_t space = (uint32_t)lpspiState->fifoSize - LPSPI_ReadTxCount(base);
+    uint32_t words = LPSPI_DRV_TxWords(lpspiState, 2U, space);
+    uint32_t n = words;
+
+    while (n >= 4U)
+    {
+        base->TDR = txBuff[0];
+        base->TDR = txBuff[1];
+        base->TDR = txBuff[2];
+        base->TDR = txBuff[3];
+        txBuff += 4U;
+        n -= 4U;
+    }
+    while (n != 0U)
+    {
+        base->TDR = *txBuff;
+        txBuff++;
+        n--;
+    }
+    lpspiState->txBuff = (const uint8_t *)txBuff;
+    LPSPI_DRV_TxAdvance(lpspiState, base, words * 2U, space - words);
+}
+
+/*!
+ * @brief Fill the TX FIFO from a 32 bits aligned buffer of frames of 17 bits or more,
+ * a frame longer than 32 bits takes several words.
+ */
+static void LPSPI_DRV_TxFill32(uint32_t instance)
+{
+    lpspi_state_t * lpspiState = g_lpspiStatePtr[instance];
+    LPSPI_Type *base = g_lpspiBase[instance];
+    const uint32_t *txBuff = (const uint32_t *)lpspiState->txBuff;
+    uint32_t space = (uint32_t)lpspiState->fifoSize - LPSPI_ReadTxCount(base);
+    uint32_t words = LPSPI_DRV_TxWords(lpspiState, 4U, space);
+    uint32_t n = words;
+
+    while (n >= 4U)
+    {
+        base->TDR = txBuff[0];
+        base->TDR = txBuff[1];
+        base->TDR = txBuff[2];
+        base->TDR = txBuff[3];
+        txBuff += 4U;
+        n -= 4U;
+    }
+    while (n != 0U)
+    {
+        base->TDR = *txBuff;
+        txBuff++;
+        n--;
+    }
+    lpspiState->txBuff = (const uint8_t *)txBuff;
+    LPSPI_DRV_TxAdvance(lpspiState, base, words * 4U, space - words);
+}
+
+/*!
+ * @brief Fill the TX FIFO with zeros, for a master transfer without tx buffer.
+ */
+static void LPSPI_DRV_TxFillZero(uint32_t instance)
+{
+    lpspi_state_t * lpspiState = g_lpspiStatePtr[instance];
+    LPSPI_Type *base = g_lpspiBase[instance];
+    uint32_t width = (lpspiState->bytesPerFrame < 4U) ? lpspiState->bytesPerFrame : 4U;
+    uint32_t space = (uint32_t)lpspiState->fifoSize - LPSPI_ReadTxCount(base);
+    uint32_t words = LPSPI_DRV_TxWords(lpspiState, width, space);
+    uint32_t n;
+
+    for (n = words; n != 0U; n--)
+    {
+        base->TDR = 0U;
+    }
+    LPSPI_DRV_TxAdvance(lpspiState, base, words * width, space - words);
+}
+
+/*!
+ * @brief Drain the RX FIFO into a buffer of 8 bits frames.
+ */
+static void LPSPI_DRV_RxDrain8(uint32_t instance)
+{
+    lpspi_state_t * lpspiState = g_lpspiStatePtr[instance];
+    const LPSPI_Type *base = g_lpspiBase[instance];
+    uint8_t *rxBuff = lpspiState->rxBuff;
+    uint32_t words = LPSPI_ReadRxCount(base);
+    uint32_t n;
+
+    if (words > lpspiState->rxCount)
+    {
+        words = lpspiState->rxCount;
+    }
+    n = words;
+    while (n >= 4U)
+    {
+        rxBuff[0] = (uint8_t)base->RDR;
+        rxBuff[1] = (uint8_t)base->RDR;
+        rxBuff[2] = (uint8_t)base->RDR;
+        rxBuff[3] = (uint8_t)base->RDR;
+        rxBuff += 4U;
+        n -= 4U;
+    }
+    while (n != 0U)
+    {
+        *rxBuff = (uint8_t)base->RDR;
+        rxBuff++;
+        n--;
+    }
+    lpspiState->rxBuff = rxBuff;
+    lpspiState->rxCount = (uint16_t)(lpspiState->rxCount - words);
+}
+
+/*!
+ * @brief Drain the RX FIFO into a 16 bits aligned buffer of 9 to 16 bits frames.
+ */
+static void LPSPI_DRV_RxDrain16(uint32_t instance)
+{
+    lpspi_state_t * lpspiState = g_lpspiStatePtr[instance];
+    const LPSPI_Type *base = g_lpspiBase[instance];
+    uint16_t *rxBuff = (uint16_t *)lpspiState->rxBuff;
+    uint32_t words = LPSPI_ReadRxCount(base);
+    uint32_t n;
+
+    if (words > ((uint32_t)lpspiState->rxCount / 2U))
+    {
+        words = (uint32_t)lpspiState->rxCount / 2U;
+    }
+    n = words;
+    while (n >= 4U)
+    {
+        rxBuff[0] = (uint16_t)base->RDR;
+        rxBuff[1] = (uint16_t)base->RDR;
+        rxBuff[2] = (uint16_t)base->RDR;
+        rxBuff[3] = (uint16_t)base->RDR;
+        rxBuff += 4U;
+        n -= 4U;
+    }
+    while (n != 0U)
+    {
+        *rxBuff = (uint16_t)base->RDR;
+        rxBuff++;
+        n--;
+    }
+    lpspiState->rxBuff = (uint8_t *)rxBuff;
+    lpspiState->rxCount = (uint16_t)(lpspiState->rxCount - (words * 2U));
+}
+
+/*!
+ * @brief Drain the RX FIFO into a 32 bits aligned buffer of frames of 17 bits or more.
+ */
+static void LPSPI_DRV_RxDrain32(uint32_t instance)
+{
+    lpspi_state_t * lpspiState = g_lpspiStatePtr[instance];
+    const LPSPI_Type *base = g_lpspiBase[instance];
+    uint32_t *rxBuff = (uint32_t *)lpspiState->rxBuff;
+    uint32_t words = LPSPI_ReadRxCount(base);
+    uint32_t n;
+
+    if (words > ((uint32_t)lpspiState->rxCount / 4U))
+    {
+        words = (uint32_t)lpspiState->rxCount / 4U;
+    }
+    n = words;
+    while (n >= 4U)
+    {
+        rxBuff[0] = base->RDR;
+        rxBuff[1] = base->RDR;
+        rxBuff[2] = base->RDR;
+        rxBuff[3] = base->RDR;
+        rxBuff += 4U;
+        n -= 4U;
+    }
+    while (n != 0U)
+    {
+        *rxBuff = base->RDR;
+        rxBuff++;
+        n--;
+    }
+    lpspiState->rxBuff = (uint8_t *)rxBuff;
+    lpspiState->rxCount = (uint16_t)(lpspiState->rxCount - (words * 4U));
+}
+
+/*!
+ * @brief Choose the FIFO fill and drain routines of an interrupt transfer.
+ * Buffers not aligned to the FIFO word width keep the byte-wise LPSPI_DRV_FillupTxBuffer and
+ * LPSPI_DRV_ReadRXBuffer: the unrolled word accesses may be merged into multiple loads/stores,
+ * which fault on unaligned addresses.
+ */
+void LPSPI_DRV_SelectFifoRoutines(lpspi_state_t * lpspiState)
+{
+    uint32_t width = (lpspiState->bytesPerFrame < 4U) ? lpspiState->bytesPerFrame : 4U;
+    uint32_t align = width - 1U;
+
+    if (lpspiState->txBuff == NULL)
+    {
+        lpspiState->txFill = LPSPI_DRV_TxFillZero;
+    }
+    else if (((uint32_t)lpspiState->txBuff & align) != 0U)
+    {
+        lpspiState->txFill = LPSPI_DRV_FillupTxBuffer;
+    }
+    else
+    {
+        switch (width)
+        {
+            case 1U: lpspiState->txFill = LPSPI_DRV_TxFill8; break;
+            case 2U: lpspiState->txFill = LPSPI_DRV_TxFill16; break;
+            default: lpspiState->txFill = LPSPI_DRV_TxFill32; break;
+        }
+    }
+
+    /* Without rx buffer the RX FIFO is masked, the routine is not called */
+    if ((lpspiState->rxBuff == NULL) || (((uint32_t)lpspiState->rxBuff & align) != 0U))
+    {
+        lpspiState->rxDrain = LPSPI_DRV_ReadRXBuffer;
+    }
+    else
+    {
+        switch (width)
+        {
+            case 1U: lpspiState->rxDrain = LPSPI_DRV_RxDrain8; break;
+            case 2U: lpspiState->rxDrain = LPSPI_DRV_RxDrain16; break;
+            default: lpspiState->rxDrain = LPSPI_DRV_RxDrain32; break;
+        }
+    }
+}
+
 /*!
  * @brief Disable the TEIE interrupts at the end of a transfer.
  * Disable the interrupts and clear the status for transmit/receive errors.
@@ -162,6 +162,10 @@ status_t LPSPI_DRV_SlaveInit(uint32_t instance,
     errorCode = OSIF_SemaCreate(&(lpspiState->lpspiSemaphore), 0);
     DEV_ASSERT(errorCode == STATUS_SUCCESS);
     g_lpspiStatePtr[instance] = lpspiState;
+    /* Byte-wise FIFO routines until the first interrupt transfer chooses its own */
+    lpspiState->txBuff = NULL;
+    lpspiState->rxBuff = NULL;
+    LPSPI_DRV_SelectFifoRoutines(lpspiState);
 
     /* Configure registers */
     LPSPI_Init(base);
@@ -346,6 +350,7 @@ status_t LPSPI_DRV_SlaveTransfer(uint32_t instance,
         state->txFrameCnt = 0;
         state->rxFrameCnt = 0;
         state->isPcsContinuous = false;
+        LPSPI_DRV_SelectFifoRoutines(state);
         /* Configure watermarks */
         LPSPI_SetRxWatermarks(base, 0U);
         LPSPI_SetTxWatermarks(base, 2U);
@@ -461,7 +466,7 @@ void LPSPI_DRV_SlaveIRQHandler(uint32_t instance)
     {   
         if ((lpspiState->rxCount != (uint8_t)0))
         {
-            LPSPI_DRV_ReadRXBuffer(instance);
+            lpspiState->rxDrain(instance);
         }
     }
     /* Transmit data */
@@ -469,7 +474,7 @@ void LPSPI_DRV_SlaveIRQHandler(uint32_t instance)
     {   
         if ((lpspiState->txCount != (uint8_t)0))
         {
-            LPSPI_DRV_FillupTxBuffer(instance);
+            lpspiState->txFill(instance);
         }
     }
     /* If all bytes are sent disable interrupt TDF */
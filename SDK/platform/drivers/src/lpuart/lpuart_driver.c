@@ -87,6 +87,17 @@
 #include "lpuart_irq.h"
 #include "clock_manager.h"
 
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#if FEATURE_LPUART_FIFO_SIZE > 0U
+/* FIFO mode: TDRE while at most one word is queued, RDRF once three are
+ * received, leaving one entry of margin for the interrupt latency */
+#define LPUART_FIFO_TX_WATERMARK    (1U)
+#define LPUART_FIFO_RX_WATERMARK    (2U)
+#endif
+
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -132,6 +143,12 @@ static void LPUART_DRV_RxIrqHandler(uint32_t instance);
 static void LPUART_DRV_TxEmptyIrqHandler(uint32_t instance);
 static void LPUART_DRV_TxCompleteIrqHandler(uint32_t instance);
 static void LPUART_DRV_ErrIrqHandler(uint32_t instance);
+static bool LPUART_DRV_ComputeBaudPlan(uint32_t sourceClock,
+                                       uint32_t desiredBaudRate,
+                                       lpuart_baud_plan_t * plan);
+#if FEATURE_LPUART_FIFO_SIZE > 0U
+static void LPUART_DRV_SetRxFifoWatermark(uint32_t instance);
+#endif
 
 /*******************************************************************************
  * Code
@@ -156,6 +173,9 @@ void LPUART_DRV_GetDefaultConfig(lpuart_user_config_t * lpuartUserConfig)
     lpuartUserConfig->bitCountPerChar = LPUART_8_BITS_PER_CHAR;
     lpuartUserConfig->rxDMAChannel = 0U;
     lpuartUserConfig->txDMAChannel = 0U;
+#if FEATURE_LPUART_FIFO_SIZE > 0U
+    lpuartUserConfig->fifoEnable = false;
+#endif
 }
 
 /*FUNCTION**********************************************************************
@@ -249,6 +269,18 @@ status_t LPUART_DRV_Init(uint32_t instance, lpuart_state_t * lpuartStatePtr,
     LPUART_SetParityMode(base, lpuartUserConfig->parityMode);
     LPUART_SetStopBitCount(base, lpuartUserConfig->stopBitCount);
 
+#if FEATURE_LPUART_FIFO_SIZE > 0U
+    /* The FIFOs serve the interrupt based transfers only */
+    lpuartStatePtr->fifoEnable = lpuartUserConfig->fifoEnable &&
+                                 (lpuartUserConfig->transferType == LPUART_USING_INTERRUPTS);
+    if (lpuartStatePtr->fifoEnable)
+    {
+        LPUART_SetFifoCmd(base, true);
+        LPUART_SetTxWatermark(base, LPUART_FIFO_TX_WATERMARK);
+        LPUART_SetRxWatermark(base, 0U);
+    }
+#endif
+
     /* initialize last driver operation status */
     lpuartStatePtr->transmitStatus = STATUS_SUCCESS;
     lpuartStatePtr->receiveStatus = STATUS_SUCCESS;
@@ -939,8 +971,7 @@ status_t LPUART_DRV_SetBaudRate(uint32_t instance, uint32_t desiredBaudRate)
 {
     DEV_ASSERT(instance < LPUART_INSTANCE_COUNT);
 
-    uint16_t sbr, sbrTemp, i;
-    uint32_t osr, tempDiff, calculatedBaud, baudDiff, maxOsr;
+    lpuart_baud_plan_t plan;
     uint32_t lpuartSourceClock;
     clock_names_t instanceClkName = s_lpuartClkNames[instance];
     LPUART_Type * base = s_lpuartBase[instance];
@@ -968,71 +999,52 @@ status_t LPUART_DRV_SetBaudRate(uint32_t instance, uint32_t desiredBaudRate)
     /* Check if the desired baud rate can be configured with the current protocol clock. */
     DEV_ASSERT(lpuartSourceClock >= (desiredBaudRate * 4U));
 
-    /* This lpuart instantiation uses a slightly different baud rate calculation
-     * The idea is to use the best OSR (over-sampling rate) possible
-     * Note, osr is typically hard-set to 16 in other lpuart instantiations
-     * First calculate the baud rate using the minimum OSR possible (4) */
-    osr = 4;
-    sbr = (uint16_t)(lpuartSourceClock / (desiredBaudRate * osr));
-    calculatedBaud = (lpuartSourceClock / (osr * sbr));
-    if (calculatedBaud > desiredBaudRate)
-    {
-        baudDiff = calculatedBaud - desiredBaudRate;
-    }
-    else
+    if (!LPUART_DRV_ComputeBaudPlan(lpuartSourceClock, desiredBaudRate, &plan))
     {
-        baudDiff = desiredBaudRate - calculatedBaud;
-    }
-    /* find maximum osr */
-    maxOsr = lpuartSourceClock / desiredBaudRate;
-    if (maxOsr > 32U)
-    {
-        maxOsr = 32U;
+        return STATUS_ERROR;
     }
-    /* loop to find the best osr value possible, one that generates minimum baudDiff
-     * iterate through the rest of the supported values of osr */
-    if (maxOsr >= 5U)
-    {
-        for (i = 5U; i <= maxOsr; i++)
-        {
-            /* calculate the temporary sbr value   */
-            sbrTemp = (uint16_t)(lpuartSourceClock / (desiredBaudRate * i));
-            /* calculate the baud rate based on the temporary osr and sbr values */
-            calculatedBaud = (lpuartSourceClock / (i * sbrTemp));
 
-            if (calculatedBaud > desiredBaudRate)
-            {
-                tempDiff = calculatedBaud - desiredBaudRate;
-            }
-            else
-            {
-                tempDiff = desiredBaudRate - calculatedBaud;
-            }
-
-            if (tempDiff <= baudDiff)
-            {
-                baudDiff = tempDiff;
-                osr = i;  /* update and store the best osr value calculated */
-                sbr = sbrTemp;  /* update store the best sbr value calculated */
-            }
-        }
+    /* An osr between 4x and 7x requires "BOTHEDGE" sampling */
+    if (plan.bothEdge)
+    {
+        LPUART_EnableBothEdgeSamplingCmd(base);
     }
-    /* Check if osr is between 4x and 7x oversampling.
-     * If so, then "BOTHEDGE" sampling must be turned on */
-    if (osr < 8U)
+    else
     {
-    	LPUART_EnableBothEdgeSamplingCmd(base);
+        LPUART_DisableBothEdgeSamplingCmd(base);
     }
 
     /* program the osr value (bit value is one less than actual value) */
-    LPUART_SetOversamplingRatio(base, (osr - 1U));
+    LPUART_SetOversamplingRatio(base, ((uint32_t)plan.osr - 1U));
 
     /* write the sbr value to the BAUD registers */
-    LPUART_SetBaudRateDivisor(base, sbr);
+    LPUART_SetBaudRateDivisor(base, plan.sbr);
 
     return STATUS_SUCCESS;
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : LPUART_DRV_PlanBaudRate
+ * Description   : Computes the osr/sbr pair LPUART_DRV_SetBaudRate would
+ * program for the desired baud rate, with the resulting error.
+ *
+ * Implements    : LPUART_DRV_PlanBaudRate_Activity
+ *END**************************************************************************/
+status_t LPUART_DRV_PlanBaudRate(uint32_t instance, uint32_t desiredBaudRate, lpuart_baud_plan_t * plan)
+{
+    DEV_ASSERT(instance < LPUART_INSTANCE_COUNT);
+    DEV_ASSERT(plan != NULL);
+
+    uint32_t lpuartSourceClock;
+    clock_names_t instanceClkName = s_lpuartClkNames[instance];
+
+    /* Get the LPUART clock as configured in the clock manager */
+    (void)CLOCK_SYS_GetFreq(instanceClkName, &lpuartSourceClock);
+
+    return LPUART_DRV_ComputeBaudPlan(lpuartSourceClock, desiredBaudRate, plan) ? STATUS_SUCCESS : STATUS_ERROR;
+}
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : LPUART_DRV_GetBaudRate
@@ -1163,44 +1175,67 @@ void LPUART_DRV_IRQHandler(uint32_t instance)
 static void LPUART_DRV_RxIrqHandler(uint32_t instance)
 {
     lpuart_state_t * lpuartState = (lpuart_state_t *)s_lpuartStatePtr[instance];
+    const LPUART_Type * base = s_lpuartBase[instance];
+    const bool is8Bit = (lpuartState->bitCountPerChar == LPUART_8_BITS_PER_CHAR);
+    uint32_t count = 1U;
 
-    /* Get data and put in receive buffer  */
-    LPUART_DRV_GetData(instance);
-
-    /* Update the internal state */
-    if (lpuartState->bitCountPerChar == LPUART_8_BITS_PER_CHAR)
+#if FEATURE_LPUART_FIFO_SIZE > 0U
+    /* Drain all the received words in one interrupt */
+    if (lpuartState->fifoEnable)
     {
-        ++lpuartState->rxBuff;
-        --lpuartState->rxSize;
-    }
-    else
-    {
-        lpuartState->rxBuff = &lpuartState->rxBuff[2];
-        lpuartState->rxSize -= 2U;
+        count = LPUART_GetRxFifoCount(base);
     }
+#endif
 
-    /* Check if this was the last byte in the current buffer */
-    if (lpuartState->rxSize == 0U)
+    while (count > 0U)
     {
-        /* Invoke callback if there is one (callback may reset the rx buffer for continuous reception) */
-        if (lpuartState->rxCallback != NULL)
+        --count;
+
+        /* Get data and put in receive buffer, then update the internal state */
+        if (is8Bit)
         {
-            lpuartState->rxCallback(lpuartState, UART_EVENT_RX_FULL, lpuartState->rxCallbackParam);
+            LPUART_Getchar(base, lpuartState->rxBuff);
+            ++lpuartState->rxBuff;
+            --lpuartState->rxSize;
+        }
+        else
+        {
+            LPUART_DRV_GetData(instance);
+            lpuartState->rxBuff = &lpuartState->rxBuff[2];
+            lpuartState->rxSize -= 2U;
         }
-    }
 
-    /* Finish reception if this was the last byte received */
-    if (lpuartState->rxSize == 0U)
-    {
-        /* Complete transfer (disable rx logic) */
-        LPUART_DRV_CompleteReceiveDataUsingInt(instance);
+        /* Check if this was the last byte in the current buffer */
+        if (lpuartState->rxSize == 0U)
+        {
+            /* Invoke callback if there is one (callback may reset the rx buffer for continuous reception) */
+            if (lpuartState->rxCallback != NULL)
+            {
+                lpuartState->rxCallback(lpuartState, UART_EVENT_RX_FULL, lpuartState->rxCallbackParam);
+            }
+        }
 
-        /* Invoke callback if there is one */
-        if (lpuartState->rxCallback != NULL)
+        /* Finish reception if this was the last byte received */
+        if (lpuartState->rxSize == 0U)
         {
-            lpuartState->rxCallback(lpuartState, UART_EVENT_END_TRANSFER, lpuartState->rxCallbackParam);
+            /* Complete transfer (disable rx logic) */
+            LPUART_DRV_CompleteReceiveDataUsingInt(instance);
+
+            /* Invoke callback if there is one */
+            if (lpuartState->rxCallback != NULL)
+            {
+                lpuartState->rxCallback(lpuartState, UART_EVENT_END_TRANSFER, lpuartState->rxCallbackParam);
+            }
+            count = 0U;
         }
     }
+
+#if FEATURE_LPUART_FIFO_SIZE > 0U
+    if (lpuartState->fifoEnable && (lpuartState->rxSize > 0U))
+    {
+        LPUART_DRV_SetRxFifoWatermark(instance);
+    }
+#endif
 }
 
 /*FUNCTION**********************************************************************
@@ -1215,22 +1250,48 @@ static void LPUART_DRV_TxEmptyIrqHandler(uint32_t instance)
     lpuart_state_t * lpuartState = (lpuart_state_t *)s_lpuartStatePtr[instance];
     LPUART_Type * base = s_lpuartBase[instance];
 
+    uint32_t space = 1U;
+
     /* Check if there are any more bytes to send */
     if (lpuartState->txSize > 0U)
     {
-        /* Transmit the data */
-        LPUART_DRV_PutData(instance);
+#if FEATURE_LPUART_FIFO_SIZE > 0U
+        /* Top up the FIFO instead of sending a single char */
+        if (lpuartState->fifoEnable)
+        {
+            space = FEATURE_LPUART_FIFO_SIZE - (uint32_t)LPUART_GetTxFifoCount(base);
+        }
+#endif
 
-        /* Update the internal state */
+        /* Transmit the data and update the internal state */
         if (lpuartState->bitCountPerChar == LPUART_8_BITS_PER_CHAR)
         {
-            ++lpuartState->txBuff;
-            --lpuartState->txSize;
+            const uint8_t * txBuff = lpuartState->txBuff;
+            uint32_t txSize = lpuartState->txSize;
+
+            if (space > txSize)
+            {
+                space = txSize;
+            }
+            txSize -= space;
+            while (space > 0U)
+            {
+                LPUART_Putchar(base, *txBuff);
+                ++txBuff;
+                --space;
+            }
+            lpuartState->txBuff = txBuff;
+            lpuartState->txSize = txSize;
         }
         else
         {
-            lpuartState->txBuff = &lpuartState->txBuff[2];
-            lpuartState->txSize -= 2U;
+            while ((space > 0U) && (lpuartState->txSize > 0U))
+            {
+                LPUART_DRV_PutData(instance);
+                lpuartState->txBuff = &lpuartState->txBuff[2];
+                lpuartState->txSize -= 2U;
+                --space;
+            }
         }
 
         /* Check if this was the last byte in the current buffer */
@@ -1647,6 +1708,13 @@ static status_t LPUART_DRV_StartReceiveDataUsingInt(uint32_t instance,
     lpuartState->rxSize = rxSize;
     lpuartState->receiveStatus = STATUS_BUSY;
 
+#if FEATURE_LPUART_FIFO_SIZE > 0U
+    if (lpuartState->fifoEnable)
+    {
+        LPUART_DRV_SetRxFifoWatermark(instance);
+    }
+#endif
+
     /* Enable the receiver */
     LPUART_SetReceiverCmd(base, true);
 
@@ -1746,6 +1814,14 @@ static void LPUART_DRV_CompleteReceiveDataUsingInt(uint32_t instance)
     /* Disable receive data full and rx overrun interrupt. */
     LPUART_SetIntMode(base, LPUART_INT_RX_DATA_REG_FULL, false);
 
+#if FEATURE_LPUART_FIFO_SIZE > 0U
+    /* Back to RDRF on each word for the polling functions */
+    if (lpuartState->fifoEnable)
+    {
+        LPUART_SetRxWatermark(base, 0U);
+    }
+#endif
+
     /* Signal the synchronous completion object. */
     if (lpuartState->isRxBlocking)
     {
@@ -1924,6 +2000,98 @@ static void LPUART_DRV_GetData(uint32_t instance)
     }
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : LPUART_DRV_ComputeBaudPlan
+ * Description   : Search every osr from 4 to 32 for the lowest baud rate
+ * error. For a given osr only the two sbr values around the ideal divisor can
+ * be the closest. The errors |clock - baud * osr * sbr| / (osr * sbr) are
+ * compared as exact fractions, a tie keeps the highest osr.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static bool LPUART_DRV_ComputeBaudPlan(uint32_t sourceClock,
+                                       uint32_t desiredBaudRate,
+                                       lpuart_baud_plan_t * plan)
+{
+    uint64_t bestNum = 0U;
+    uint64_t bestDen = 1U;
+    uint64_t target, num, den;
+    uint32_t osr, sbr, k;
+    bool found = false;
+
+    if ((desiredBaudRate == 0U) || ((uint64_t)sourceClock < ((uint64_t)desiredBaudRate * 4U)))
+    {
+        return false;
+    }
+
+    for (osr = 4U; osr <= 32U; osr++)
+    {
+        for (k = 0U; k < 2U; k++)
+        {
+            sbr = (uint32_t)((uint64_t)sourceClock / ((uint64_t)desiredBaudRate * osr)) + k;
+            if ((sbr == 0U) || (sbr > LPUART_BAUD_SBR_MASK))
+            {
+                continue;
+            }
+
+            den = (uint64_t)osr * sbr;
+            target = (uint64_t)desiredBaudRate * den;
+            num = (target > sourceClock) ? (target - sourceClock) : (sourceClock - target);
+
+            if ((!found) || ((num * bestDen) <= (bestNum * den)))
+            {
+                found = true;
+                bestNum = num;
+                bestDen = den;
+                plan->osr = (uint8_t)osr;
+                plan->sbr = (uint16_t)sbr;
+            }
+        }
+    }
+
+    if (found)
+    {
+        target = (uint64_t)desiredBaudRate * bestDen;
+        plan->bothEdge = (plan->osr < 8U);
+        plan->achievedBaudRate = (uint32_t)(((uint64_t)sourceClock + (bestDen / 2U)) / bestDen);
+        plan->errorPpm = (int32_t)((((int64_t)sourceClock - (int64_t)target) * 1000000) / (int64_t)target);
+    }
+
+    return found;
+}
+
+#if FEATURE_LPUART_FIFO_SIZE > 0U
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : LPUART_DRV_SetRxFifoWatermark
+ * Description   : Set the receive watermark for the chars still expected, so
+ * that RDRF is asserted on the last one of the buffer at the latest.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void LPUART_DRV_SetRxFifoWatermark(uint32_t instance)
+{
+    const lpuart_state_t * lpuartState = (lpuart_state_t *)s_lpuartStatePtr[instance];
+    LPUART_Type * base = s_lpuartBase[instance];
+    uint32_t chars = lpuartState->rxSize;
+
+    if (lpuartState->bitCountPerChar != LPUART_8_BITS_PER_CHAR)
+    {
+        chars >>= 1U;
+    }
+
+    if (chars > LPUART_FIFO_RX_WATERMARK)
+    {
+        LPUART_SetRxWatermark(base, (uint8_t)LPUART_FIFO_RX_WATERMARK);
+    }
+    else
+    {
+        LPUART_SetRxWatermark(base, (uint8_t)(chars - 1U));
+    }
+}
+#endif
+
 #if FEATURE_LPUART_HAS_DMA_ENABLE
 /*FUNCTION**********************************************************************
  *
@@ -330,6 +330,20 @@ static inline void LPUART_EnableBothEdgeSamplingCmd(LPUART_Type * base)
 {
     base->BAUD |= LPUART_BAUD_BOTHEDGE_MASK;
 }
+
+/*!
+ * @brief Disables the LPUART baud rate both edge sampling
+ *
+ * This function disables the both edge sampling, for oversampling ratios of
+ * 8x and more. It should only be called when the receiver is disabled.
+ *
+ *
+ * @param base LPUART base pointer.
+ */
+static inline void LPUART_DisableBothEdgeSamplingCmd(LPUART_Type * base)
+{
+    base->BAUD &= ~LPUART_BAUD_BOTHEDGE_MASK;
+}
 #endif
 
 /*!
@@ -436,6 +450,87 @@ static inline void LPUART_SetRxDmaCmd(LPUART_Type * base, bool enable)
 }
 #endif
 
+#if FEATURE_LPUART_FIFO_SIZE > 0U
+/*!
+ * @brief Enables or disables the transmit and receive FIFOs.
+ *
+ * This function enables or disables both FIFOs and flushes them. It must be
+ * called while the transmitter and the receiver are disabled. When enabled,
+ * RDRF is also asserted after one idle character, so that characters below
+ * the receive watermark are not held back at the end of a message.
+ *
+ *
+ * @param base LPUART base pointer
+ * @param enable FIFO configuration (enable: 1/disable: 0)
+ */
+static inline void LPUART_SetFifoCmd(LPUART_Type * base, bool enable)
+{
+    uint32_t fifo = base->FIFO & ~(LPUART_FIFO_TXFE_MASK | LPUART_FIFO_RXFE_MASK | LPUART_FIFO_RXIDEN_MASK |
+                                   FEATURE_LPUART_FIFO_REG_FLAGS_MASK);
+
+    if (enable)
+    {
+        fifo |= LPUART_FIFO_TXFE_MASK | LPUART_FIFO_RXFE_MASK | LPUART_FIFO_RXIDEN(1U);
+    }
+    base->FIFO = fifo;
+    base->FIFO = fifo | LPUART_FIFO_TXFLUSH_MASK | LPUART_FIFO_RXFLUSH_MASK;
+}
+
+/*!
+ * @brief Sets the transmit FIFO watermark.
+ *
+ * TDRE is asserted while the number of words in the transmit FIFO is equal
+ * to or less than the watermark.
+ *
+ *
+ * @param base LPUART base pointer
+ * @param watermark Transmit watermark
+ */
+static inline void LPUART_SetTxWatermark(LPUART_Type * base, uint8_t watermark)
+{
+    base->WATER = (base->WATER & ~LPUART_WATER_TXWATER_MASK) | LPUART_WATER_TXWATER(watermark);
+}
+
+/*!
+ * @brief Sets the receive FIFO watermark.
+ *
+ * RDRF is asserted while the number of words in the receive FIFO is greater
+ * than the watermark.
+ *
+ *
+ * @param base LPUART base pointer
+ * @param watermark Receive watermark
+ */
+static inline void LPUART_SetRxWatermark(LPUART_Type * base, uint8_t watermark)
+{
+    base->WATER = (base->WATER & ~LPUART_WATER_RXWATER_MASK) | LPUART_WATER_RXWATER(watermark);
+}
+
+/*!
+ * @brief Returns the number of words in the transmit FIFO.
+ *
+ *
+ * @param base LPUART base pointer
+ * @return Transmit FIFO count
+ */
+static inline uint8_t LPUART_GetTxFifoCount(const LPUART_Type * base)
+{
+    return (uint8_t)((base->WATER & LPUART_WATER_TXCOUNT_MASK) >> LPUART_WATER_TXCOUNT_SHIFT);
+}
+
+/*!
+ * @brief Returns the number of words in the receive FIFO.
+ *
+ *
+ * @param base LPUART base pointer
+ * @return Receive FIFO count
+ */
+static inline uint8_t LPUART_GetRxFifoCount(const LPUART_Type * base)
+{
+    return (uint8_t)((base->WATER & LPUART_WATER_RXCOUNT_MASK) >> LPUART_WATER_RXCOUNT_SHIFT);
+}
+#endif
+
 /*@}*/
 
 /*!
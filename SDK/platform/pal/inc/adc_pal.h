@@ -63,6 +63,12 @@ typedef adc_inputchannel_t adc_input_chan_t;
  */
 typedef trgmux_trigger_source_t adc_trigger_source_t;
 
+#ifndef ADC_PAL_DMA_MAX_SETS
+/*! @brief Maximum numSetsResultBuffer of a group converted in DMA mode
+ * (one software TCD is reserved for each set). */
+#define ADC_PAL_DMA_MAX_SETS (16u)
+#endif
+
 #elif defined (ADC_PAL_MPC574xC_G_R) || defined (ADC_PAL_SAR_CTU)
 
 /*!
@@ -159,6 +165,23 @@ typedef struct {
 } adc_config_t;
 
 #if defined (ADC_PAL_S32K1xx)
+/*!
+ * @brief Defines the hardware compare and averaging settings of a conversion group for ADC S32K1xx
+ *
+ * A conversion failing the compare neither updates its result nor completes, so the group notification
+ * is only called when the last conversion of the group passes the compare. For window monitoring, set
+ * compareRangeFuncEnable = true, compareGreaterThanEnable = false, compVal1 = low and compVal2 = high:
+ * the CPU is then only interrupted when the result leaves [low, high].
+ *
+ * Implements : adc_group_hw_s32k1xx_t_Class
+ */
+typedef struct {
+	adc_compare_config_t compare; /*!< Hardware compare applied to all conversions of the group, compared after averaging */
+	adc_average_config_t average; /*!< Hardware averaging of each conversion of the group */
+	uint16_t monitorPeriod; /*!< Only for continuous SW triggered groups with compare enabled: PDB ticks between two sets of conversions.
+	 *   The PDB then restarts the group by itself, since the notification no longer runs after each set. */
+} adc_group_hw_s32k1xx_t;
+
 /*!
  * @brief Defines the extension structure for ADC S32K1xx
  *
@@ -172,6 +195,13 @@ typedef struct {
 	bool supplyMonitoringEnable; /*!< Enable internal supply monitoring */
 	pdb_clk_prescaler_div_t pdbPrescaler; /*!< PDB clock prescaler. Delays are measured based on PDB clock divided by prescaler.
 	 *   Only relevant if delays are used. */
+	bool dmaEnable; /*!< Collect the results with eDMA instead of the ADC interrupt. The notification is then called only
+	 *   when the first and the second half of the result buffer are filled. eDMA must be initialized before ADC_Init. */
+	uint8_t dmaChannel; /*!< eDMA channel moving the results, requested by the ADC conversion complete flags */
+	uint8_t dmaTrigChannel; /*!< eDMA channel retriggering PDB for continuous SW triggered groups, linked to dmaChannel */
+	const adc_auto_calibration_t * calibration; /*!< Saved calibration restored at init instead of running ADC_DRV_AutoCalibration, NULL to calibrate */
+	const adc_group_hw_s32k1xx_t * groupHwArray; /*!< Compare and averaging settings indexed like groupConfigArray, NULL if no group uses them.
+	 *   Groups with compare enabled are not supported together with dmaEnable. */
 } extension_adc_s32k1xx_t;
 #endif /* defined(ADC_PAL_S32K1xx) */
 
@@ -347,6 +377,29 @@ status_t ADC_EnableNotification(const adc_instance_t * const instance,
 status_t ADC_DisableNotification(const adc_instance_t * const instance,
 		const uint32_t groupIdx);
 
+#if defined (ADC_PAL_S32K1xx)
+/*!
+ * @brief Replaces the active conversion group by another one, without stopping the ADC PAL
+ *
+ * This function switches from the active SW or HW triggered group to the selected group, which may be of either kind.
+ * The PDB and the ADC are not reset: only the ADC SC1n registers and PDB pre-trigger settings which differ between the two groups
+ * are written, the PDB is only reinitialized when the trigger kind or the monitor period changes.
+ * Triggers are held off from the moment the function is called until the new group is armed, for at most the
+ * conversion in progress (bounded by timeout) plus numChannels channel writes and a few PDB register writes.
+ * If no group is active, the selected group is simply started or enabled.
+ *
+ * @param[in] instance Pointer to ADC PAL instance number structure
+ * @param[in] groupIdx Index of the selected group configured via groupConfigArray in adc_config_t
+ * @param[in] timeout Timeout interval in milliseconds for the conversion in progress
+ * @return status:
+ * \n - STATUS_TIMEOUT: the conversion in progress did not finish within timeout, the previous group stays stopped
+ * \n - STATUS_SUCCESS: the selected group is active
+ */
+status_t ADC_SwitchGroup(const adc_instance_t * const instance,
+		const uint32_t groupIdx,
+		const uint32_t timeout);
+#endif /* defined(ADC_PAL_S32K1xx) */
+
 #if defined (__cplusplus)
 }
 #endif
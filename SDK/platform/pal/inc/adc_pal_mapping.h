@@ -28,6 +28,7 @@
 #include "adc_hw_access.h"
 #include "trgmux_driver.h"
 #include "pdb_driver.h"
+#include "edma_driver.h"
 
 #endif /* defined(ADC_PAL_S32K1xx) */
 
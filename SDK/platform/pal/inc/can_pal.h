@@ -289,6 +289,37 @@ status_t CAN_Send(const can_instance_t * const instance,
                   uint32_t buffIdx,
                   const can_message_t *message);
 
+/*!
+ * @brief Sends a CAN frame using the specified buffer, without validation.
+ *
+ * This function behaves like CAN_Send, but uses the state lookup and the
+ * buffer data info prepared by CAN_Init and CAN_ConfigTxBuff without checking
+ * the instance type and buffer index again. It is intended for hot paths
+ * (e.g. ISRs) sending on buffers that are known to be configured.
+ *
+ * @param[in] instance Instance information structure, must be initialized.
+ * @param[in] buffIdx buffer index, must be configured for transmission.
+ * @param[in] message message to be sent.
+ * @return STATUS_SUCCESS if successful;
+ *         STATUS_BUSY if the current buffer is involved in another transfer;
+ */
+status_t CAN_SendFast(const can_instance_t * const instance,
+                      uint32_t buffIdx,
+                      const can_message_t *message);
+
+/*!
+ * @brief Returns the hardware message buffer behind a buffer index.
+ *
+ * The buffer indices of the PAL start after the message buffers occupied by
+ * the Rx FIFO filters, this function applies that offset.
+ *
+ * @param[in] instance Instance information structure, must be initialized.
+ * @param[in] buffIdx buffer index.
+ * @return Message buffer index of the peripheral.
+ */
+uint32_t CAN_GetHwBuffIdx(const can_instance_t * const instance,
+                          uint32_t buffIdx);
+
 /*!
  * @brief Sends a CAN frame using the specified buffer, in a blocking manner.
  *
@@ -103,6 +103,12 @@ typedef struct
     uint32_t latestGroupIdx;                                          /*!< Index of the most recently enabled group (HW or SW triggered) group (might not be active anymore) */
 #if (defined (ADC_PAL_S32K1xx))
     pdb_clk_prescaler_div_t pdbPrescaler;                            /*!< PDB clock prescaler */
+    bool dmaEnable;                                                   /*!< Results are collected by eDMA instead of the ADC interrupt */
+    uint8_t dmaChannel;                                               /*!< eDMA channel moving the results */
+    uint8_t dmaTrigChannel;                                           /*!< eDMA channel retriggering PDB for continuous SW triggered groups */
+    uint16_t dmaHalfOffset;                                           /*!< Offset of the second half of the result buffer of the active group */
+    uint32_t dmaPdbTrigger;                                           /*!< PDB SC value written by dmaTrigChannel, with SWTRIG set */
+    const adc_group_hw_s32k1xx_t * groupHwArray;                      /*!< Compare and averaging settings of the groups, may be NULL */
 #endif
 #if (defined (ADC_PAL_MPC574xC_G_R) || defined (ADC_PAL_SAR_CTU))
     uint32_t stateIdxMapping[ADC_PAL_TOTAL_NUM_GROUPS];               /*!< Maps groupIdx to index in hwTrigGroupState. For groupIdx corresponding to swTrigGroups, value is invalid. */
@@ -133,17 +139,57 @@ static const trgmux_target_module_t adcPalTrgmuxTarget[ADC_INSTANCE_COUNT] = {
 #endif
 };
 
+static const dma_request_source_t adcPalDmaRequest[ADC_INSTANCE_COUNT] = {
+#if (ADC_INSTANCE_COUNT >= 1u)
+    EDMA_REQ_ADC0,
+#endif
+#if (ADC_INSTANCE_COUNT >= 2u)
+    EDMA_REQ_ADC1
+#endif
+};
+
+static PDB_Type * const adcPalPdbBase[PDB_INSTANCE_COUNT] = PDB_BASE_PTRS;
+static ADC_Type * const adcPalAdcBase[ADC_INSTANCE_COUNT] = ADC_BASE_PTRS;
+
+/* Software TCDs of the DMA mode, one per set of the result buffer; the extra element leaves room for the 32 bytes alignment */
+static edma_software_tcd_t adcPalDmaStcd[ADC_INSTANCE_COUNT][ADC_PAL_DMA_MAX_SETS + 1u];
+static edma_chn_state_t adcPalDmaChnState[ADC_INSTANCE_COUNT];
+static edma_chn_state_t adcPalDmaTrigChnState[ADC_INSTANCE_COUNT];
+
 static status_t ADC_Init_S32K1xx(const uint32_t instance,
                                  const adc_config_t * const config);
 
 static inline void ADC_ConfigPdbAndPretriggers(const uint32_t instIdx,
                                                const pdb_trigger_src_t trgSrc,
-                                               const adc_group_config_t * currentGroupCfg);
+                                               const adc_group_config_t * currentGroupCfg,
+                                               const uint16_t period);
+
+static inline bool ADC_GroupIsMonitored(const uint32_t instance,
+                                        const uint32_t groupIdx);
+
+static inline uint16_t ADC_GroupPdbPeriod(const uint32_t instance,
+                                          const uint32_t groupIdx);
+
+static bool ADC_UpdatePretriggers(const uint32_t instance,
+                                  const uint32_t groupIdx);
+
+static void ADC_UpdateChannels(const uint32_t instance,
+                               const uint32_t groupIdx);
+
+static void ADC_ConfigGroupHw(const uint32_t instance,
+                              const uint32_t groupIdx);
 
 static void ADC_ConfigGroup(const uint32_t instance,
                             const uint32_t groupIdx,
                             const bool hwTriggerFlag);
 
+static void ADC_ConfigDma(const uint32_t instance,
+                          const uint32_t groupIdx,
+                          const bool hwTriggerFlag);
+
+static void ADC_DmaCallback(void * parameter,
+                            edma_chn_status_t status);
+
 static status_t ADC_StopGroupBlocking(const uint32_t instance,
                                       const uint32_t timeout);
 
@@ -291,7 +337,11 @@ status_t ADC_Init(const adc_instance_t * const instance,
 
     /* Initialize state members specific for this platform */
     const extension_adc_s32k1xx_t * const extension = (extension_adc_s32k1xx_t *)(config->extension);
-    palState->pdbPrescaler = extension->pdbPrescaler;
+    palState->pdbPrescaler   = extension->pdbPrescaler;
+    palState->dmaEnable      = extension->dmaEnable;
+    palState->dmaChannel     = extension->dmaChannel;
+    palState->dmaTrigChannel = extension->dmaTrigChannel;
+    palState->groupHwArray   = extension->groupHwArray;
 
     status = ADC_Init_S32K1xx(instIdx, config);
 
@@ -360,7 +410,13 @@ status_t ADC_Deinit(const adc_instance_t * const instance)
     {
 #if defined (ADC_PAL_S32K1xx)
 
-        /* No state members specific for this platform to reset */
+        if (palState->dmaEnable == true)
+        {
+            (void)EDMA_DRV_StopChannel(palState->dmaChannel);
+            (void)EDMA_DRV_ReleaseChannel(palState->dmaChannel);
+            (void)EDMA_DRV_ReleaseChannel(palState->dmaTrigChannel);
+            palState->dmaEnable = false;
+        }
 
         PDB_DRV_Deinit(instIdx);
 
@@ -469,10 +525,13 @@ status_t ADC_EnableHardwareTrigger(const adc_instance_t * const instance,
 
 #if defined (ADC_PAL_S32K1xx)
 
-        /* Enable the ADC interrupt from Interrupt Manager */
-        IRQn_Type adcIrqId;
-        adcIrqId = ADC_DRV_GetInterruptNumber(instIdx);
-        INT_SYS_EnableIRQ(adcIrqId);
+        /* Enable the ADC interrupt from Interrupt Manager, in DMA mode the eDMA channel interrupt is used instead */
+        if (palState->dmaEnable == false)
+        {
+            IRQn_Type adcIrqId;
+            adcIrqId = ADC_DRV_GetInterruptNumber(instIdx);
+            INT_SYS_EnableIRQ(adcIrqId);
+        }
 
         /* The group shall be configured each time it is enabled. */
         ADC_ConfigGroup(instIdx, groupIdx, true);
@@ -670,10 +729,13 @@ status_t ADC_StartGroupConversion(const adc_instance_t * const instance,
 
         bool hwTriggerEnabled = false;
 
-        /* Enable the ADC interrupt from Interrupt Manager */
-        IRQn_Type adcIrqId;
-        adcIrqId = ADC_DRV_GetInterruptNumber(instIdx);
-        INT_SYS_EnableIRQ(adcIrqId);
+        /* Enable the ADC interrupt from Interrupt Manager, in DMA mode the eDMA channel interrupt is used instead */
+        if (palState->dmaEnable == false)
+        {
+            IRQn_Type adcIrqId;
+            adcIrqId = ADC_DRV_GetInterruptNumber(instIdx);
+            INT_SYS_EnableIRQ(adcIrqId);
+        }
 
         ADC_ConfigGroup(instIdx, groupIdx, hwTriggerEnabled);
 
@@ -911,6 +973,128 @@ status_t ADC_DisableNotification(const adc_instance_t * const instance,
     return status;
 }
 
+#if defined (ADC_PAL_S32K1xx)
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : ADC_SwitchGroup
+ * Description   : Replaces the active conversion group by another one, writing
+ * only the ADC and PDB registers which differ between the two groups.
+ *
+ * END**************************************************************************/
+status_t ADC_SwitchGroup(const adc_instance_t * const instance,
+                         const uint32_t groupIdx,
+                         const uint32_t timeout)
+{
+    DEV_ASSERT(instance != NULL);
+
+    uint32_t instIdx = instance->instIdx;
+    DEV_ASSERT(instIdx < NUMBER_OF_ADC_PAL_INSTANCES);
+
+    adc_pal_state_t * const palState = &(adcPalState[instIdx]);
+    DEV_ASSERT(groupIdx < palState->numGroups);
+    DEV_ASSERT(palState->groupArray != NULL);
+
+    const adc_group_config_t * const newGroupCfg = &(palState->groupArray[groupIdx]);
+    const adc_group_config_t * const oldGroupCfg = &(palState->groupArray[palState->latestGroupIdx]);
+    const ADC_Type * const adcBase = adcPalAdcBase[instIdx];
+    const IRQn_Type adcIrqId = ADC_DRV_GetInterruptNumber(instIdx);
+    uint32_t startTime, deltaTime;
+    status_t status;
+
+    DEV_ASSERT(newGroupCfg->numChannels <= ADC_PAL_MAX_CONVS_IN_GROUP);
+
+    if ((palState->swTrigGroupState.active == false) && (ADC_AnyHwTrigGroupActive(instIdx) == false))
+    {
+        /* Nothing to switch from */
+        return (newGroupCfg->hwTriggerSupport == true) ? ADC_EnableHardwareTrigger(instance, groupIdx) :
+                                                         ADC_StartGroupConversion(instance, groupIdx);
+    }
+
+    /* Hold off the triggers of the active group: no notification retriggers a SW group,
+     * no HW trigger reaches PDB, and a PDB in continuous mode is stopped */
+    INT_SYS_DisableIRQ(adcIrqId);
+    if (oldGroupCfg->hwTriggerSupport == true)
+    {
+        status = TRGMUX_DRV_SetTrigSourceForTargetModule(ADC_PAL_TRGMUX_IDX, TRGMUX_TRIG_SOURCE_DISABLED, adcPalTrgmuxTarget[instIdx]);
+        DEV_ASSERT(status == STATUS_SUCCESS);
+    }
+    if (palState->dmaEnable == true)
+    {
+        (void)EDMA_DRV_StopChannel(palState->dmaChannel);
+    }
+    PDB_DRV_Disable(instIdx);
+
+    /* Make sure OSIF timer is initialized. */
+    OSIF_TimeDelay(0u);
+    startTime = OSIF_GetMilliseconds();
+    deltaTime = 0u;
+    while ((ADC_GetConvActiveFlag(adcBase) == true) && (deltaTime < timeout))
+    {
+        deltaTime = OSIF_GetMilliseconds() - startTime;
+    }
+
+    palState->swTrigGroupState.active   = false;
+    palState->hwTrigGroupState[0].active = false;
+
+    if (deltaTime >= timeout)
+    {
+        return STATUS_TIMEOUT;
+    }
+
+    if (palState->groupHwArray != NULL)
+    {
+        ADC_ConfigGroupHw(instIdx, groupIdx);
+    }
+
+    if ((oldGroupCfg->hwTriggerSupport != newGroupCfg->hwTriggerSupport) ||
+        (ADC_GroupPdbPeriod(instIdx, palState->latestGroupIdx) != ADC_GroupPdbPeriod(instIdx, groupIdx)))
+    {
+        /* Trigger input or continuous mode changes, set PDB up again */
+        ADC_ConfigPdbAndPretriggers(instIdx, (newGroupCfg->hwTriggerSupport == true) ? PDB_TRIGGER_IN0 : PDB_SOFTWARE_TRIGGER,
+                                    newGroupCfg, ADC_GroupPdbPeriod(instIdx, groupIdx));
+    }
+    else
+    {
+        PDB_DRV_Enable(instIdx);
+        if (ADC_UpdatePretriggers(instIdx, groupIdx) == true)
+        {
+            PDB_DRV_LoadValuesCmd(instIdx);
+        }
+    }
+
+    ADC_UpdateChannels(instIdx, groupIdx);
+
+    if (palState->dmaEnable == true)
+    {
+        ADC_ConfigDma(instIdx, groupIdx, newGroupCfg->hwTriggerSupport);
+    }
+
+    ADC_PalStateUpdateStart(instIdx, groupIdx);
+
+    if (palState->dmaEnable == false)
+    {
+        /* Drop the interrupt of a conversion of the previous group which completed meanwhile */
+        INT_SYS_ClearPending(adcIrqId);
+        INT_SYS_EnableIRQ(adcIrqId);
+    }
+
+    if (newGroupCfg->hwTriggerSupport == true)
+    {
+        status = TRGMUX_DRV_SetTrigSourceForTargetModule(ADC_PAL_TRGMUX_IDX, newGroupCfg->triggerSource, adcPalTrgmuxTarget[instIdx]);
+        DEV_ASSERT(status == STATUS_SUCCESS);
+    }
+    else
+    {
+        /* Sw trigger PDB */
+        PDB_DRV_SoftTriggerCmd(instIdx);
+    }
+
+    return STATUS_SUCCESS;
+}
+
+#endif /* defined(ADC_PAL_S32K1xx) */
+
 
 /*******************************************************************************
  * Private Functions
@@ -939,6 +1123,17 @@ static status_t ADC_Init_S32K1xx(const uint32_t instance,
             currentGroupCfg = &(adcPalState[instance].groupArray[idx]);
             /* Error if number of conversions is larger than max supported */
             DEV_ASSERT(currentGroupCfg->numChannels <= ADC_PAL_MAX_CONVS_IN_GROUP);
+            /* Error if there are not enough software TCDs for the result buffer */
+            DEV_ASSERT((extension->dmaEnable == false) || (currentGroupCfg->numSetsResultBuffer <= ADC_PAL_DMA_MAX_SETS));
+
+            if ((extension->groupHwArray != NULL) && (extension->groupHwArray[idx].compare.compareEnable == true))
+            {
+                /* Results failing the compare raise no eDMA request, the ring would stall */
+                DEV_ASSERT(extension->dmaEnable == false);
+                /* Continuous SW triggered groups need the PDB period, the notification does not retrigger them */
+                DEV_ASSERT((currentGroupCfg->hwTriggerSupport == true) || (currentGroupCfg->continuousConvEn == false) ||
+                           (extension->groupHwArray[idx].monitorPeriod > 0u));
+            }
 
             if (currentGroupCfg->delayType == ADC_DELAY_TYPE_INDIVIDUAL_DELAY)
             {
@@ -970,10 +1165,19 @@ static status_t ADC_Init_S32K1xx(const uint32_t instance,
     adcCfg.voltageRef             = extension->voltageRef;
     adcCfg.supplyMonitoringEnable = extension->supplyMonitoringEnable;
     adcCfg.pretriggerSel          = ADC_PRETRIGGER_SEL_PDB; /* configure pretriggers 0->3 to be routed from PDB */
+    adcCfg.dmaEnable              = extension->dmaEnable;   /* each conversion complete flag requests the eDMA channel */
 
     ADC_DRV_ConfigConverter(instance, &adcCfg);
 
-    ADC_DRV_AutoCalibration(instance);
+    if (extension->calibration != NULL)
+    {
+        /* Skip the calibration sequence, the results were saved on a previous boot */
+        ADC_DRV_ConfigAutoCalibration(instance, extension->calibration);
+    }
+    else
+    {
+        ADC_DRV_AutoCalibration(instance);
+    }
 
     /* PDB init shall only be called from StartConversion() & EnableHardwareTrigger()
      * because PDB input source and continuous conversion enable need to be configured for each call. */
@@ -986,6 +1190,31 @@ static status_t ADC_Init_S32K1xx(const uint32_t instance,
         status = STATUS_ERROR;
     }
 
+    if ((status == STATUS_SUCCESS) && (extension->dmaEnable == true))
+    {
+        edma_channel_config_t dmaChnCfg;
+
+        DEV_ASSERT(extension->dmaChannel != extension->dmaTrigChannel);
+
+        dmaChnCfg.channelPriority = EDMA_CHN_DEFAULT_PRIORITY;
+        dmaChnCfg.virtChnConfig   = extension->dmaChannel;
+        dmaChnCfg.source          = adcPalDmaRequest[instance];
+        dmaChnCfg.callback        = ADC_DmaCallback;
+        dmaChnCfg.callbackParam   = (void *)instance;
+        dmaChnCfg.enableTrigger   = false;
+        status = EDMA_DRV_ChannelInit(&(adcPalDmaChnState[instance]), &dmaChnCfg);
+
+        if (status == STATUS_SUCCESS)
+        {
+            /* Only started by the major loop link from dmaChannel */
+            dmaChnCfg.virtChnConfig = extension->dmaTrigChannel;
+            dmaChnCfg.source        = EDMA_REQ_DISABLED;
+            dmaChnCfg.callback      = NULL;
+            dmaChnCfg.callbackParam = NULL;
+            status = EDMA_DRV_ChannelInit(&(adcPalDmaTrigChnState[instance]), &dmaChnCfg);
+        }
+    }
+
     return status;
 }
 
@@ -1024,16 +1253,24 @@ void ADC_S32K1xx_IrqHandler(const uint32_t instIdx)
         result++;
     }
 
-    /* Increment offset in result buffer */
-    groupState->currentBufferOffset = (uint16_t)((groupState->currentBufferOffset + activeGroupCfg->numChannels) % groupState->bufferLength);
+    /* Increment offset in result buffer, bufferLength is a multiple of numChannels */
+    groupState->currentBufferOffset = (uint16_t)(groupState->currentBufferOffset + activeGroupCfg->numChannels);
+    if (groupState->currentBufferOffset >= groupState->bufferLength)
+    {
+        groupState->currentBufferOffset = 0u;
+    }
 
 
     if (activeGroupCfg->hwTriggerSupport == false) /* Continuous mode currently supported only for SW triggered groups */
     {
         if (activeGroupCfg->continuousConvEn == true)
         {
-            /* Sw trigger PDB */
-            PDB_DRV_SoftTriggerCmd(instIdx);
+            /* Monitored groups are restarted by the PDB counter in continuous mode */
+            if (ADC_GroupIsMonitored(instIdx, currentGroupIdx) == false)
+            {
+                /* Sw trigger PDB */
+                PDB_DRV_SoftTriggerCmd(instIdx);
+            }
         }
         else
         {
@@ -1045,6 +1282,65 @@ void ADC_S32K1xx_IrqHandler(const uint32_t instIdx)
     ADC_CallNotificationCb(palState, currentGroupIdx, groupState);
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : ADC_DmaCallback
+ * Description   : eDMA channel callback of the DMA mode, called when a half of
+ * the result buffer has been filled (after each set for single shot SW triggered groups).
+ *
+ * END**************************************************************************/
+static void ADC_DmaCallback(void * parameter,
+                            edma_chn_status_t status)
+{
+    const uint32_t instIdx           = (uint32_t)parameter;
+    adc_pal_state_t * const palState = &(adcPalState[instIdx]);
+    const uint32_t currentGroupIdx   = palState->latestGroupIdx;
+    const adc_group_config_t * activeGroupCfg;
+    adc_group_state_t * groupState;
+    uint16_t nextOffset;
+
+    activeGroupCfg = &(palState->groupArray[currentGroupIdx]);
+
+    if (activeGroupCfg->hwTriggerSupport == false)
+    {
+        groupState = &(palState->swTrigGroupState);
+    }
+    else
+    {
+        groupState = &(palState->hwTrigGroupState[0u]); /* A single HW trigger enabled is supported by this platform */
+    }
+
+    if (status == EDMA_CHN_ERROR)
+    {
+        /* The eDMA driver already stopped the channel */
+        groupState->active = false;
+    }
+    else
+    {
+        /* The channel already loaded the TCD of the next set, its destination is the next position to be written */
+        nextOffset = (uint16_t)((DMA->TCD[palState->dmaChannel].DADDR - (uint32_t)activeGroupCfg->resultBuffer) / sizeof(uint16_t));
+
+        if ((activeGroupCfg->hwTriggerSupport == false) && (activeGroupCfg->continuousConvEn == false))
+        {
+            /* Single shot: the channel is idle until the next start */
+            groupState->currentBufferOffset = nextOffset;
+            groupState->active              = false;
+        }
+        else if ((palState->dmaHalfOffset != 0u) && (nextOffset >= palState->dmaHalfOffset))
+        {
+            /* First half filled, the channel is already writing the second one */
+            groupState->currentBufferOffset = palState->dmaHalfOffset;
+        }
+        else
+        {
+            groupState->currentBufferOffset = 0u;
+        }
+
+        /* Call notification callback, if it is enabled */
+        ADC_CallNotificationCb(palState, currentGroupIdx, groupState);
+    }
+}
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : ADC_ConfigPdbAndPretriggers
@@ -1053,7 +1349,8 @@ void ADC_S32K1xx_IrqHandler(const uint32_t instIdx)
  * END**************************************************************************/
 static inline void ADC_ConfigPdbAndPretriggers(const uint32_t instIdx,
                                                const pdb_trigger_src_t trgSrc,
-                                               const adc_group_config_t * currentGroupCfg)
+                                               const adc_group_config_t * currentGroupCfg,
+                                               const uint16_t period)
 {
     pdb_timer_config_t pdbCfg;
     pdb_adc_pretrigger_config_t pdbPretrigCfg;
@@ -1066,7 +1363,7 @@ static inline void ADC_ConfigPdbAndPretriggers(const uint32_t instIdx,
     pdbCfg.clkPreMultFactor     = PDB_CLK_PREMULT_FACT_AS_1;
     pdbCfg.dmaEnable            = false;
     pdbCfg.intEnable            = false;
-    pdbCfg.continuousModeEnable = false; /* Continuous mode refers to Counter being reset at zero - not used in ADC PAL */
+    pdbCfg.continuousModeEnable = (period > 0u); /* Continuous mode refers to Counter being reset at zero - only used by monitored groups */
     pdbCfg.triggerInput         = trgSrc;
 #if FEATURE_PDB_HAS_INSTANCE_BACKTOBACK
     pdbCfg.instanceBackToBackEnable     = false;
@@ -1074,15 +1371,28 @@ static inline void ADC_ConfigPdbAndPretriggers(const uint32_t instIdx,
 	
     PDB_DRV_Init(instIdx, &pdbCfg);
 
+    if (period > 0u)
+    {
+        /* The counter restarts the group every period ticks */
+        PDB_DRV_SetTimerModulusValue(instIdx, period);
+    }
+
     if (currentGroupCfg->delayType == ADC_DELAY_TYPE_NO_DELAY)
     {
         /* PDB pre-triggers configuration */
         pdbPretrigCfg.preTriggerEnable           = true;
-        pdbPretrigCfg.preTriggerOutputEnable     = false; /* pretrigger asserts one clock cycle after input trigger is asserted (hw or sw)  */
+        pdbPretrigCfg.preTriggerOutputEnable     = (period > 0u); /* pretrigger asserts one clock cycle after input trigger is asserted (hw or sw),
+                                                                      or at each counter pass of the delay in continuous mode */
         pdbPretrigCfg.preTriggerBackToBackEnable = false; /* the first pretrigger in the group must have BB disabled */
         pdbPretrigCfg.adcPreTriggerIdx           = 0u;
         PDB_DRV_ConfigAdcPreTrigger(instIdx, ADC_PAL_PDB_CHAN, &pdbPretrigCfg);
+        if (period > 0u)
+        {
+            PDB_DRV_SetAdcPreTriggerDelayValue(instIdx, ADC_PAL_PDB_CHAN, 0u, 1u);
+        }
+
 
+        pdbPretrigCfg.preTriggerOutputEnable     = false; /* the rest of pretriggers in the group ignore the delay value */
         pdbPretrigCfg.preTriggerBackToBackEnable = true; /* the rest of pretriggers in the group must have BB enabled */
         for (idx = 1u; idx < currentGroupCfg->numChannels; idx++)
         {
@@ -1132,6 +1442,171 @@ static inline void ADC_ConfigPdbAndPretriggers(const uint32_t instIdx,
     PDB_DRV_LoadValuesCmd(instIdx);
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : ADC_GroupIsMonitored
+ * Description   : Returns true for continuous SW triggered groups with hardware compare,
+ * which are restarted by the PDB counter instead of the notification.
+ *
+ * END**************************************************************************/
+static inline bool ADC_GroupIsMonitored(const uint32_t instance,
+                                        const uint32_t groupIdx)
+{
+    const adc_pal_state_t * const palState = &(adcPalState[instance]);
+    const adc_group_config_t * const groupCfg = &(palState->groupArray[groupIdx]);
+
+    return (palState->groupHwArray != NULL) &&
+           (palState->groupHwArray[groupIdx].compare.compareEnable == true) &&
+           (groupCfg->hwTriggerSupport == false) && (groupCfg->continuousConvEn == true);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : ADC_GroupPdbPeriod
+ * Description   : Returns the PDB continuous mode period of a group, 0 if the PDB
+ * runs one set per trigger.
+ *
+ * END**************************************************************************/
+static inline uint16_t ADC_GroupPdbPeriod(const uint32_t instance,
+                                          const uint32_t groupIdx)
+{
+    return (ADC_GroupIsMonitored(instance, groupIdx) == true) ?
+           adcPalState[instance].groupHwArray[groupIdx].monitorPeriod : 0u;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : ADC_UpdatePretriggers
+ * Description   : Writes the PDB pre-trigger enables and delays of a group,
+ * skipping the registers which already hold the right value.
+ * Same settings as ADC_ConfigPdbAndPretriggers, the PDB itself is left configured.
+ * Returns true if a delay changed, the delays then need a load command.
+ *
+ * END**************************************************************************/
+static bool ADC_UpdatePretriggers(const uint32_t instance,
+                                  const uint32_t groupIdx)
+{
+    const adc_group_config_t * const groupCfg = &(adcPalState[instance].groupArray[groupIdx]);
+    PDB_Type * const pdbBase = adcPalPdbBase[instance];
+    const uint32_t enMask = ((uint32_t)1u << groupCfg->numChannels) - 1u;
+    uint32_t tosMask, bbMask, c1;
+    bool delayChanged = false;
+    uint8_t idx;
+
+    if (groupCfg->delayType == ADC_DELAY_TYPE_NO_DELAY)
+    {
+        tosMask = (ADC_GroupPdbPeriod(instance, groupIdx) > 0u) ? 1u : 0u;
+        bbMask  = enMask & ~1u;
+    }
+    else if (groupCfg->delayType == ADC_DELAY_TYPE_GROUP_DELAY)
+    {
+        tosMask = 1u;
+        bbMask  = enMask & ~1u;
+    }
+    else /* corresponds to groupCfg->delayType == ADC_DELAY_TYPE_INDIVIDUAL_DELAY */
+    {
+        tosMask = enMask;
+        bbMask  = 0u;
+    }
+
+    c1 = PDB_C1_EN(enMask) | PDB_C1_TOS(tosMask) | PDB_C1_BB(bbMask);
+    if (pdbBase->CH[ADC_PAL_PDB_CHAN].C1 != c1)
+    {
+        pdbBase->CH[ADC_PAL_PDB_CHAN].C1 = c1;
+    }
+
+    for (idx = 0u; idx < groupCfg->numChannels; idx++)
+    {
+        uint32_t delay;
+
+        if ((tosMask & ((uint32_t)1u << idx)) == 0u)
+        {
+            continue;
+        }
+
+        if (groupCfg->delayType == ADC_DELAY_TYPE_NO_DELAY)
+        {
+            delay = 1u; /* monitored group, see ADC_ConfigPdbAndPretriggers */
+        }
+        else
+        {
+            DEV_ASSERT(groupCfg->delayArray != NULL);
+            delay = groupCfg->delayArray[(groupCfg->delayType == ADC_DELAY_TYPE_GROUP_DELAY) ? 0u : idx];
+        }
+
+        if (pdbBase->CH[ADC_PAL_PDB_CHAN].DLY[idx] != delay)
+        {
+            PDB_DRV_SetAdcPreTriggerDelayValue(instance, ADC_PAL_PDB_CHAN, idx, delay);
+            delayChanged = true;
+        }
+    }
+
+    return delayChanged;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : ADC_UpdateChannels
+ * Description   : Writes the ADC input channels of a group, skipping the SC1n
+ * registers which already hold the right value. Results left from the previous
+ * group are read out so they raise no request or interrupt.
+ *
+ * END**************************************************************************/
+static void ADC_UpdateChannels(const uint32_t instance,
+                               const uint32_t groupIdx)
+{
+    const adc_group_config_t * const groupCfg = &(adcPalState[instance].groupArray[groupIdx]);
+    adc_chan_config_t currentCfg, adcChanCfg;
+    uint16_t staleResult;
+    uint8_t idx;
+
+    for (idx = 0u; idx < groupCfg->numChannels; idx++)
+    {
+        adcChanCfg.channel         = groupCfg->inputChannelArray[idx];
+        /* interrupt only for the last conversion in the group, unless eDMA collects the results */
+        adcChanCfg.interruptEnable = (idx == (groupCfg->numChannels - 1u)) && (adcPalState[instance].dmaEnable == false);
+
+        ADC_DRV_GetChanConfig(instance, idx, &currentCfg);
+        if ((currentCfg.channel != adcChanCfg.channel) || (currentCfg.interruptEnable != adcChanCfg.interruptEnable))
+        {
+            ADC_DRV_ConfigChan(instance, idx, &adcChanCfg); /* also clears the conversion complete flag */
+        }
+        else
+        {
+            ADC_DRV_GetChanResult(instance, idx, &staleResult);
+        }
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : ADC_ConfigGroupHw
+ * Description   : Configures the hardware compare and averaging of a conversion group,
+ * both are disabled for groups without settings.
+ *
+ * END**************************************************************************/
+static void ADC_ConfigGroupHw(const uint32_t instance,
+                              const uint32_t groupIdx)
+{
+    const adc_pal_state_t * const palState = &(adcPalState[instance]);
+    adc_compare_config_t compareCfg;
+    adc_average_config_t averageCfg;
+
+    if (palState->groupHwArray != NULL)
+    {
+        compareCfg = palState->groupHwArray[groupIdx].compare;
+        averageCfg = palState->groupHwArray[groupIdx].average;
+    }
+    else
+    {
+        ADC_DRV_InitHwCompareStruct(&compareCfg);
+        ADC_DRV_InitHwAverageStruct(&averageCfg);
+    }
+
+    ADC_DRV_ConfigHwCompare(instance, &compareCfg);
+    ADC_DRV_ConfigHwAverage(instance, &averageCfg);
+}
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : ADC_ConfigGroup
@@ -1156,8 +1631,13 @@ static void ADC_ConfigGroup(const uint32_t instance,
         DEV_ASSERT(currentGroupCfg->delayType == ADC_DELAY_TYPE_NO_DELAY);
     }
 
+    /* Hardware compare and averaging apply to all conversions, set them before the first trigger */
+    ADC_ConfigGroupHw(instance, groupIdx);
+
     /* Configure PDB instance and pre-triggers */
-    ADC_ConfigPdbAndPretriggers(instance, pdbTrigSrc, currentGroupCfg);
+    ADC_ConfigPdbAndPretriggers(instance, pdbTrigSrc, currentGroupCfg,
+                                (ADC_GroupIsMonitored(instance, groupIdx) == true) ?
+                                adcPalState[instance].groupHwArray[groupIdx].monitorPeriod : 0u);
 
     /* Configure ADC channels */
     adc_chan_config_t adcChanCfg;
@@ -1171,9 +1651,123 @@ static void ADC_ConfigGroup(const uint32_t instance,
         ADC_DRV_ConfigChan(instance, idx, &adcChanCfg); /* conversion complete flag is cleared implicitly when writing a new configuration */
     }
 
-    adcChanCfg.interruptEnable = true; /* enable interrupt for last conversion in the group */
+    adcChanCfg.interruptEnable = !adcPalState[instance].dmaEnable; /* enable interrupt for last conversion in the group, unless eDMA collects the results */
     adcChanCfg.channel         = currentGroupCfg->inputChannelArray[idx]; /* set the ADC input channel */
     ADC_DRV_ConfigChan(instance, idx, &adcChanCfg); /* configure the last conversion in the group */
+
+    if (adcPalState[instance].dmaEnable == true)
+    {
+        ADC_ConfigDma(instance, groupIdx, hwTriggerFlag);
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : ADC_ConfigDma
+ * Description   : Configures the eDMA channels of the DMA mode for a conversion group.
+ * Each set of the result buffer has its own TCD, chained in a ring by scatter/gather:
+ * every conversion complete request moves one result, R[0]..R[numChannels-1],
+ * and the major loop interrupt is only enabled at the half and at the end of the buffer.
+ * Continuous SW triggered groups link each major loop to dmaTrigChannel, which
+ * writes SWTRIG to PDB to start the next set without CPU intervention.
+ *
+ * END**************************************************************************/
+static void ADC_ConfigDma(const uint32_t instance,
+                          const uint32_t groupIdx,
+                          const bool hwTriggerFlag)
+{
+    adc_pal_state_t * const palState                 = &(adcPalState[instance]);
+    const adc_group_config_t * const currentGroupCfg = &(palState->groupArray[groupIdx]);
+    edma_software_tcd_t * const stcd                 = (edma_software_tcd_t *)STCD_ADDR(adcPalDmaStcd[instance]);
+    const uint8_t numChans                           = currentGroupCfg->numChannels;
+    const uint8_t numSets                            = currentGroupCfg->numSetsResultBuffer;
+    const uint8_t halfSet                            = numSets / 2u;
+    const bool singleShot                            = (hwTriggerFlag == false) && (currentGroupCfg->continuousConvEn == false);
+    const bool retrigger                             = (hwTriggerFlag == false) && (currentGroupCfg->continuousConvEn == true);
+    static ADC_Type * const adcBase[ADC_INSTANCE_COUNT] = ADC_BASE_PTRS;
+    edma_loop_transfer_config_t loopCfg;
+    edma_transfer_config_t xferCfg;
+    uint8_t setIdx;
+
+    DEV_ASSERT((numSets > 0u) && (numSets <= ADC_PAL_DMA_MAX_SETS));
+
+    (void)EDMA_DRV_StopChannel(palState->dmaChannel);
+
+    palState->dmaHalfOffset = (uint16_t)halfSet * numChans;
+
+    loopCfg.srcOffsetEnable        = false;
+    loopCfg.dstOffsetEnable        = false;
+    loopCfg.minorLoopOffset        = 0;
+    loopCfg.minorLoopChnLinkEnable = false;
+    loopCfg.minorLoopChnLinkNumber = 0u;
+    loopCfg.majorLoopChnLinkEnable = false;
+    loopCfg.majorLoopChnLinkNumber = 0u;
+
+    if (retrigger == true)
+    {
+        /* PDB is already configured for this group, keep its SC value and only add SWTRIG */
+        palState->dmaPdbTrigger = (adcPalPdbBase[instance]->SC & ~PDB_SC_LDOK_MASK) | PDB_SC_SWTRIG_MASK;
+
+        loopCfg.majorLoopIterationCount = 1u;
+
+        xferCfg.srcAddr                = (uint32_t)&(palState->dmaPdbTrigger);
+        xferCfg.destAddr               = (uint32_t)&(adcPalPdbBase[instance]->SC);
+        xferCfg.srcTransferSize        = EDMA_TRANSFER_SIZE_4B;
+        xferCfg.destTransferSize       = EDMA_TRANSFER_SIZE_4B;
+        xferCfg.srcOffset              = 0;
+        xferCfg.destOffset             = 0;
+        xferCfg.srcLastAddrAdjust      = 0;
+        xferCfg.destLastAddrAdjust     = 0;
+        xferCfg.srcModulo              = EDMA_MODULO_OFF;
+        xferCfg.destModulo             = EDMA_MODULO_OFF;
+        xferCfg.minorByteTransferCount = sizeof(uint32_t);
+        xferCfg.scatterGatherEnable    = false;
+        xferCfg.interruptEnable        = false;
+        xferCfg.loopTransferConfig     = &loopCfg;
+        EDMA_DRV_PushConfigToReg(palState->dmaTrigChannel, &xferCfg);
+
+        loopCfg.majorLoopChnLinkEnable = true;
+        loopCfg.majorLoopChnLinkNumber = palState->dmaTrigChannel;
+    }
+
+    /* One minor loop per conversion complete request, reading the next result register */
+    loopCfg.majorLoopIterationCount = numChans;
+
+    xferCfg.srcAddr                = (uint32_t)&(adcBase[instance]->R[0u]);
+    xferCfg.srcTransferSize        = EDMA_TRANSFER_SIZE_2B;
+    xferCfg.destTransferSize       = EDMA_TRANSFER_SIZE_2B;
+    xferCfg.srcOffset              = (int16_t)sizeof(adcBase[instance]->R[0u]);
+    xferCfg.destOffset             = (int16_t)sizeof(uint16_t);
+    xferCfg.srcLastAddrAdjust      = -((int32_t)numChans * (int32_t)sizeof(adcBase[instance]->R[0u]));
+    xferCfg.destLastAddrAdjust     = 0;
+    xferCfg.srcModulo              = EDMA_MODULO_OFF;
+    xferCfg.destModulo             = EDMA_MODULO_OFF;
+    xferCfg.minorByteTransferCount = sizeof(uint16_t);
+    xferCfg.scatterGatherEnable    = true;
+    xferCfg.loopTransferConfig     = &loopCfg;
+
+    for (setIdx = 0u; setIdx < numSets; setIdx++)
+    {
+        const uint8_t nextSetIdx = ((setIdx + 1u) < numSets) ? (setIdx + 1u) : 0u;
+
+        xferCfg.destAddr                  = (uint32_t)&(currentGroupCfg->resultBuffer[(uint16_t)setIdx * numChans]);
+        xferCfg.scatterGatherNextDescAddr = (uint32_t)&(stcd[nextSetIdx]);
+        xferCfg.interruptEnable           = singleShot || (nextSetIdx == 0u) || ((setIdx + 1u) == halfSet);
+
+        EDMA_DRV_PushConfigToSTCD(&xferCfg, &(stcd[setIdx]));
+        if (retrigger == true)
+        {
+            /* PushConfigToSTCD does not handle the channel linking */
+            stcd[setIdx].CSR |= (uint16_t)(DMA_TCD_CSR_MAJORELINK_MASK | DMA_TCD_CSR_MAJORLINKCH(palState->dmaTrigChannel));
+        }
+
+        if (setIdx == 0u)
+        {
+            EDMA_DRV_PushConfigToReg(palState->dmaChannel, &xferCfg);
+        }
+    }
+
+    (void)EDMA_DRV_StartChannel(palState->dmaChannel);
 }
 
 /*FUNCTION**********************************************************************
@@ -1197,6 +1791,12 @@ static status_t ADC_StopGroupBlocking(const uint32_t instance,
     startTime = OSIF_GetMilliseconds();
     deltaTime = 0u;
 
+    if (palState->dmaEnable == true)
+    {
+        /* Stop serving the conversion complete requests first, so dmaTrigChannel is not linked anymore */
+        (void)EDMA_DRV_StopChannel(palState->dmaChannel);
+    }
+
     /* Reset PDB pre-trigger configurations to stop PDB from triggering other conversions in the group */
     pdbPretrigCfg.preTriggerEnable           = false;
     pdbPretrigCfg.preTriggerOutputEnable     = false;
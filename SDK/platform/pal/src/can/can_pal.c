@@ -77,6 +77,7 @@ typedef struct
 {
     bool rxFifoEn;
     flexcan_rx_fifo_id_filter_num_t numIdFilters;
+    uint32_t virtBuffOffset;    /* Buffers occupied by the Rx FIFO, 0 when disabled */
 } flexcan_rx_fifo_state_t;
 
 #endif
@@ -90,10 +91,12 @@ typedef struct
 static flexcan_state_t s_flexcanState[NO_OF_FLEXCAN_INSTS_FOR_CAN];
 /*! @brief FlexCAN state-instance matching */
 static uint32_t s_flexcanStateInstanceMapping[NO_OF_FLEXCAN_INSTS_FOR_CAN];
+/*! @brief FlexCAN instance-state matching, direct-indexed by instance */
+static uint8_t s_flexcanStateIndex[CAN_INSTANCE_COUNT];
 /*! @brief FlexCAN available resources table */
 static bool s_flexcanStateIsAllocated[NO_OF_FLEXCAN_INSTS_FOR_CAN];
-/*! @brief FlexCAN buffer configs */
-static const can_buff_config_t *s_hwObjConfigs[NO_OF_FLEXCAN_INSTS_FOR_CAN][FEATURE_CAN_MAX_MB_NUM];
+/*! @brief FlexCAN data info prebuilt from the buffer configs */
+static flexcan_data_info_t s_hwObjDataInfo[NO_OF_FLEXCAN_INSTS_FOR_CAN][FEATURE_CAN_MAX_MB_NUM];
 /*! @brief FlexCAN Rx FIFO state structures */
 static flexcan_rx_fifo_state_t s_flexcanRxFifoState[NO_OF_FLEXCAN_INSTS_FOR_CAN];
 /*! @brief Callback function provided by user for each instance*/
@@ -164,30 +167,17 @@ static void CAN_FreeState(bool *isAllocated,
 /*FUNCTION**********************************************************************
  *
  * Function Name : CAN_FindFlexCANState
- * Description   : Search the state structure of the FlexCAN instance
+ * Description   : Returns the state structure index of the FlexCAN instance
  *
  *END**************************************************************************/
-static uint8_t CAN_FindFlexCANState(uint32_t instance)
+static inline uint8_t CAN_FindFlexCANState(uint32_t instance)
 {
-    uint8_t i;
+    uint8_t i = s_flexcanStateIndex[instance];
 
-    for (i = 0; i < NO_OF_FLEXCAN_INSTS_FOR_CAN; i++)
-    {
-		if (s_flexcanStateInstanceMapping[i] == instance)
-		{
-			break;
-		}
-    }
-
-    if (i >= NO_OF_FLEXCAN_INSTS_FOR_CAN)
-    {
-    	/* Should Never Reach Here */
-    	DEV_ASSERT(false);
-    	i = (NO_OF_FLEXCAN_INSTS_FOR_CAN-1U);
-    }
+    /* Should Never Fail, the instance is mapped by CAN_Init */
+    DEV_ASSERT(s_flexcanStateInstanceMapping[i] == instance);
 
     return i;
-
 }
 
 /*FUNCTION**********************************************************************
@@ -218,9 +208,9 @@ static void CAN_InternalCallback(uint8_t instance,
     can_callback_t callback = userCallbacks[index];
 
     /* If FlexCAN Rx FIFO is enabled, translate real buffer index to virtual index */
-    if ((s_flexcanRxFifoState[index].rxFifoEn == true) && (buffIdx != 0U))
+    if (buffIdx != 0U)
     {
-        buffIdx -= CAN_GetVirtualBuffIdx((uint32_t) s_flexcanRxFifoState[index].numIdFilters);
+        buffIdx -= s_flexcanRxFifoState[index].virtBuffOffset;
     }
 
     /* Translate FlexCAN events to CAN PAL events and invoke the callback provided by user */
@@ -244,6 +234,20 @@ static void CAN_InternalCallback(uint8_t instance,
                      (uint8_t) buffIdx,
                      (flexcan_state_t *) state);
             break;
+#if FEATURE_CAN_HAS_PRETENDED_NETWORKING
+        case FLEXCAN_EVENT_WAKEUP_TIMEOUT:
+            callback(instance,
+                     CAN_EVENT_WAKEUP_TIMEOUT,
+                     0U,
+                     (flexcan_state_t *) state);
+            break;
+        case FLEXCAN_EVENT_WAKEUP_MATCH:
+            callback(instance,
+                     CAN_EVENT_WAKEUP_MATCH,
+                     0U,
+                     (flexcan_state_t *) state);
+            break;
+#endif
         default:
             /* Event types not implemented in PAL */
             break;
@@ -285,8 +289,11 @@ status_t CAN_Init(const can_instance_t * const instance,
                                   s_flexcanStateInstanceMapping,
                                   instance->instIdx);
 
+        s_flexcanStateIndex[instance->instIdx] = index;
+
         /* Clear Rx FIFO state */
         s_flexcanRxFifoState[index].rxFifoEn = false;
+        s_flexcanRxFifoState[index].virtBuffOffset = 0U;
 
         /* Configure features implemented by PAL */
         flexcanConfig.max_num_mb = config->maxBuffNum;
@@ -331,6 +338,7 @@ status_t CAN_Init(const can_instance_t * const instance,
             /* Update Rx FIFO state */
             s_flexcanRxFifoState[index].rxFifoEn = true;
             s_flexcanRxFifoState[index].numIdFilters = flexcanConfig.num_id_filters;
+            s_flexcanRxFifoState[index].virtBuffOffset = CAN_GetVirtualBuffIdx(flexcanConfig.num_id_filters);
         }
         else
         {
@@ -524,14 +532,12 @@ status_t CAN_ConfigTxBuff(const can_instance_t * const instance,
             .is_remote = false
         };
 
-        /* Save buffer config  for later use */
-        s_hwObjConfigs[index][buffIdx] = config;
+        /* Save buffer data info for later use, frames are sent with the configured RTR bit */
+        s_hwObjDataInfo[index][buffIdx] = dataInfo;
+        s_hwObjDataInfo[index][buffIdx].is_remote = config->isRemote;
 
         /* Compute virtual buffer index */
-        if (s_flexcanRxFifoState[index].rxFifoEn)
-        {
-            buffIdx += CAN_GetVirtualBuffIdx(s_flexcanRxFifoState[index].numIdFilters);
-        }
+        buffIdx += s_flexcanRxFifoState[index].virtBuffOffset;
 
         /* Configure FlexCAN MB for transmission */
         status = FLEXCAN_DRV_ConfigTxMb((uint8_t) instance->instIdx,
@@ -588,14 +594,11 @@ status_t CAN_ConfigRemoteResponseBuff(const can_instance_t * const instance,
             .is_remote = config->isRemote
         };
 
-        /* Save buffer config  for later use */
-        s_hwObjConfigs[index][buffIdx] = config;
+        /* Save buffer data info for later use */
+        s_hwObjDataInfo[index][buffIdx] = dataInfo;
 
         /* Compute virtual buffer index */
-        if (s_flexcanRxFifoState[index].rxFifoEn)
-        {
-            buffIdx += CAN_GetVirtualBuffIdx(s_flexcanRxFifoState[index].numIdFilters);
-        }
+        buffIdx += s_flexcanRxFifoState[index].virtBuffOffset;
 
         /* Configure FlexCAN MB for transmission */
         status = FLEXCAN_DRV_ConfigRemoteResponseMb((uint8_t) instance->instIdx,
@@ -651,14 +654,11 @@ status_t CAN_ConfigRxBuff(const can_instance_t * const instance,
             .is_remote = config->isRemote
         };
 
-        /* Save buffer config for later use */
-        s_hwObjConfigs[index][buffIdx] = config;
+        /* Save buffer data info for later use */
+        s_hwObjDataInfo[index][buffIdx] = dataInfo;
 
         /* Compute virtual buffer index */
-        if (s_flexcanRxFifoState[index].rxFifoEn)
-        {
-            buffIdx += CAN_GetVirtualBuffIdx(s_flexcanRxFifoState[index].numIdFilters);
-        }
+        buffIdx += s_flexcanRxFifoState[index].virtBuffOffset;
 
         /* Configure FlexCAN MB for reception */
         status = FLEXCAN_DRV_ConfigRxMb((uint8_t) instance->instIdx,
@@ -701,22 +701,13 @@ status_t CAN_Send(const can_instance_t * const instance,
         /* Check buffer index to avoid overflow */
         DEV_ASSERT(buffIdx < FEATURE_CAN_MAX_MB_NUM);
 
-        flexcan_data_info_t dataInfo = {
-            .msg_id_type = (flexcan_msgbuff_id_type_t) s_hwObjConfigs[index][buffIdx]->idType,
-            .data_length = message->length,
-#if FEATURE_CAN_HAS_FD
-            .fd_enable = s_hwObjConfigs[index][buffIdx]->enableFD,
-            .fd_padding = s_hwObjConfigs[index][buffIdx]->fdPadding,
-            .enable_brs = s_hwObjConfigs[index][buffIdx]->enableBRS,
-#endif
-            .is_remote = s_hwObjConfigs[index][buffIdx]->isRemote
-        };
+        /* Copy of the data info prebuilt at buffer configuration, a preempting
+         * send on the same buffer must not change the length of this one */
+        flexcan_data_info_t dataInfo = s_hwObjDataInfo[index][buffIdx];
+        dataInfo.data_length = message->length;
 
         /* Compute virtual buffer index */
-        if (s_flexcanRxFifoState[index].rxFifoEn)
-        {
-            buffIdx += CAN_GetVirtualBuffIdx(s_flexcanRxFifoState[index].numIdFilters);
-        }
+        buffIdx += s_flexcanRxFifoState[index].virtBuffOffset;
 
         status = FLEXCAN_DRV_Send((uint8_t) instance->instIdx,
                                   (uint8_t) buffIdx,
@@ -729,6 +720,59 @@ status_t CAN_Send(const can_instance_t * const instance,
     return status;
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CAN_SendFast
+ * Description   : Sends a CAN frame using the specified buffer, without
+ *                 validating the instance and buffer again.
+ *
+ *END**************************************************************************/
+status_t CAN_SendFast(const can_instance_t * const instance,
+                      uint32_t buffIdx,
+                      const can_message_t *message)
+{
+    status_t status = STATUS_ERROR;
+
+    /* Define CAN PAL over FLEXCAN */
+    #if defined(CAN_OVER_FLEXCAN)
+    uint8_t index = s_flexcanStateIndex[instance->instIdx];
+    flexcan_data_info_t dataInfo = s_hwObjDataInfo[index][buffIdx];
+
+    dataInfo.data_length = message->length;
+
+    status = FLEXCAN_DRV_Send((uint8_t) instance->instIdx,
+                              (uint8_t) (buffIdx + s_flexcanRxFifoState[index].virtBuffOffset),
+                              &dataInfo,
+                              message->id,
+                              message->data);
+    #endif
+
+    return status;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CAN_GetHwBuffIdx
+ * Description   : Returns the message buffer of the peripheral behind a
+ *                 buffer index, past the buffers of the Rx FIFO.
+ *
+ *END**************************************************************************/
+uint32_t CAN_GetHwBuffIdx(const can_instance_t * const instance,
+                          uint32_t buffIdx)
+{
+    uint32_t hwBuffIdx = buffIdx;
+
+    /* Define CAN PAL over FLEXCAN */
+    #if defined(CAN_OVER_FLEXCAN)
+    if (instance->instType == CAN_INST_TYPE_FLEXCAN)
+    {
+        hwBuffIdx += s_flexcanRxFifoState[CAN_FindFlexCANState(instance->instIdx)].virtBuffOffset;
+    }
+    #endif
+
+    return hwBuffIdx;
+}
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : CAN_SendBlocking
@@ -761,22 +805,13 @@ status_t CAN_SendBlocking(const can_instance_t * const instance,
         /* Check buffer index to avoid overflow */
         DEV_ASSERT(buffIdx < FEATURE_CAN_MAX_MB_NUM);
 
-        flexcan_data_info_t dataInfo = {
-            .msg_id_type = (flexcan_msgbuff_id_type_t) s_hwObjConfigs[index][buffIdx]->idType,
-            .data_length = message->length,
-#if FEATURE_CAN_HAS_FD
-            .fd_enable = s_hwObjConfigs[index][buffIdx]->enableFD,
-            .fd_padding = s_hwObjConfigs[index][buffIdx]->fdPadding,
-            .enable_brs = s_hwObjConfigs[index][buffIdx]->enableBRS,
-#endif
-            .is_remote = s_hwObjConfigs[index][buffIdx]->isRemote
-        };
+        /* Copy of the data info prebuilt at buffer configuration, a preempting
+         * send on the same buffer must not change the length of this one */
+        flexcan_data_info_t dataInfo = s_hwObjDataInfo[index][buffIdx];
+        dataInfo.data_length = message->length;
 
         /* Compute virtual buffer index */
-        if (s_flexcanRxFifoState[index].rxFifoEn)
-        {
-            buffIdx += CAN_GetVirtualBuffIdx(s_flexcanRxFifoState[index].numIdFilters);
-        }
+        buffIdx += s_flexcanRxFifoState[index].virtBuffOffset;
 
         status = FLEXCAN_DRV_SendBlocking((uint8_t) instance->instIdx,
                                           (uint8_t) buffIdx,
@@ -826,10 +861,7 @@ status_t CAN_Receive(const can_instance_t * const instance,
         else
         {
             /* Compute virtual buffer index */
-            if (s_flexcanRxFifoState[index].rxFifoEn)
-            {
-                buffIdx += CAN_GetVirtualBuffIdx(s_flexcanRxFifoState[index].numIdFilters);
-            }
+            buffIdx += s_flexcanRxFifoState[index].virtBuffOffset;
 
             status = FLEXCAN_DRV_Receive((uint8_t) instance->instIdx,
                                          (uint8_t) buffIdx,
@@ -880,10 +912,7 @@ status_t CAN_ReceiveBlocking(const can_instance_t * const instance,
         else
         {
             /* Compute virtual buffer index */
-            if (s_flexcanRxFifoState[index].rxFifoEn)
-            {
-                buffIdx += CAN_GetVirtualBuffIdx(s_flexcanRxFifoState[index].numIdFilters);
-            }
+            buffIdx += s_flexcanRxFifoState[index].virtBuffOffset;
 
             status = FLEXCAN_DRV_ReceiveBlocking((uint8_t) instance->instIdx,
                                                  (uint8_t) buffIdx,
@@ -922,10 +951,7 @@ status_t CAN_AbortTransfer(const can_instance_t * const instance,
        index = CAN_FindFlexCANState(instance->instIdx);
 
        /* Compute virtual buffer index */
-       if (s_flexcanRxFifoState[index].rxFifoEn)
-       {
-           buffIdx += CAN_GetVirtualBuffIdx(s_flexcanRxFifoState[index].numIdFilters);
-       }
+       buffIdx += s_flexcanRxFifoState[index].virtBuffOffset;
 
         status = FLEXCAN_DRV_AbortTransfer((uint8_t) instance->instIdx,
                                             (uint8_t)buffIdx);
@@ -1004,9 +1030,9 @@ status_t CAN_GetTransferStatus(const can_instance_t * const instance,
         index = CAN_FindFlexCANState(instance->instIdx);
 
         /* Compute virtual buffer index */
-        if ((s_flexcanRxFifoState[index].rxFifoEn) && (buffIdx != 0U))
+        if (buffIdx != 0U)
         {
-            buffIdx += CAN_GetVirtualBuffIdx(s_flexcanRxFifoState[index].numIdFilters);
+            buffIdx += s_flexcanRxFifoState[index].virtBuffOffset;
         }
 
         status = FLEXCAN_DRV_GetTransferStatus((uint8_t) instance->instIdx,
@@ -11,6 +11,7 @@
  *-----------------------------------------------------------------------------
  */
 #include "adc_app.h"
+#include "interrupt_manager.h"
 
 /* Flag used to store if an ADC PAL conversion group has finished executing */
 volatile boolean groupConvDone = false;
@@ -22,6 +23,97 @@ uint8 selectedGroupIndex = 0u;
 /* Variable to store value from ADC conversion */
 volatile uint16 adcRawValue;
 
+/* Low pass after the CIC (windowed sinc, fc = 0.2 fs), Q15, DC gain ~1 */
+static const sint16 s_adcFirTaps[8] =
+{
+    -236, 0, 4426, 12193, 12193, 4426, 0, -236
+};
+
+static AdcFilter_ConfigType s_adcFilterCfg =
+{
+    .cicOrder     = ADC_FILTER_CIC_ORDER,
+    .cicLog2Decim = ADC_FILTER_CIC_LOG2_DECIM,
+    .stageKind    = ADC_FILTER_STAGE_FIR,
+    .coeffs       = s_adcFirTaps,
+    .numTaps      = 8u,
+};
+
+static AdcFilter_StateType s_adcFilter;
+/* Next result of group 0 not fed to the filter yet */
+static uint16 s_adcFilterOffset = 0u;
+
+#if ADC_SCHED_ENABLED
+static AdcSched_ScheduleType s_adcSchedule;
+#endif
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Set up the oversampling pipeline of group 0, before it is started.
+ *
+ * @param inputBits ADC resolution
+ *-----------------------------------------------------------------------------
+ */
+void AdcApp_FilterInit(uint8 inputBits)
+{
+    s_adcFilterCfg.inputBits = inputBits;
+    AdcFilter_Init(&s_adcFilter, &s_adcFilterCfg);
+    s_adcFilterOffset = 0u;
+}
+
+#if ADC_SCHED_ENABLED
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Let PDB0 pace the conversions of g_AdcSchedCfg instead of the PAL
+ *        group, after AdcApp_FilterInit.
+ *
+ * No group notification runs then: vAdcApp reads the latest sample of
+ * ADC_APP_SCHED_SUPPLY_REQ with AdcSched_Read.
+ *-----------------------------------------------------------------------------
+ */
+void AdcApp_SchedStart(void)
+{
+    AdcSched_ReportType report;
+    uint32_t coreFreq = 0u;
+
+    DEV_ASSERT(g_AdcSchedCfg.reqs[ADC_APP_SCHED_SUPPLY_REQ].channel == (adc_inputchannel_t)ADC_CHN);
+
+    (void)CLOCK_SYS_GetFreq(CORE_CLOCK, &coreFreq);
+    (void)AdcSched_Compile(&g_AdcSchedCfg, coreFreq, &s_adcSchedule, &report);
+    DEV_ASSERT(report.result == ADC_SCHED_OK);
+    AdcSched_Apply(ADC_INSTANCE, &s_adcSchedule);
+}
+#endif
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Switch the running conversions to another group, e.g. a faster
+ *        one while a fault is present.
+ *
+ * Only the ADC channels and PDB settings that differ are rewritten, see
+ * ADC_SwitchGroup.
+ *
+ * @param groupIdx Group of adc_pal1_GroupArray0
+ * @return STATUS_SUCCESS, STATUS_TIMEOUT if the running conversion did not end
+ *-----------------------------------------------------------------------------
+ */
+status_t AdcApp_SelectGroup(uint8 groupIdx)
+{
+    status_t status;
+
+    /* No notification of the old group may run once the offset is reset,
+     * ADC_SwitchGroup enables the interrupt again */
+    INT_SYS_DisableIRQ(ADC_DRV_GetInterruptNumber(ADC_INSTANCE));
+    s_adcFilterOffset = 0u;
+
+    status = ADC_SwitchGroup(&adc_pal1_instance, groupIdx, 1u /* millisecond */);
+    if (status == STATUS_SUCCESS)
+    {
+        selectedGroupIndex = groupIdx;
+    }
+
+    return status;
+}
+
 /**
  *-----------------------------------------------------------------------------
  * @brief 
@@ -33,8 +125,28 @@ volatile uint16 adcRawValue;
 void adc_pal1_callback00(const adc_callback_info_t * const callbackInfo, 
                         void * userData)
 {
+    const adc_group_config_t *groupCfg = &adc_pal1_InitConfig0.groupConfigArray[0];
+    uint16 bufferLength = (uint16)(groupCfg->numChannels * groupCfg->numSetsResultBuffer);
+    uint16 tail = callbackInfo->resultBufferTail;
+
     (void) userData;
 
+    /* Feed every result written since the previous notification, the
+     * result buffer may have wrapped in between */
+    if (tail < s_adcFilterOffset)
+    {
+        (void)AdcFilter_Process(&s_adcFilter, &groupCfg->resultBuffer[s_adcFilterOffset],
+                                (uint32)bufferLength - s_adcFilterOffset);
+        s_adcFilterOffset = 0u;
+    }
+    (void)AdcFilter_Process(&s_adcFilter, &groupCfg->resultBuffer[s_adcFilterOffset],
+                            (uint32)tail + 1u - s_adcFilterOffset);
+    s_adcFilterOffset = (uint16)(tail + 1u);
+    if (s_adcFilterOffset >= bufferLength)
+    {
+        s_adcFilterOffset = 0u;
+    }
+
     groupConvDone = true;
     resultLastOffset = callbackInfo->resultBufferTail;
 }
@@ -58,16 +170,20 @@ void adc_pal1_callback02(const adc_callback_info_t * const callbackInfo, void *
 void vAdcApp (void *pvParameters)
 {
     // status_t status;
-    uint16 resultStartOffset;
-    uint32 sum, avg;
-    float32 avgVolts, lastAvgVolts;
+    AdcUnits_MvType avgMv = 0u, lastAvgMv;
     char msg[255] = { 0, };
     TickType_t xNextWakeTime;
+#if ADC_SCHED_ENABLED
+    uint16 raw;
+#else
+    AdcFilter_StatsType stats;
+#endif
     // size_t heap_msg;
 
     /* Casting pvParameters to void because it is unused */
     (void)pvParameters; 
 
+    (void)BootSeq_Require(BOOT_SEQ_BIT(BOOT_STEP_ADC) | BOOT_SEQ_BIT(BOOT_STEP_UART), portMAX_DELAY);
     xNextWakeTime = xTaskGetTickCount();
     for( ;; )
     {
@@ -76,27 +192,31 @@ void vAdcApp (void *pvParameters)
         indefinitely provided INCLUDE_vTaskSuspend is set to 1 in
         FreeRTOSConfig.h. */
 
-        uint8_t numChans = adc_pal1_InitConfig0.groupConfigArray[selectedGroupIndex].numChannels;
-        resultStartOffset = 0u;
+#if ADC_SCHED_ENABLED
+        /* No group notification with the PDB schedule, poll its latest sample */
+        groupConvDone = AdcSched_Read(ADC_INSTANCE, &s_adcSchedule, ADC_APP_SCHED_SUPPLY_REQ, &raw);
+#endif
         /* Wait for group to finish */
         if(groupConvDone == true)
         {
             /* Stop the extra SW triggered conversion */
             // status = ADC_StopGroupConversion(&adc_pal1_instance, selectedGroupIndex, 1 /* millisecond */);
             // DEV_ASSERT(status == STATUS_SUCCESS);
-            /* Calculate average value of the results in the group of conversions */
-            sum = 0;
-            for(uint8_t idx = resultStartOffset; idx <= resultLastOffset; idx++)
-            {
-                sum += adc_pal1_Results00[idx]; /* Results are directly available in resultBuffer associated with the group at initialization */
-            }
-            DEV_ASSERT((resultLastOffset - resultStartOffset + 1) == numChans);
-            avg = sum / numChans;
-
-            /* Convert avg to volts */
-            avgVolts = ((float) avg / adcMax) * (ADC_VREFH - ADC_VREFL);
+#if ADC_SCHED_ENABLED
+            /* Convert the raw result to millivolts */
+            avgMv = AdcUnits_ToMv(ADC_UNITS_CH_SUPPLY, AdcUnits_RawToQ15(raw, s_adcFilterCfg.inputBits));
+#else
+            /* Mean of the filtered outputs since the last period, the
+             * notification feeds the pipeline from the ADC interrupt */
+            INT_SYS_DisableIRQGlobal();
+            AdcFilter_GetStats(&s_adcFilter, &stats);
+            INT_SYS_EnableIRQGlobal();
+
+            /* Convert the Q15 fraction of full scale to millivolts */
+            avgMv = AdcUnits_ToMv(ADC_UNITS_CH_SUPPLY, stats.mean);
+#endif
             /* Convert avg to string */
-            floatToStr(&avgVolts, msg, 5);
+            milliToStr(avgMv, msg);
 
             /* Send the result to the user via LPUART */
             print(headerStr);
@@ -118,8 +238,8 @@ void vAdcApp (void *pvParameters)
         // heap_msg = xPortGetFreeHeapSize();
         // printf("ADC Free Heap is (bytes) %d \r\n",(int32_t)heap_msg);
         // printf("ADC Free Stack size is (bits) %d \r\n",(int32_t)uxTaskGetStackHighWaterMark(NULL));
-        xQueueReceive( xVolSig, &lastAvgVolts, mainDONT_BLOCK);
-        xQueueSend( xVolSig, &avgVolts, mainDONT_BLOCK );
+        xQueueReceive( xVolSig, &lastAvgMv, mainDONT_BLOCK);
+        xQueueSend( xVolSig, &avgMv, mainDONT_BLOCK );
         vTaskDelayUntil( &xNextWakeTime, TASK_PERIOD_1000_MS );
     }
 }
\ No newline at end of file
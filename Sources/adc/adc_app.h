@@ -25,16 +25,25 @@
 #include "adc_pal1.h"
 #include "clockMan1.h"
 #include "uart_app.h"
+#include "adc_filter.h"
+#include "adc_units.h"
+#include "adc_sched.h"
+#include "boot_seq.h"
 
 /* Macro Define -------------------------------------------------------------*/
 #define ADC_INSTANCE    0UL
 #define ADC_CHN         12U
-#define ADC_VREFH       5.0f
-#define ADC_VREFL       0.0f
 
 #define NUM_CONV_GROUP_ITERATIONS       10UL
 #define DELAY_BETWEEN_SW_TRIG_GROUPS    1500UL /* [milliseconds] */
 
+/* Group 0 oversampling: 3rd order CIC decimating by 16, about 6 more bits */
+#define ADC_FILTER_CIC_ORDER            3U
+#define ADC_FILTER_CIC_LOG2_DECIM       4U
+
+/* ADC_SCHED_ENABLED: requirement of g_AdcSchedCfg read by vAdcApp, on ADC_CHN */
+#define ADC_APP_SCHED_SUPPLY_REQ        0U
+
 
 /* Import Parameters --------------------------------------------------------*/
 extern QueueHandle_t xVolSig;
@@ -43,6 +52,11 @@ extern QueueHandle_t xVolSig;
 extern uint16 adcMax;
 extern uint8 selectedGroupIndex;
 
+extern void AdcApp_FilterInit(uint8 inputBits);
+extern status_t AdcApp_SelectGroup(uint8 groupIdx);
+#if ADC_SCHED_ENABLED
+extern void AdcApp_SchedStart(void);
+#endif
 extern void vAdcApp (void *pvParameters);
 
 
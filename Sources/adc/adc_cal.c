@@ -0,0 +1,219 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file adc_cal.c
+ * @brief ADC calibration persisted in D-Flash, recalibration on temperature
+ *        drift
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * The first boot runs the auto-calibration and saves its results, with the
+ * temperature they were taken at and a CRC-32, in the first D-Flash sector.
+ * Later boots hand the record to ADC_Init, which restores it instead of
+ * calibrating again. The record is only rewritten when the temperature has
+ * moved by ADC_CAL_DRIFT_DEG_C since the calibration.
+ *
+ * Programming the FlexNVM while executing from P-Flash is allowed, so the
+ * FTFC commands run in place. Without D-Flash in the FlexNVM partition
+ * nothing is saved and the ADC calibrates on every boot.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include <stddef.h>
+#include "adc_cal.h"
+#include "string.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define ADC_CAL_MAGIC               (0x41434131UL)  /* "ACA1" */
+#define ADC_CAL_RECORD_SIZE         (32U)           /* Whole phrases */
+
+#define ADC_CAL_FTFC_ERSSCR         (0x09U)
+#define ADC_CAL_FTFC_PGM8           (0x07U)
+#define ADC_CAL_FTFC_DFLASH_BASE    (0x800000UL)    /* FlexNVM in the FTFC address space */
+/* FlexNVM partitions without D-Flash: all of it backs the emulated EEPROM */
+#define ADC_CAL_DEPART_NO_DFLASH_0  (0x4U)
+#define ADC_CAL_DEPART_NO_DFLASH_1  (0x8U)
+#define ADC_CAL_FTFC_ERRORS         (FTFC_FSTAT_ACCERR_MASK | FTFC_FSTAT_FPVIOL_MASK | FTFC_FSTAT_MGSTAT0_MASK)
+
+/* Type Define --------------------------------------------------------------*/
+typedef struct
+{
+    uint32 magic;
+    sint16 tempC;
+    uint16 reserved0;
+    adc_auto_calibration_t cal;
+    uint16 reserved1;
+    uint32 crc;                     /* CRC-32 of the fields above */
+} AdcCal_RecordType;
+
+typedef union
+{
+    AdcCal_RecordType record;
+    uint8 bytes[ADC_CAL_RECORD_SIZE];
+} AdcCal_ImageType;
+
+/* Local Parameters ---------------------------------------------------------*/
+static sint16 s_adcCalTempC = ADC_CAL_TEMP_UNKNOWN;
+
+/* Local Functions ----------------------------------------------------------*/
+static uint32 AdcCal_Crc32(const uint8 *data, uint32 length)
+{
+    static const uint32 nibbleTable[16] =
+    {
+        0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+        0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+        0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+        0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL,
+    };
+    uint32 crc = 0xFFFFFFFFUL;
+    uint32 i;
+
+    for (i = 0u; i < length; i++)
+    {
+        crc ^= data[i];
+        crc = (crc >> 4U) ^ nibbleTable[crc & 0xFU];
+        crc = (crc >> 4U) ^ nibbleTable[crc & 0xFU];
+    }
+
+    return ~crc;
+}
+
+static boolean AdcCal_HasDFlash(void)
+{
+    uint32 depart = (SIM->FCFG1 & SIM_FCFG1_DEPART_MASK) >> SIM_FCFG1_DEPART_SHIFT;
+
+    return ((depart != ADC_CAL_DEPART_NO_DFLASH_0) && (depart != ADC_CAL_DEPART_NO_DFLASH_1)) ? true : false;
+}
+
+/* Launch one FTFC command on the D-Flash and wait for it */
+static status_t AdcCal_FlashCommand(uint8 cmd, uint32 addr, const uint8 *phrase)
+{
+    uint32 ftfcAddr = (addr - FEATURE_FLS_DF_START_ADDRESS) + ADC_CAL_FTFC_DFLASH_BASE;
+    uint8 i;
+
+    while ((FTFC->FSTAT & FTFC_FSTAT_CCIF_MASK) == 0u)
+    {
+        /* Previous command still running */
+    }
+    FTFC->FSTAT = FTFC_FSTAT_ACCERR_MASK | FTFC_FSTAT_FPVIOL_MASK;
+
+    /* FCCOB is big endian within each word: FCCOB0 is FCCOB[3] */
+    FTFC->FCCOB[3] = cmd;
+    FTFC->FCCOB[2] = (uint8)(ftfcAddr >> 16U);
+    FTFC->FCCOB[1] = (uint8)(ftfcAddr >> 8U);
+    FTFC->FCCOB[0] = (uint8)ftfcAddr;
+    if (phrase != NULL)
+    {
+        for (i = 0u; i < FEATURE_FLS_DF_BLOCK_WRITE_UNIT_SIZE; i++)
+        {
+            FTFC->FCCOB[4u + i] = phrase[i];
+        }
+    }
+
+    FTFC->FSTAT = FTFC_FSTAT_CCIF_MASK;
+    while ((FTFC->FSTAT & FTFC_FSTAT_CCIF_MASK) == 0u)
+    {
+        /* Wait for the command to complete */
+    }
+
+    return ((FTFC->FSTAT & ADC_CAL_FTFC_ERRORS) != 0u) ? STATUS_ERROR : STATUS_SUCCESS;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Saved calibration, to pass to ADC_Init through the extension.
+ *
+ * @return The record in D-Flash, NULL if none is valid (first boot)
+ *-----------------------------------------------------------------------------
+ */
+const adc_auto_calibration_t *AdcCal_Load(void)
+{
+    const AdcCal_RecordType *record = (const AdcCal_RecordType *)ADC_CAL_NVM_ADDR;
+
+    if (AdcCal_HasDFlash() == false)
+    {
+        return NULL;
+    }
+
+    if ((record->magic != ADC_CAL_MAGIC) ||
+        (record->crc != AdcCal_Crc32((const uint8 *)record, offsetof(AdcCal_RecordType, crc))))
+    {
+        return NULL;
+    }
+
+    s_adcCalTempC = record->tempC;
+
+    return &record->cal;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Save the current calibration of the ADC in D-Flash.
+ *
+ * Blocks for the sector erase, a few milliseconds.
+ *
+ * @param instance ADC instance
+ * @param tempC Temperature of the calibration, ADC_CAL_TEMP_UNKNOWN if none
+ * @return STATUS_SUCCESS, STATUS_ERROR if the D-Flash could not be written
+ *-----------------------------------------------------------------------------
+ */
+status_t AdcCal_Save(uint32 instance, sint16 tempC)
+{
+    AdcCal_ImageType image;
+    status_t status;
+    uint32 offset;
+
+    if (AdcCal_HasDFlash() == false)
+    {
+        return STATUS_ERROR;
+    }
+
+    memset(&image, 0xFF, sizeof(image));
+    image.record.magic = ADC_CAL_MAGIC;
+    image.record.tempC = tempC;
+    ADC_DRV_GetAutoCalibration(instance, &image.record.cal);
+    image.record.crc = AdcCal_Crc32(image.bytes, offsetof(AdcCal_RecordType, crc));
+
+    status = AdcCal_FlashCommand(ADC_CAL_FTFC_ERSSCR, ADC_CAL_NVM_ADDR, NULL);
+    for (offset = 0u; (status == STATUS_SUCCESS) && (offset < sizeof(image)); offset += FEATURE_FLS_DF_BLOCK_WRITE_UNIT_SIZE)
+    {
+        status = AdcCal_FlashCommand(ADC_CAL_FTFC_PGM8, ADC_CAL_NVM_ADDR + offset, &image.bytes[offset]);
+    }
+
+    if (status == STATUS_SUCCESS)
+    {
+        s_adcCalTempC = tempC;
+    }
+
+    return status;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Recalibrate and save when the temperature drifted.
+ *
+ * Runs the auto-calibration on the ADC, so no conversion group may be
+ * active on it.
+ *
+ * @param instance ADC instance
+ * @param tempC Current temperature
+ * @return true if the ADC has been recalibrated
+ *-----------------------------------------------------------------------------
+ */
+boolean AdcCal_OnTemperature(uint32 instance, sint16 tempC)
+{
+    sint32 drift = (sint32)tempC - s_adcCalTempC;
+
+    if ((s_adcCalTempC != ADC_CAL_TEMP_UNKNOWN) &&
+        (drift < ADC_CAL_DRIFT_DEG_C) && (drift > -ADC_CAL_DRIFT_DEG_C))
+    {
+        return false;
+    }
+
+    ADC_DRV_AutoCalibration(instance);
+    (void)AdcCal_Save(instance, tempC);
+
+    return true;
+}
@@ -0,0 +1,31 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file adc_cal.h
+ * @brief ADC calibration persisted in D-Flash, recalibration on temperature
+ *        drift
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _ADC_CAL_H_
+#define _ADC_CAL_H_
+
+#include "Rte_Type.h"
+#include "Cpu.h"
+
+/* Macro Define -------------------------------------------------------------*/
+/* First D-Flash sector, reserved for the calibration record */
+#define ADC_CAL_NVM_ADDR            (FEATURE_FLS_DF_START_ADDRESS)
+#define ADC_CAL_DRIFT_DEG_C         (15)
+#define ADC_CAL_TEMP_UNKNOWN        (INT16_MIN)
+
+/* Export Parameters --------------------------------------------------------*/
+extern const adc_auto_calibration_t *AdcCal_Load(void);
+extern status_t AdcCal_Save(uint32 instance, sint16 tempC);
+extern boolean AdcCal_OnTemperature(uint32 instance, sint16 tempC);
+
+#endif
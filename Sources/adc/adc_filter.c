@@ -0,0 +1,335 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file adc_filter.c
+ * @brief Fixed-point oversampling pipeline for ADC results: CIC decimation,
+ *        Q15 FIR or biquad stage, min/max/mean/RMS accumulators
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * The CIC runs on modulo 2^32 integers, so the integrator overflow cancels in
+ * the combs as long as inputBits + order * log2(R) <= 32. Its output is scaled
+ * to a Q15 fraction of the ADC full scale; decimating by R with order N gains
+ * up to N * log2(R) / 2 bits of resolution on white noise.
+ *
+ * On the Cortex-M4 the FIR/biquad MACs use SMLAD (two 16x16 products per
+ * instruction) and the results are narrowed with SSAT. Without
+ * __ARM_FEATURE_DSP the same arithmetic is done in plain C, bit exact with
+ * the target, which Tests/adc_filter_test.c checks on the host.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "adc_filter.h"
+#include "device_registers.h"
+#include "devassert.h"
+#include "string.h"
+
+/* Local Functions ----------------------------------------------------------*/
+static inline uint32 AdcFilter_Pack(sint16 lo, sint16 hi)
+{
+    return (uint32)(uint16)lo | ((uint32)(uint16)hi << 16U);
+}
+
+#if defined(__ARM_FEATURE_DSP)
+
+/* acc + x.lo * y.lo + x.hi * y.hi */
+static inline sint32 AdcFilter_Smlad(uint32 x, uint32 y, sint32 acc)
+{
+    sint32 result;
+
+    __asm ("smlad %0, %1, %2, %3" : "=r" (result) : "r" (x), "r" (y), "r" (acc));
+    return result;
+}
+
+static inline sint16 AdcFilter_Sat16(sint32 value)
+{
+    sint32 result;
+
+    __asm ("ssat %0, #16, %1" : "=r" (result) : "r" (value));
+    return (sint16)result;
+}
+
+static inline sint16 AdcFilter_SatAsr15(sint32 acc)
+{
+    sint32 result;
+
+    __asm ("ssat %0, #16, %1, asr #15" : "=r" (result) : "r" (acc));
+    return (sint16)result;
+}
+
+static inline sint16 AdcFilter_SatAsr14(sint32 acc)
+{
+    sint32 result;
+
+    __asm ("ssat %0, #16, %1, asr #14" : "=r" (result) : "r" (acc));
+    return (sint16)result;
+}
+
+#else
+
+static inline sint32 AdcFilter_Smlad(uint32 x, uint32 y, sint32 acc)
+{
+    sint32 lo = (sint32)(sint16)(uint16)x * (sint32)(sint16)(uint16)y;
+    sint32 hi = (sint32)(sint16)(uint16)(x >> 16U) * (sint32)(sint16)(uint16)(y >> 16U);
+
+    /* SMLAD wraps around on overflow */
+    return (sint32)((uint32)acc + (uint32)lo + (uint32)hi);
+}
+
+static inline sint16 AdcFilter_Sat16(sint32 value)
+{
+    if (value > INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    if (value < INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+    return (sint16)value;
+}
+
+static inline sint16 AdcFilter_SatAsr15(sint32 acc)
+{
+    return AdcFilter_Sat16(acc >> 15);
+}
+
+static inline sint16 AdcFilter_SatAsr14(sint32 acc)
+{
+    return AdcFilter_Sat16(acc >> 14);
+}
+
+#endif
+
+static sint16 AdcFilter_Fir(AdcFilter_StateType *state, sint16 x)
+{
+    const sint16 *coeffs = state->cfg->coeffs;
+    uint8 numTaps = state->cfg->numTaps;
+    const sint16 *window;
+    uint32 xPair, cPair;
+    sint32 acc = 0;
+    uint8 k;
+
+    /* Newest sample first, written twice so the window is contiguous */
+    state->histIdx = (state->histIdx == 0u) ? (uint8)(numTaps - 1u) : (uint8)(state->histIdx - 1u);
+    state->hist[state->histIdx] = x;
+    state->hist[state->histIdx + numTaps] = x;
+    window = &state->hist[state->histIdx];
+
+    for (k = 0u; k < numTaps; k += 2u)
+    {
+        /* Unaligned word loads are fine on the M4, memcpy compiles to LDR */
+        memcpy(&xPair, &window[k], sizeof(xPair));
+        memcpy(&cPair, &coeffs[k], sizeof(cPair));
+        acc = AdcFilter_Smlad(xPair, cPair, acc);
+    }
+
+    return AdcFilter_SatAsr15(acc);
+}
+
+static sint16 AdcFilter_Biquad(AdcFilter_StateType *state, sint16 x)
+{
+    sint16 *s = state->biquadState;
+    sint32 acc;
+    sint16 y;
+
+    acc = AdcFilter_Smlad(AdcFilter_Pack(x, s[0]), state->biquadPairs[0], 0);
+    acc = AdcFilter_Smlad(AdcFilter_Pack(s[1], s[2]), state->biquadPairs[1], acc);
+    acc = AdcFilter_Smlad(AdcFilter_Pack(s[3], 0), state->biquadPairs[2], acc);
+    y = AdcFilter_SatAsr14(acc);
+
+    s[1] = s[0];
+    s[0] = x;
+    s[3] = s[2];
+    s[2] = y;
+
+    return y;
+}
+
+static uint32 AdcFilter_Isqrt(uint32 value)
+{
+    uint32 root = 0u;
+    uint32 bit = 1UL << 30U;
+
+    while (bit > value)
+    {
+        bit >>= 2U;
+    }
+
+    while (bit != 0u)
+    {
+        if (value >= (root + bit))
+        {
+            value -= root + bit;
+            root = (root >> 1U) + bit;
+        }
+        else
+        {
+            root >>= 1U;
+        }
+        bit >>= 2U;
+    }
+
+    return root;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Reset the pipeline state for the given configuration.
+ *
+ * @param state Pipeline state
+ * @param cfg Configuration, must stay valid while the state is used
+ *-----------------------------------------------------------------------------
+ */
+void AdcFilter_Init(AdcFilter_StateType *state, const AdcFilter_ConfigType *cfg)
+{
+    uint32 bits = (uint32)cfg->inputBits + ((uint32)cfg->cicOrder * cfg->cicLog2Decim);
+
+    DEV_ASSERT((cfg->cicOrder > 0u) && (cfg->cicOrder <= ADC_FILTER_CIC_MAX_ORDER));
+    DEV_ASSERT((bits >= 15u) && (bits <= 32u));
+
+    memset(state, 0, sizeof(*state));
+    state->cfg = cfg;
+    state->cicShift = (uint8)(bits - 15u);
+    state->min = INT16_MAX;
+    state->max = INT16_MIN;
+
+    if (cfg->stageKind == ADC_FILTER_STAGE_FIR)
+    {
+        DEV_ASSERT((cfg->numTaps > 0u) && (cfg->numTaps <= ADC_FILTER_FIR_MAX_TAPS) && ((cfg->numTaps & 1u) == 0u));
+    }
+    else if (cfg->stageKind == ADC_FILTER_STAGE_BIQUAD)
+    {
+        const sint16 *c = cfg->coeffs;
+
+        DEV_ASSERT((c[3] != INT16_MIN) && (c[4] != INT16_MIN));
+        state->biquadPairs[0] = AdcFilter_Pack(c[0], c[1]);
+        state->biquadPairs[1] = AdcFilter_Pack(c[2], (sint16)-c[3]);
+        state->biquadPairs[2] = AdcFilter_Pack((sint16)-c[4], 0);
+    }
+    else
+    {
+        /* CIC only */
+    }
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Feed a block of raw ADC results through the pipeline.
+ *
+ * Can be called from the ADC PAL notification with the new part of the
+ * result buffer. The latest output is kept in state->last.
+ *
+ * @param state Pipeline state
+ * @param samples Right aligned ADC results
+ * @param numSamples Number of results in samples
+ * @return Number of decimated outputs produced
+ *-----------------------------------------------------------------------------
+ */
+uint32 AdcFilter_Process(AdcFilter_StateType *state, const uint16 *samples, uint32 numSamples)
+{
+    const AdcFilter_ConfigType *cfg = state->cfg;
+    const uint16 decim = (uint16)(1U << cfg->cicLog2Decim);
+    uint32 numOut = 0u;
+    uint32 i;
+    uint8 o;
+
+    for (i = 0u; i < numSamples; i++)
+    {
+        uint32 v = samples[i];
+        sint16 y;
+
+        for (o = 0u; o < cfg->cicOrder; o++)
+        {
+            state->integ[o] += v;
+            v = state->integ[o];
+        }
+
+        state->cicPhase++;
+        if (state->cicPhase < decim)
+        {
+            continue;
+        }
+        state->cicPhase = 0u;
+
+        for (o = 0u; o < cfg->cicOrder; o++)
+        {
+            uint32 diff = v - state->combDelay[o];
+
+            state->combDelay[o] = v;
+            v = diff;
+        }
+        y = AdcFilter_Sat16((sint32)(v >> state->cicShift));
+
+        if (cfg->stageKind == ADC_FILTER_STAGE_FIR)
+        {
+            y = AdcFilter_Fir(state, y);
+        }
+        else if (cfg->stageKind == ADC_FILTER_STAGE_BIQUAD)
+        {
+            y = AdcFilter_Biquad(state, y);
+        }
+        else
+        {
+            /* CIC only */
+        }
+
+        if (y < state->min)
+        {
+            state->min = y;
+        }
+        if (y > state->max)
+        {
+            state->max = y;
+        }
+        state->sum += y;
+        state->sumSq += (uint64_t)((sint32)y * y);
+        state->count++;
+
+        state->last = y;
+        numOut++;
+    }
+
+    return numOut;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Read and restart the accumulators.
+ *
+ * Must not run concurrently with AdcFilter_Process on the same state.
+ *
+ * @param state Pipeline state
+ * @param stats Outputs since the previous call, zero if there was none
+ *-----------------------------------------------------------------------------
+ */
+void AdcFilter_GetStats(AdcFilter_StateType *state, AdcFilter_StatsType *stats)
+{
+    uint32 rms;
+
+    stats->count = state->count;
+
+    if (state->count == 0u)
+    {
+        stats->min = 0;
+        stats->max = 0;
+        stats->mean = 0;
+        stats->rms = 0;
+        return;
+    }
+
+    stats->min = state->min;
+    stats->max = state->max;
+    stats->mean = (sint16)(state->sum / (int64_t)state->count);
+    /* Mean square is at most 2^30 */
+    rms = AdcFilter_Isqrt((uint32)(state->sumSq / state->count));
+    stats->rms = (rms > (uint32)INT16_MAX) ? INT16_MAX : (sint16)rms;
+
+    state->count = 0u;
+    state->min = INT16_MAX;
+    state->max = INT16_MIN;
+    state->sum = 0;
+    state->sumSq = 0u;
+}
@@ -0,0 +1,82 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file adc_filter.h
+ * @brief Fixed-point oversampling pipeline for ADC results: CIC decimation,
+ *        Q15 FIR or biquad stage, min/max/mean/RMS accumulators
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _ADC_FILTER_H_
+#define _ADC_FILTER_H_
+
+#include <stdint.h>
+#include "Rte_Type.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define ADC_FILTER_CIC_MAX_ORDER    (4U)
+#define ADC_FILTER_FIR_MAX_TAPS     (16U)   /* Even number of taps only */
+
+/* Biquad coefficients b0 b1 b2 a1 a2 are Q14 so that |a1| may reach 2 */
+#define ADC_FILTER_BIQUAD_SHIFT     (14U)
+#define ADC_FILTER_BIQUAD_COEFFS    (5U)
+
+/* Type Define --------------------------------------------------------------*/
+typedef enum
+{
+    ADC_FILTER_STAGE_NONE = 0,
+    ADC_FILTER_STAGE_FIR,
+    ADC_FILTER_STAGE_BIQUAD
+} AdcFilter_StageKindType;
+
+typedef struct
+{
+    uint8 inputBits;                /* ADC resolution */
+    uint8 cicOrder;                 /* 1..ADC_FILTER_CIC_MAX_ORDER */
+    uint8 cicLog2Decim;             /* Decimation ratio R = 2^cicLog2Decim */
+    AdcFilter_StageKindType stageKind;
+    const sint16 *coeffs;           /* FIR taps (Q15) or b0 b1 b2 a1 a2 (Q14) */
+    uint8 numTaps;                  /* FIR only */
+} AdcFilter_ConfigType;
+
+/* Values are Q15 fractions of the ADC full scale */
+typedef struct
+{
+    uint32 count;
+    sint16 min;
+    sint16 max;
+    sint16 mean;
+    sint16 rms;
+} AdcFilter_StatsType;
+
+typedef struct
+{
+    const AdcFilter_ConfigType *cfg;
+    uint8 cicShift;
+    uint16 cicPhase;
+    uint32 integ[ADC_FILTER_CIC_MAX_ORDER];
+    uint32 combDelay[ADC_FILTER_CIC_MAX_ORDER];
+    /* Doubled history so that the FIR window never wraps */
+    sint16 hist[2U * ADC_FILTER_FIR_MAX_TAPS];
+    uint8 histIdx;
+    sint16 biquadState[4];          /* x[n-1] x[n-2] y[n-1] y[n-2] */
+    uint32 biquadPairs[3];          /* (b0,b1) (b2,-a1) (-a2,0) packed for SMLAD */
+    sint16 last;
+    /* Accumulators of AdcFilter_GetStats */
+    uint32 count;
+    sint16 min;
+    sint16 max;
+    int64_t sum;
+    uint64_t sumSq;
+} AdcFilter_StateType;
+
+/* Export Parameters --------------------------------------------------------*/
+extern void AdcFilter_Init(AdcFilter_StateType *state, const AdcFilter_ConfigType *cfg);
+extern uint32 AdcFilter_Process(AdcFilter_StateType *state, const uint16 *samples, uint32 numSamples);
+extern void AdcFilter_GetStats(AdcFilter_StateType *state, AdcFilter_StatsType *stats);
+
+#endif
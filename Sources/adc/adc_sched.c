@@ -0,0 +1,354 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file adc_sched.c
+ * @brief Compile (channel, period, phase) sampling requirements into PDB
+ *        pre-trigger delays and TRGMUX routes
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * The frame is the LCM of all periods. Every occurrence phase + k * period
+ * inside the frame gets its own PDB pre-trigger and ADC SC1[n] register,
+ * sorted by time: CH0 pre-triggers 0..7 start SC1[0..7], CH1 pre-triggers
+ * 0..7 start SC1[8..15]. Once applied the conversions are started by the
+ * PDB counter alone, so the sampling instants have no CPU jitter at all.
+ *
+ * Conflicts are reported instead of silently shifted: two conversions
+ * closer than convTimeUs (also across the frame wrap in continuous mode),
+ * more occurrences than pre-triggers, or a frame the 16 bit PDB counter
+ * cannot cover with any prescaler.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include <stdint.h>
+#include "adc_sched.h"
+#include "string.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define ADC_SCHED_PDB_MAX_TICKS     (PDB_MOD_MOD_MASK + 1UL)
+#define ADC_SCHED_US_PER_S          (1000000ULL)
+
+/* Local Parameters ---------------------------------------------------------*/
+static const uint8 s_adcSchedMult[] = { 1u, 10u, 20u, 40u };
+
+static const trgmux_target_module_t s_adcSchedPdbTarget[PDB_INSTANCE_COUNT] =
+{
+    TRGMUX_TARGET_MODULE_PDB0_TRG_IN,
+    TRGMUX_TARGET_MODULE_PDB1_TRG_IN,
+};
+
+/* Local Functions ----------------------------------------------------------*/
+static uint32 AdcSched_Gcd(uint32 a, uint32 b)
+{
+    while (b != 0u)
+    {
+        uint32 r = a % b;
+
+        a = b;
+        b = r;
+    }
+
+    return a;
+}
+
+static uint32 AdcSched_UsToTicks(uint32 us, uint32 clockHz, uint32 div)
+{
+    return (uint32)(((uint64_t)us * clockHz) / (ADC_SCHED_US_PER_S * div));
+}
+
+static void AdcSched_Report(AdcSched_ReportType *report, AdcSched_ResultType result,
+                            uint8 reqA, uint8 reqB, uint32 timeUs)
+{
+    report->result = result;
+    report->reqA = reqA;
+    report->reqB = reqB;
+    report->timeUs = timeUs;
+}
+
+/* Smallest prescaler (finest resolution) whose counter covers the frame */
+static boolean AdcSched_SelectPrescaler(uint32 frameUs, uint32 clockHz, AdcSched_ScheduleType *sched)
+{
+    uint32 bestDiv = UINT32_MAX;
+    uint8 p, m;
+
+    for (m = 0u; m < (uint8)(sizeof(s_adcSchedMult) / sizeof(s_adcSchedMult[0])); m++)
+    {
+        for (p = 0u; p <= (uint8)PDB_CLK_PREDIV_BY_128; p++)
+        {
+            uint32 div = (1UL << p) * s_adcSchedMult[m];
+            uint64_t ticks = ((uint64_t)frameUs * clockHz) / (ADC_SCHED_US_PER_S * div);
+
+            if ((ticks <= ADC_SCHED_PDB_MAX_TICKS) && (ticks > 0u) && (div < bestDiv))
+            {
+                bestDiv = div;
+                sched->preDiv = (pdb_clk_prescaler_div_t)p;
+                sched->preMult = (pdb_clk_prescaler_mult_factor_t)m;
+                sched->modulus = (uint16)(ticks - 1u);
+            }
+        }
+    }
+
+    return (bestDiv != UINT32_MAX) ? true : false;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Compile the sampling requirements into a PDB schedule.
+ *
+ * @param cfg Requirements, must stay valid while the schedule is used
+ * @param pdbClockHz PDB input clock (core clock)
+ * @param sched Compiled schedule, valid only if ADC_SCHED_OK is returned
+ * @param report First conflict found, requirement indexes and frame time
+ * @return ADC_SCHED_OK or the kind of conflict
+ *-----------------------------------------------------------------------------
+ */
+AdcSched_ResultType AdcSched_Compile(const AdcSched_CfgType *cfg, uint32 pdbClockHz,
+                                     AdcSched_ScheduleType *sched, AdcSched_ReportType *report)
+{
+    uint32 slotUs[ADC_SCHED_MAX_SLOTS];
+    uint64_t frameUs = 1u;
+    uint32 numSlots = 0u;
+    uint32 div, i, j;
+    uint8 r;
+
+    DEV_ASSERT((cfg->numReqs > 0u) && (cfg->numReqs <= ADC_SCHED_MAX_REQS));
+
+    memset(sched, 0, sizeof(*sched));
+    sched->cfg = cfg;
+    AdcSched_Report(report, ADC_SCHED_OK, 0u, 0u, 0u);
+
+    for (r = 0u; r < cfg->numReqs; r++)
+    {
+        const AdcSched_ReqType *req = &cfg->reqs[r];
+
+        if ((req->periodUs == 0u) || (req->phaseUs >= req->periodUs))
+        {
+            AdcSched_Report(report, ADC_SCHED_E_PHASE, r, r, req->phaseUs);
+            return report->result;
+        }
+
+        frameUs = (frameUs / AdcSched_Gcd((uint32)frameUs, req->periodUs)) * req->periodUs;
+        if (frameUs > UINT32_MAX)
+        {
+            AdcSched_Report(report, ADC_SCHED_E_FRAME, r, r, 0u);
+            return report->result;
+        }
+    }
+    sched->frameUs = (uint32)frameUs;
+
+    if (AdcSched_SelectPrescaler(sched->frameUs, pdbClockHz, sched) == false)
+    {
+        AdcSched_Report(report, ADC_SCHED_E_FRAME, 0u, 0u, sched->frameUs);
+        return report->result;
+    }
+    div = (1UL << (uint32)sched->preDiv) * s_adcSchedMult[sched->preMult];
+
+    /* Round the conversion time up to whole ticks */
+    sched->convTicks = (uint16)(((uint64_t)cfg->convTimeUs * pdbClockHz + (ADC_SCHED_US_PER_S * div) - 1u)
+                                / (ADC_SCHED_US_PER_S * div));
+    if (sched->convTicks == 0u)
+    {
+        sched->convTicks = 1u;
+    }
+
+    /* Expand the occurrences, insertion sorted by time */
+    for (r = 0u; r < cfg->numReqs; r++)
+    {
+        const AdcSched_ReqType *req = &cfg->reqs[r];
+        uint32 t;
+
+        for (t = req->phaseUs; t < sched->frameUs; t += req->periodUs)
+        {
+            if (numSlots == ADC_SCHED_MAX_SLOTS)
+            {
+                AdcSched_Report(report, ADC_SCHED_E_SLOTS, r, r, t);
+                return report->result;
+            }
+
+            for (j = numSlots; (j > 0u) && (slotUs[j - 1u] > t); j--)
+            {
+                slotUs[j] = slotUs[j - 1u];
+                sched->slots[j] = sched->slots[j - 1u];
+            }
+            slotUs[j] = t;
+            sched->slots[j].reqIdx = r;
+            numSlots++;
+        }
+    }
+    sched->numSlots = (uint8)numSlots;
+
+    for (i = 0u; i < numSlots; i++)
+    {
+        uint32 ticks = AdcSched_UsToTicks(slotUs[i], pdbClockHz, div);
+
+        /* A zero delay never fires, the first sample moves by one tick */
+        sched->slots[i].delay = (uint16)((ticks == 0u) ? 1u : ticks);
+
+        if ((i > 0u) && ((uint32)sched->slots[i].delay < ((uint32)sched->slots[i - 1u].delay + sched->convTicks)))
+        {
+            AdcSched_Report(report, ADC_SCHED_E_OVERLAP, sched->slots[i - 1u].reqIdx,
+                            sched->slots[i].reqIdx, slotUs[i]);
+            return report->result;
+        }
+    }
+
+    /* The last conversion must end before the counter restarts the frame */
+    if (((uint32)sched->slots[numSlots - 1u].delay + sched->convTicks) > ((uint32)sched->modulus + 1u))
+    {
+        AdcSched_Report(report, ADC_SCHED_E_OVERLAP, sched->slots[numSlots - 1u].reqIdx,
+                        sched->slots[0].reqIdx, 0u);
+        return report->result;
+    }
+    if ((cfg->trigSource == TRGMUX_TRIG_SOURCE_DISABLED) &&
+        ((((uint32)sched->modulus + 1u) - sched->slots[numSlots - 1u].delay + sched->slots[0].delay) < sched->convTicks))
+    {
+        AdcSched_Report(report, ADC_SCHED_E_OVERLAP, sched->slots[numSlots - 1u].reqIdx,
+                        sched->slots[0].reqIdx, 0u);
+        return report->result;
+    }
+
+    return ADC_SCHED_OK;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Program the ADC channels, the PDB and the TRGMUX route and start.
+ *
+ * Takes over the ADC and the PDB of the instance, the ADC PAL groups must
+ * not be started on it. The ADC must be initialized (ADC_Init) before.
+ *
+ * @param instance ADC and PDB instance
+ * @param sched Schedule compiled without conflict
+ *-----------------------------------------------------------------------------
+ */
+void AdcSched_Apply(uint32 instance, const AdcSched_ScheduleType *sched)
+{
+    const AdcSched_CfgType *cfg = sched->cfg;
+    adc_converter_config_t adcConfig;
+    pdb_timer_config_t pdbConfig;
+    pdb_adc_pretrigger_config_t preConfig;
+    adc_chan_config_t chanConfig;
+    uint32 ch, pre;
+    uint8 i;
+
+    DEV_ASSERT(instance < PDB_INSTANCE_COUNT);
+    DEV_ASSERT((sched->numSlots > 0u) && (sched->numSlots <= ADC_SCHED_MAX_SLOTS));
+
+    ADC_DRV_GetConverterConfig(instance, &adcConfig);
+    adcConfig.trigger = ADC_TRIGGER_HARDWARE;
+    adcConfig.pretriggerSel = ADC_PRETRIGGER_SEL_PDB;
+    adcConfig.triggerSel = ADC_TRIGGER_SEL_PDB;
+    ADC_DRV_ConfigConverter(instance, &adcConfig);
+
+    chanConfig.interruptEnable = false;
+    for (i = 0u; i < sched->numSlots; i++)
+    {
+        chanConfig.channel = cfg->reqs[sched->slots[i].reqIdx].channel;
+        ADC_DRV_ConfigChan(instance, i, &chanConfig);
+    }
+
+    PDB_DRV_GetDefaultConfig(&pdbConfig);
+    pdbConfig.loadValueMode = PDB_LOAD_VAL_IMMEDIATELY;
+    pdbConfig.clkPreDiv = sched->preDiv;
+    pdbConfig.clkPreMultFactor = sched->preMult;
+    pdbConfig.triggerInput = (cfg->trigSource == TRGMUX_TRIG_SOURCE_DISABLED) ? PDB_SOFTWARE_TRIGGER : PDB_TRIGGER_IN0;
+    pdbConfig.continuousModeEnable = (cfg->trigSource == TRGMUX_TRIG_SOURCE_DISABLED) ? true : false;
+    PDB_DRV_Init(instance, &pdbConfig);
+    PDB_DRV_SetTimerModulusValue(instance, sched->modulus);
+
+    preConfig.preTriggerBackToBackEnable = false;
+    for (ch = 0u; ch < PDB_CH_COUNT; ch++)
+    {
+        for (pre = 0u; pre < PDB_DLY_COUNT; pre++)
+        {
+            uint32 slot = (ch * PDB_DLY_COUNT) + pre;
+            boolean used = (slot < sched->numSlots) ? true : false;
+
+            preConfig.adcPreTriggerIdx = pre;
+            preConfig.preTriggerEnable = used;
+            preConfig.preTriggerOutputEnable = used;
+            PDB_DRV_ConfigAdcPreTrigger(instance, ch, &preConfig);
+            if (used)
+            {
+                PDB_DRV_SetAdcPreTriggerDelayValue(instance, ch, pre, sched->slots[slot].delay);
+            }
+        }
+    }
+
+    PDB_DRV_Enable(instance);
+    PDB_DRV_LoadValuesCmd(instance);
+
+    if (cfg->trigSource == TRGMUX_TRIG_SOURCE_DISABLED)
+    {
+        PDB_DRV_SoftTriggerCmd(instance);
+    }
+    else
+    {
+        status_t status = TRGMUX_DRV_SetTrigSourceForTargetModule(0u, cfg->trigSource,
+                                                                  s_adcSchedPdbTarget[instance]);
+        DEV_ASSERT(status == STATUS_SUCCESS);
+        (void)status;
+    }
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Stop the schedule, the ADC keeps its last results.
+ *
+ * @param instance ADC and PDB instance
+ *-----------------------------------------------------------------------------
+ */
+void AdcSched_Stop(uint32 instance)
+{
+    DEV_ASSERT(instance < PDB_INSTANCE_COUNT);
+
+    PDB_DRV_Deinit(instance);
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Latest completed sample of a requirement.
+ *
+ * Picks the slot of the requirement whose conversion ended last according
+ * to the PDB counter, so no interrupt is needed to track the results.
+ *
+ * @param instance ADC and PDB instance
+ * @param sched Applied schedule
+ * @param reqIdx Index in cfg->reqs
+ * @param raw Result of the slot
+ * @return true if the requirement has a slot
+ *-----------------------------------------------------------------------------
+ */
+boolean AdcSched_Read(uint32 instance, const AdcSched_ScheduleType *sched, uint8 reqIdx, uint16 *raw)
+{
+    uint32 now = PDB_DRV_GetTimerValue(instance);
+    uint8 lastDone = ADC_SCHED_MAX_SLOTS;
+    uint8 lastAny = ADC_SCHED_MAX_SLOTS;
+    uint8 i;
+
+    for (i = 0u; i < sched->numSlots; i++)
+    {
+        if (sched->slots[i].reqIdx != reqIdx)
+        {
+            continue;
+        }
+
+        lastAny = i;
+        if (((uint32)sched->slots[i].delay + sched->convTicks) <= now)
+        {
+            lastDone = i;
+        }
+    }
+
+    if (lastAny == ADC_SCHED_MAX_SLOTS)
+    {
+        return false;
+    }
+
+    /* None done yet in this frame: the last one of the previous frame */
+    ADC_DRV_GetChanResult(instance, (lastDone != ADC_SCHED_MAX_SLOTS) ? lastDone : lastAny, raw);
+
+    return true;
+}
@@ -0,0 +1,91 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file adc_sched.h
+ * @brief Compile (channel, period, phase) sampling requirements into PDB
+ *        pre-trigger delays and TRGMUX routes
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _ADC_SCHED_H_
+#define _ADC_SCHED_H_
+
+#include "Rte_Type.h"
+#include "Cpu.h"
+
+/* Macro Define -------------------------------------------------------------*/
+/* Replaces the ADC PAL group conversions on ADC0/PDB0, enable one or the other */
+#define ADC_SCHED_ENABLED           (0U)
+
+#define ADC_SCHED_MAX_REQS          (8U)
+/* One slot per PDB pre-trigger, slot n converts in ADC SC1[n] */
+#define ADC_SCHED_MAX_SLOTS         (PDB_CH_COUNT * PDB_DLY_COUNT)
+
+/* Type Define --------------------------------------------------------------*/
+typedef struct
+{
+    adc_inputchannel_t channel;
+    uint32 periodUs;                /* 1 / rate */
+    uint32 phaseUs;                 /* Offset from the frame start, < periodUs */
+} AdcSched_ReqType;
+
+typedef struct
+{
+    const AdcSched_ReqType *reqs;
+    uint8 numReqs;
+    uint32 convTimeUs;              /* Sample + conversion time, minimum slot spacing */
+    trgmux_trigger_source_t trigSource; /* TRGMUX_TRIG_SOURCE_DISABLED: PDB free runs
+                                           in continuous mode, otherwise each trigger
+                                           starts one frame */
+} AdcSched_CfgType;
+
+typedef enum
+{
+    ADC_SCHED_OK = 0,
+    ADC_SCHED_E_PHASE,              /* reqA: period zero or phase not below it */
+    ADC_SCHED_E_FRAME,              /* Frame (LCM of the periods) too long for PDB */
+    ADC_SCHED_E_SLOTS,              /* More conversions per frame than pre-triggers */
+    ADC_SCHED_E_OVERLAP             /* reqB starts at timeUs while reqA converts */
+} AdcSched_ResultType;
+
+typedef struct
+{
+    AdcSched_ResultType result;
+    uint8 reqA;
+    uint8 reqB;
+    uint32 timeUs;
+} AdcSched_ReportType;
+
+typedef struct
+{
+    uint16 delay;                   /* PDB ticks from the frame start */
+    uint8 reqIdx;
+} AdcSched_SlotType;
+
+typedef struct
+{
+    const AdcSched_CfgType *cfg;
+    pdb_clk_prescaler_div_t preDiv;
+    pdb_clk_prescaler_mult_factor_t preMult;
+    uint16 modulus;
+    uint16 convTicks;
+    uint32 frameUs;
+    uint8 numSlots;
+    AdcSched_SlotType slots[ADC_SCHED_MAX_SLOTS];   /* Sorted by delay */
+} AdcSched_ScheduleType;
+
+/* Import Parameters --------------------------------------------------------*/
+extern const AdcSched_CfgType g_AdcSchedCfg;
+
+/* Export Parameters --------------------------------------------------------*/
+extern AdcSched_ResultType AdcSched_Compile(const AdcSched_CfgType *cfg, uint32 pdbClockHz,
+                                            AdcSched_ScheduleType *sched, AdcSched_ReportType *report);
+extern void AdcSched_Apply(uint32 instance, const AdcSched_ScheduleType *sched);
+extern void AdcSched_Stop(uint32 instance);
+extern boolean AdcSched_Read(uint32 instance, const AdcSched_ScheduleType *sched, uint8 reqIdx, uint16 *raw);
+
+#endif
@@ -0,0 +1,34 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file adc_sched_cfg.c
+ * @brief Sampling requirements of the ADC scheduler
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * 4 ms frame: input 12 at 1 kHz, plus two 250 Hz samples placed between
+ * them, 6 of the 16 pre-triggers used.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "adc_sched.h"
+
+/* Local Parameters ---------------------------------------------------------*/
+static const AdcSched_ReqType s_adcSchedReqs[] =
+{
+    /* channel             periodUs  phaseUs */
+    { ADC_INPUTCHAN_EXT12, 1000U,    0U    },
+    { ADC_INPUTCHAN_EXT12, 4000U,    500U  },
+    { ADC_INPUTCHAN_EXT0,  4000U,    2500U },
+};
+
+/* Export Parameters --------------------------------------------------------*/
+const AdcSched_CfgType g_AdcSchedCfg =
+{
+    .reqs = s_adcSchedReqs,
+    .numReqs = (uint8)(sizeof(s_adcSchedReqs) / sizeof(s_adcSchedReqs[0])),
+    .convTimeUs = 20U,
+    .trigSource = TRGMUX_TRIG_SOURCE_DISABLED,
+};
@@ -0,0 +1,59 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file adc_units.c
+ * @brief Fixed-point engineering units of the ADC channels
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "adc_units.h"
+
+/* Export Parameters --------------------------------------------------------*/
+const AdcUnits_ScaleType g_AdcUnitsScale[ADC_UNITS_NUM_CHANNELS] =
+{
+    ADC_UNITS_SCALE(ADC_VREFH_MV, ADC_VREFL_MV),    /* ADC_UNITS_CH_SUPPLY */
+};
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Convert a fraction of the ADC full scale to millivolts.
+ *
+ * @param channel Entry of g_AdcUnitsScale
+ * @param value Q15 fraction, negative values are clamped to zero scale
+ * @return Rounded millivolts
+ *-----------------------------------------------------------------------------
+ */
+AdcUnits_MvType AdcUnits_ToMv(AdcUnits_ChannelType channel, AdcUnits_Q15Type value)
+{
+    const AdcUnits_ScaleType *scale = &g_AdcUnitsScale[channel];
+    uint32 frac = (value > 0) ? (uint32)value : 0u;
+
+    /* At most 2^15 * VREFH, fits in 32 bits */
+    return (AdcUnits_MvType)(((frac * scale->span) + scale->offset + (ADC_UNITS_Q15_ONE / 2U)) >> 15U);
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Right aligned ADC result to a Q15 fraction of the full scale.
+ *-----------------------------------------------------------------------------
+ */
+AdcUnits_Q15Type AdcUnits_RawToQ15(uint16 raw, uint8 inputBits)
+{
+    return (AdcUnits_Q15Type)((uint32)raw << (15U - inputBits));
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Encode millivolts into the 8 bit voltage signal of the CAN frame.
+ *-----------------------------------------------------------------------------
+ */
+uint8 AdcUnits_MvToCan(AdcUnits_MvType mv)
+{
+    uint32 raw = (uint32)mv / ADC_UNITS_CAN_VOLT_LSB_MV;
+
+    return (raw > 0xFFu) ? 0xFFu : (uint8)raw;
+}
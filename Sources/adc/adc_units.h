@@ -0,0 +1,66 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file adc_units.h
+ * @brief Fixed-point engineering units of the ADC channels
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * Conversion results travel as Q15 fractions of the ADC full scale and are
+ * turned into millivolts with a per channel scale/offset built at compile
+ * time from the reference voltages, so no task touches the FPU.
+ *
+ * Error budget, VREFH - VREFL = 5000 mV:
+ *   Q15 quantization            5000 / 32768   = 0.15 mV
+ *   rounding to 1 mV                           = 0.5 mV
+ *   CAN signal, truncated to ADC_UNITS_CAN_VOLT_LSB_MV
+ *                                              < 20 mV, as the float path
+ *
+ * Tests/adc_units_test.c sweeps every raw code and Q15 value against it.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _ADC_UNITS_H_
+#define _ADC_UNITS_H_
+
+#include "Rte_Type.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define ADC_VREFH_MV                5000U
+#define ADC_VREFL_MV                0U
+
+#define ADC_UNITS_Q15_ONE           32768UL
+
+/* mV = (q15 * span + (VREFL << 15) + 0.5 LSB) >> 15 */
+#define ADC_UNITS_SCALE(vrefhMv, vreflMv)   { (uint32)((vrefhMv) - (vreflMv)), (uint32)(vreflMv) << 15U }
+
+/* Resolution of the voltage signal in the CAN frame */
+#define ADC_UNITS_CAN_VOLT_LSB_MV   20U
+
+/* Type Define --------------------------------------------------------------*/
+typedef uint16 AdcUnits_MvType;     /* Millivolts */
+typedef sint16 AdcUnits_Q15Type;    /* Fraction of the ADC full scale */
+
+typedef enum
+{
+    ADC_UNITS_CH_SUPPLY = 0,        /* ADC0 input 12 */
+    ADC_UNITS_NUM_CHANNELS
+} AdcUnits_ChannelType;
+
+typedef struct
+{
+    uint32 span;                    /* Full scale in mV */
+    uint32 offset;                  /* Zero scale in mV, Q15 */
+} AdcUnits_ScaleType;
+
+/* Import Parameters --------------------------------------------------------*/
+extern const AdcUnits_ScaleType g_AdcUnitsScale[ADC_UNITS_NUM_CHANNELS];
+
+/* Export Parameters --------------------------------------------------------*/
+extern AdcUnits_MvType AdcUnits_ToMv(AdcUnits_ChannelType channel, AdcUnits_Q15Type value);
+extern AdcUnits_Q15Type AdcUnits_RawToQ15(uint16 raw, uint8 inputBits);
+extern uint8 AdcUnits_MvToCan(AdcUnits_MvType mv);
+
+#endif
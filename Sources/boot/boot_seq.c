@@ -0,0 +1,330 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file boot_seq.c
+ * @brief Boot sequencer: init steps in phases, with dependencies and timing
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * The step table (rtos.c) lists every init step with the steps it needs.
+ * Only the EARLY steps, the ones on the path to the first CAN frame, run
+ * before vTaskStartScheduler. vBootSeq brings up the TASK steps at low
+ * priority while the application runs, and a LAZY step only when a task
+ * asks for it. A task calls BootSeq_Require for the steps it uses before
+ * touching their peripherals.
+ *
+ * The early phase runs with the kernel not started and uses no FreeRTOS
+ * object: creating one before the scheduler leaves BASEPRI raised, which
+ * would hold off the driver interrupts of the following steps.
+ *
+ * Times are DWT cycles from BootSeq_Init, the first call of the
+ * application after reset, at the reset core clock.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "boot_seq.h"
+#include "cycle_counter.h"
+#include "uart_app.h"
+#include "helper_functions.h"
+#include "interrupt_manager.h"
+#include "event_groups.h"
+#include "task.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define BOOT_SEQ_MAX_STEPS          (24U)   /* Event group bits, 32-bit ticks */
+
+/* Local Parameters ---------------------------------------------------------*/
+static const BootSeq_StepType *s_bootSeqSteps = NULL;
+static uint8 s_bootSeqCount = 0u;
+
+static volatile uint32 s_bootSeqDone = 0u;
+static volatile uint32 s_bootSeqFailed = 0u;
+static volatile uint32 s_bootSeqRequested = 0u;
+
+static EventGroupHandle_t s_bootSeqEvents = NULL;
+static TaskHandle_t s_bootSeqTask = NULL;
+
+static BootSeq_LogType s_bootSeqLog[BOOT_SEQ_MAX_STEPS];
+static uint32 s_bootSeqMilestoneUs[BOOT_SEQ_MILESTONE_COUNT];   /* 0: not reached */
+
+/* Local Functions ----------------------------------------------------------*/
+static void BootSeq_RunStep(uint8 idx)
+{
+    const BootSeq_StepType *step = &s_bootSeqSteps[idx];
+    BootSeq_LogType *log = &s_bootSeqLog[idx];
+    uint32 start;
+
+    DEV_ASSERT((step->deps & ~s_bootSeqDone) == 0u);
+
+    start = CycleCounter_Get();
+    log->status = step->init();
+    log->startUs = CYCLES_TO_US(start);
+    log->durationUs = CYCLES_TO_US(CycleCounter_Get() - start);
+    log->done = true;
+    DEV_ASSERT(log->status == STATUS_SUCCESS);
+
+    INT_SYS_DisableIRQGlobal();
+    s_bootSeqDone |= BOOT_SEQ_BIT(idx);
+    if (log->status != STATUS_SUCCESS)
+    {
+        s_bootSeqFailed |= BOOT_SEQ_BIT(idx);
+    }
+    INT_SYS_EnableIRQGlobal();
+
+    if (s_bootSeqEvents != NULL)
+    {
+        (void)xEventGroupSetBits(s_bootSeqEvents, (EventBits_t)BOOT_SEQ_BIT(idx));
+    }
+}
+
+#if BOOT_SEQ_PRINT_ENABLED
+static void BootSeq_PrintMs(const char *name, uint32 us, const char *end)
+{
+    char num[16];
+
+    print(name);
+    milliToStr(us, num);
+    print(num);
+    print(end);
+}
+
+static void BootSeq_PrintLog(void)
+{
+    uint8 idx;
+
+    print("\r\nBoot ms: start duration\r\n");
+    for (idx = 0u; idx < s_bootSeqCount; idx++)
+    {
+        if (s_bootSeqLog[idx].done == true)
+        {
+            BootSeq_PrintMs(s_bootSeqSteps[idx].name, s_bootSeqLog[idx].startUs, " ");
+            BootSeq_PrintMs("", s_bootSeqLog[idx].durationUs,
+                            (s_bootSeqLog[idx].status == STATUS_SUCCESS) ? "\r\n" : " failed\r\n");
+        }
+    }
+    if (s_bootSeqMilestoneUs[BOOT_SEQ_MILESTONE_FIRST_CAN_TX] != 0u)
+    {
+        BootSeq_PrintMs("First CAN frame ", s_bootSeqMilestoneUs[BOOT_SEQ_MILESTONE_FIRST_CAN_TX], "\r\n");
+    }
+}
+#endif
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Take the step table and start the boot clock. Call first.
+ *
+ * A step depends only on earlier steps of the same or an earlier phase.
+ *
+ * @param steps Step table indexed by BootSeq_StepIdType
+ * @param count Number of steps
+ *-----------------------------------------------------------------------------
+ */
+void BootSeq_Init(const BootSeq_StepType *steps, uint8 count)
+{
+    uint8 idx;
+    uint8 dep;
+
+    /* Time zero of the log */
+    CycleCounter_Init();
+
+    DEV_ASSERT((steps != NULL) && (count <= BOOT_SEQ_MAX_STEPS));
+    for (idx = 0u; idx < count; idx++)
+    {
+        DEV_ASSERT((steps[idx].deps & ~(BOOT_SEQ_BIT(idx) - 1UL)) == 0u);
+        for (dep = 0u; dep < idx; dep++)
+        {
+            DEV_ASSERT(((steps[idx].deps & BOOT_SEQ_BIT(dep)) == 0u) ||
+                       (steps[dep].phase <= steps[idx].phase));
+        }
+    }
+
+    s_bootSeqSteps = steps;
+    s_bootSeqCount = count;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Run the EARLY steps in table order, before the scheduler.
+ *-----------------------------------------------------------------------------
+ */
+void BootSeq_RunEarly(void)
+{
+    uint8 idx;
+
+    for (idx = 0u; idx < s_bootSeqCount; idx++)
+    {
+        if (s_bootSeqSteps[idx].phase == BOOT_SEQ_PHASE_EARLY)
+        {
+            BootSeq_RunStep(idx);
+        }
+    }
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Create the event group and vBootSeq, after BootSeq_RunEarly and
+ *        before the tasks calling BootSeq_Require.
+ *
+ * @return STATUS_ERROR if the FreeRTOS heap is exhausted
+ *-----------------------------------------------------------------------------
+ */
+status_t BootSeq_Start(void)
+{
+    status_t status = STATUS_ERROR;
+
+    s_bootSeqEvents = xEventGroupCreate();
+    if (s_bootSeqEvents != NULL)
+    {
+        (void)xEventGroupSetBits(s_bootSeqEvents, (EventBits_t)s_bootSeqDone);
+        if (xTaskCreate(vBootSeq, "Boot", BOOT_SEQ_STACK_SIZE, NULL, BOOT_SEQ_TASK_PRIORITY,
+                        &s_bootSeqTask) == pdPASS)
+        {
+            status = STATUS_SUCCESS;
+        }
+    }
+
+    return status;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Wait until steps are done, starting the LAZY ones among them.
+ *
+ * @param steps BOOT_SEQ_BIT of each step
+ * @param ticksToWait Maximum wait
+ * @return STATUS_TIMEOUT if not done in time, STATUS_ERROR if one failed
+ *-----------------------------------------------------------------------------
+ */
+status_t BootSeq_Require(uint32 steps, TickType_t ticksToWait)
+{
+    status_t status = STATUS_SUCCESS;
+    EventBits_t bits;
+
+    DEV_ASSERT(s_bootSeqEvents != NULL);
+
+    if ((s_bootSeqDone & steps) != steps)
+    {
+        INT_SYS_DisableIRQGlobal();
+        s_bootSeqRequested |= steps;
+        INT_SYS_EnableIRQGlobal();
+        (void)xTaskNotifyGive(s_bootSeqTask);
+
+        bits = xEventGroupWaitBits(s_bootSeqEvents, (EventBits_t)steps, pdFALSE, pdTRUE, ticksToWait);
+        if ((bits & steps) != steps)
+        {
+            status = STATUS_TIMEOUT;
+        }
+    }
+    if ((status == STATUS_SUCCESS) && ((s_bootSeqFailed & steps) != 0u))
+    {
+        status = STATUS_ERROR;
+    }
+
+    return status;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Record the first time a milestone is reached.
+ *
+ * @param milestone BootSeq_MilestoneType
+ *-----------------------------------------------------------------------------
+ */
+void BootSeq_Milestone(BootSeq_MilestoneType milestone)
+{
+    DEV_ASSERT(milestone < BOOT_SEQ_MILESTONE_COUNT);
+
+    if (s_bootSeqMilestoneUs[milestone] == 0u)
+    {
+        s_bootSeqMilestoneUs[milestone] = CYCLES_TO_US(CycleCounter_Get());
+    }
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Copy the log of a step.
+ *
+ * @param step BootSeq_StepIdType
+ * @param log Destination
+ * @return false if the step has not run
+ *-----------------------------------------------------------------------------
+ */
+boolean BootSeq_GetLog(uint8 step, BootSeq_LogType *log)
+{
+    DEV_ASSERT(step < s_bootSeqCount);
+
+    INT_SYS_DisableIRQGlobal();
+    *log = s_bootSeqLog[step];
+    INT_SYS_EnableIRQGlobal();
+
+    return log->done;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Time of a milestone.
+ *
+ * @param milestone BootSeq_MilestoneType
+ * @return Microseconds from BootSeq_Init, 0 if not reached
+ *-----------------------------------------------------------------------------
+ */
+uint32 BootSeq_GetMilestoneUs(BootSeq_MilestoneType milestone)
+{
+    DEV_ASSERT(milestone < BOOT_SEQ_MILESTONE_COUNT);
+
+    return s_bootSeqMilestoneUs[milestone];
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Init task: the TASK steps, then the LAZY steps as they are asked for.
+ *
+ * @param pvParameters Unused
+ *-----------------------------------------------------------------------------
+ */
+void vBootSeq(void *pvParameters)
+{
+    uint32 pending;
+    uint8 idx;
+#if BOOT_SEQ_PRINT_ENABLED
+    boolean printed = false;
+#endif
+
+    (void)pvParameters;
+
+    for (;;)
+    {
+        /* Requested LAZY steps and, table order being topological, their deps */
+        pending = s_bootSeqRequested;
+        for (idx = s_bootSeqCount; idx > 0u; idx--)
+        {
+            if ((pending & BOOT_SEQ_BIT(idx - 1U)) != 0u)
+            {
+                pending |= s_bootSeqSteps[idx - 1U].deps;
+            }
+        }
+
+        for (idx = 0u; idx < s_bootSeqCount; idx++)
+        {
+            if (((s_bootSeqDone & BOOT_SEQ_BIT(idx)) == 0u) &&
+                ((s_bootSeqSteps[idx].phase == BOOT_SEQ_PHASE_TASK) ||
+                 ((pending & BOOT_SEQ_BIT(idx)) != 0u)))
+            {
+                BootSeq_RunStep(idx);
+            }
+        }
+
+#if BOOT_SEQ_PRINT_ENABLED
+        if ((printed == false) && ((s_bootSeqDone & BOOT_SEQ_BIT(BOOT_STEP_UART)) != 0u))
+        {
+            printed = true;
+            BootSeq_PrintLog();
+        }
+#endif
+
+        /* A request made while the steps ran is counted and not lost */
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
@@ -0,0 +1,88 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file boot_seq.h
+ * @brief Boot sequencer: init steps in phases, with dependencies and timing
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _BOOT_SEQ_H_
+#define _BOOT_SEQ_H_
+
+#include "FreeRTOS.h"
+#include "Rte_Type.h"
+#include "Cpu.h"
+
+/* Macro Define -------------------------------------------------------------*/
+/* Print the step times over LPUART1 once the task phase is done */
+#define BOOT_SEQ_PRINT_ENABLED      (1U)
+
+#define BOOT_SEQ_TASK_PRIORITY      (tskIDLE_PRIORITY + 1)
+#define BOOT_SEQ_STACK_SIZE         (configMINIMAL_STACK_SIZE + 60U)
+
+#define BOOT_SEQ_BIT(step)          ((uint32)1UL << (uint32)(step))
+
+/* Phases */
+#define BOOT_SEQ_PHASE_EARLY        (0U)    /* BootSeq_RunEarly, before the scheduler */
+#define BOOT_SEQ_PHASE_TASK         (1U)    /* vBootSeq, in table order */
+#define BOOT_SEQ_PHASE_LAZY         (2U)    /* vBootSeq, on the first BootSeq_Require */
+
+/* Type Define --------------------------------------------------------------*/
+/* Index of the step table in rtos.c, 24 at most (event group bits) */
+typedef enum
+{
+    BOOT_STEP_CLOCK = 0U,
+    BOOT_STEP_POWER,
+    BOOT_STEP_PINS,
+    BOOT_STEP_DMA,
+    BOOT_STEP_CAN,
+    BOOT_STEP_CAN_GATEWAY,
+    BOOT_STEP_GPIO,
+    BOOT_STEP_UART,
+    BOOT_STEP_ADC,
+    BOOT_STEP_DMA_COPY,
+    BOOT_STEP_UART_RX,
+    BOOT_STEP_SBC,
+    BOOT_STEP_SPI_QUEUE,
+    BOOT_STEP_RUN_GOV,
+    BOOT_STEP_BANNER,
+    BOOT_STEP_COUNT
+} BootSeq_StepIdType;
+
+typedef enum
+{
+    BOOT_SEQ_MILESTONE_FIRST_CAN_TX = 0U,
+    BOOT_SEQ_MILESTONE_COUNT
+} BootSeq_MilestoneType;
+
+typedef struct
+{
+    const char *name;
+    status_t (*init)(void);
+    uint32 deps;                    /* BOOT_SEQ_BIT of earlier steps */
+    uint8 phase;
+} BootSeq_StepType;
+
+typedef struct
+{
+    uint32 startUs;                 /* From BootSeq_Init, first thing after reset */
+    uint32 durationUs;
+    status_t status;
+    boolean done;
+} BootSeq_LogType;
+
+/* Export Parameters --------------------------------------------------------*/
+extern void BootSeq_Init(const BootSeq_StepType *steps, uint8 count);
+extern void BootSeq_RunEarly(void);
+extern status_t BootSeq_Start(void);
+extern status_t BootSeq_Require(uint32 steps, TickType_t ticksToWait);
+extern void BootSeq_Milestone(BootSeq_MilestoneType milestone);
+extern boolean BootSeq_GetLog(uint8 step, BootSeq_LogType *log);
+extern uint32 BootSeq_GetMilestoneUs(BootSeq_MilestoneType milestone);
+extern void vBootSeq(void *pvParameters);
+
+#endif
@@ -21,69 +21,131 @@ can_buff_config_t g_CanBufferConfig =
     .isRemote = false
 };
 
+volatile CanTxCyclesType g_CanTxCycles = {0u, 0u};
+
+/* Last LED command received on RX_MSG_ID, written from the FlexCAN ISR */
+static volatile LedCtlType s_rxLedCtlSig = LedCtlType_Invalid;
+static volatile uint32 s_rxLedCtlCount = 0u;
+
 static void CAN_Config(void);
+/* Runs in the FlexCAN interrupt for every frame of RX_MSG_ID */
+static void CAN_LedCtlRxNotification(uint32 instance, const can_message_t *msg) CODE_RAM_FUNC;
 
 void vCanApp (void *pvParameters)
 {
     TickType_t xNextWakeTime;
     /* Casting pvParameters to void because it is unused */
     (void)pvParameters; 
-    float32 avgVolts;
-    /* Define receive buffer */
-    can_message_t recvMsg;
+    AdcUnits_MvType avgMv = 0u;
     can_message_t sendMsg;
     LedCtlType uLedCtlSig = LedCtlType_Invalid;
+    uint32 txStart;
+    status_t status;
+#if CAN_PN_ENABLED
+    uint32 lastRxCount = 0u;
+    TickType_t xLastRxTime;
+#endif
 
-    /* Thread start */
+    /* Thread start, CAN is up before the scheduler */
+    (void)BootSeq_Require(BOOT_SEQ_BIT(BOOT_STEP_CAN) | BOOT_SEQ_BIT(BOOT_STEP_CAN_GATEWAY), portMAX_DELAY);
     uLedCtlSig = LedCtlType_ON;
     CAN_Config();
     /* Initial struct value */
-    memset(&recvMsg, 0u, sizeof(can_message_t));
     memset(&sendMsg, 0u, sizeof(can_message_t));
 
     xNextWakeTime = xTaskGetTickCount();
+#if CAN_PN_ENABLED
+    xLastRxTime = xNextWakeTime;
+#endif
     for( ;; )
     {
         // print("Thread - vCanApp Run - 100ms\r\n");
-        xQueuePeek(xVolSig, &avgVolts, mainDONT_BLOCK);
-        
-        /* Start receiving data in RX_MAILBOX. */
-        CAN_Receive(&can_pal1_instance, RX_MAILBOX, &recvMsg);
+        xQueuePeek(xVolSig, &avgMv, mainDONT_BLOCK);
 
-        /* Wait until the previous FlexCAN receive is completed */
-        // while(CAN_GetTransferStatus(&can_pal1_instance, RX_MAILBOX) == STATUS_BUSY);
+        /* RX_MSG_ID frames are filtered in hardware and decoded in the ISR */
+        uLedCtlSig = s_rxLedCtlSig;
 
-        /* Check the received message ID and payload */
-        if((recvMsg.data[0] == LedCtlType_OFF) &&
-            recvMsg.id == RX_MSG_ID)
+        xQueueSend(xLedCtrlSig, &uLedCtlSig, mainDONT_BLOCK );
+        /* Send the information via CAN */
+        sendMsg.cs = 0U;
+        sendMsg.id = TX_MSG_ID;
+        sendMsg.data[0] = AdcUnits_MvToCan(avgMv);
+        sendMsg.data[1] = (uint8)LED_2_St;
+        sendMsg.length = 8U;
+        txStart = CycleCounter_Get();
+        status = CAN_SendFast(&can_pal1_instance, TX_MAILBOX, &sendMsg);
+        g_CanTxCycles.last = CycleCounter_Get() - txStart;
+        if (g_CanTxCycles.last > g_CanTxCycles.max)
         {
-            uLedCtlSig = LedCtlType_OFF;
+            g_CanTxCycles.max = g_CanTxCycles.last;
         }
-        else if((recvMsg.data[0] == LedCtlType_ON) &&
-                recvMsg.id == RX_MSG_ID)
+        if (status == STATUS_SUCCESS)
         {
-            uLedCtlSig = LedCtlType_ON;
+            CanTrace_TxRequest(&can_pal1_instance, TX_MAILBOX, &sendMsg);
+            BootSeq_Milestone(BOOT_SEQ_MILESTONE_FIRST_CAN_TX);
+        }
+#if CAN_PN_ENABLED
+        /* Sleep until the next wake frame once the LED commands stopped */
+        if (s_rxLedCtlCount != lastRxCount)
+        {
+            lastRxCount = s_rxLedCtlCount;
+            xLastRxTime = xTaskGetTickCount();
+        }
+        else if ((xTaskGetTickCount() - xLastRxTime) >= pdMS_TO_TICKS(CAN_PN_IDLE_TIMEOUT_MS))
+        {
+            /* Not in RUN: retried in the next period */
+            if (CanPn_Sleep() == STATUS_SUCCESS)
+            {
+                xLastRxTime = xTaskGetTickCount();
+                xNextWakeTime = xLastRxTime;
+            }
         }
         else
         {
-            uLedCtlSig = LedCtlType_Invalid;
+            /* Do Nothing */
         }
-
-        xQueueSend(xLedCtrlSig, &uLedCtlSig, mainDONT_BLOCK );
-        /* Send the information via CAN */
-        sendMsg.cs = 0U;
-        sendMsg.id = TX_MSG_ID;
-        sendMsg.data[0] = (uint8)(avgVolts*50);
-        sendMsg.data[1] = (uint8)LED_2_St;
-        sendMsg.length = 8U;
-        CAN_Send(&can_pal1_instance, TX_MAILBOX, &sendMsg);
+#endif
         vTaskDelayUntil( &xNextWakeTime, TASK_PERIOD_10_MS );
     }
 }
 
+static void CAN_LedCtlRxNotification(uint32 instance, const can_message_t *msg)
+{
+    (void)instance;
+
+    s_rxLedCtlCount++;
+    /* Check the received payload */
+    if (msg->data[0] == LedCtlType_OFF)
+    {
+        s_rxLedCtlSig = LedCtlType_OFF;
+    }
+    else if (msg->data[0] == LedCtlType_ON)
+    {
+        s_rxLedCtlSig = LedCtlType_ON;
+    }
+    else
+    {
+        s_rxLedCtlSig = LedCtlType_Invalid;
+    }
+}
+
 static void CAN_Config(void)
 {
-	CAN_ConfigRxBuff(&can_pal1_instance, RX_MAILBOX, &g_CanBufferConfig, MSG_ALL_ACCEPT);
-	CAN_SetRxFilter(&can_pal1_instance,FLEXCAN_MSG_ID_STD, RX_MAILBOX,MSG_ALL_ACCEPT);
+    status_t status;
+
+    /* Only subscribed IDs are accepted by the mailboxes, the rest of the
+     * bus traffic never raises an interrupt */
+    status = CanFilter_Subscribe(&can_pal1_instance, RX_MSG_ID, CAN_LedCtlRxNotification);
+    DEV_ASSERT(status == STATUS_SUCCESS);
+    status = CanFilter_Compile(&can_pal1_instance, &g_CanBufferConfig, RX_MAILBOX, RX_MAILBOX_NUM);
+    DEV_ASSERT(status == STATUS_SUCCESS);
+    status = CanFilter_Start(&can_pal1_instance);
+    DEV_ASSERT(status == STATUS_SUCCESS);
+#if CAN_PN_ENABLED
+    status = CanPn_Init(&can_pal1_instance);
+    DEV_ASSERT(status == STATUS_SUCCESS);
+#endif
+    (void)status;
+
 	CAN_ConfigTxBuff(&can_pal1_instance, TX_MAILBOX, &g_CanBufferConfig);
 }
\ No newline at end of file
@@ -27,19 +27,36 @@
 #include "string.h"
 #include "uart_app.h"
 #include "LedControl.h"
+#include "can_filter.h"
+#include "cycle_counter.h"
+#include "code_ram.h"
+#include "can_trace.h"
+#include "can_pn.h"
+#include "adc_units.h"
+#include "boot_seq.h"
 
 /* Macro Define -------------------------------------------------------------*/
-#define TX_MAILBOX  (1UL)
+#define TX_MAILBOX  (6UL)
 #define TX_MSG_ID   (0x100UL)
 #define RX_MAILBOX  (0UL)
+#define RX_MAILBOX_NUM  (6UL)   /* MB0..MB5 are handed to the filter compiler */
 #define RX_MSG_ID   (0x101UL)
 #define MSG_ALL_ACCEPT (0UL)
 
+/* Type Define --------------------------------------------------------------*/
+typedef struct
+{
+    uint32 last;        /* Core cycles spent in the last CAN_SendFast call */
+    uint32 max;
+} CanTxCyclesType;
+
 /* Import Parameters --------------------------------------------------------*/
 extern QueueHandle_t xVolSig;
 extern QueueHandle_t xLedCtrlSig;
 
 /* Export Parameters --------------------------------------------------------*/
+/* Cycles-per-frame of the periodic transmission, read with the debugger */
+extern volatile CanTxCyclesType g_CanTxCycles;
 
 extern void vCanApp (void *pvParameters);
 
@@ -0,0 +1,400 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file can_filter.c
+ * @brief CAN reception subscriptions compiled into FlexCAN mailbox filters
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * Modules register the IDs they consume with CanFilter_Subscribe(). The
+ * subscription list is then compiled into at most numMb (code, mask) pairs
+ * which are written to the FlexCAN individual masks (RXIMR), so frames that
+ * nobody consumes are dropped by the hardware and never raise an interrupt.
+ * When there are more IDs than mailboxes, the pair of filters whose union
+ * admits the fewest extra IDs is merged until the list fits. A merged mask
+ * only clears bits in which its members differ, so every subscribed ID still
+ * matches its mailbox; the few extra IDs it lets through are rejected in the
+ * ISR against the subscription list.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "can_filter.h"
+#include "can_trace.h"
+
+/* Type Define --------------------------------------------------------------*/
+typedef struct
+{
+    uint32 id;
+    CanFilter_RxNotificationType rxNotification;
+} CanFilter_SubscriptionType;
+
+typedef struct
+{
+    CanFilter_SubscriptionType subscriptions[CAN_FILTER_MAX_SUBSCRIPTIONS];
+    uint8 numSubscriptions;
+    CanFilter_MbFilterType mbFilters[CAN_FILTER_MAX_SUBSCRIPTIONS];
+    uint8 numMbFilters;
+    const can_instance_t *canInstance;
+    uint32 firstMb;
+    boolean compiled;
+    CanFilter_TxNotificationType txNotification;
+    CanFilter_WakeUpNotificationType wakeUpNotification;
+    /* Frames are read by the driver straight into these buffers */
+    can_message_t rxBuff[CAN_FILTER_MAX_RX_MB];
+    /* Frames that passed a merged hardware mask but had no subscriber */
+    volatile uint32 rejectedCount;
+} CanFilter_StateType;
+
+/* Local Parameters ---------------------------------------------------------*/
+/* One state per FlexCAN instance, indexed by instIdx */
+static CanFilter_StateType s_canFilterState[CAN_INSTANCE_COUNT];
+
+/* Local Functions ----------------------------------------------------------*/
+static CanFilter_StateType *CanFilter_GetState(const can_instance_t * const instance)
+{
+    DEV_ASSERT(instance != NULL);
+    DEV_ASSERT(instance->instIdx < CAN_INSTANCE_COUNT);
+
+    return &s_canFilterState[instance->instIdx];
+}
+
+static uint32 CanFilter_CountDontCare(uint32 mask, uint32 idMask)
+{
+    uint32 bits = idMask & ~mask;
+    uint32 count = 0u;
+
+    while (bits != 0u)
+    {
+        bits &= bits - 1u;
+        count++;
+    }
+
+    return count;
+}
+
+static uint32 CanFilter_MergeMask(const CanFilter_MbFilterType *a,
+                                  const CanFilter_MbFilterType *b)
+{
+    return a->mask & b->mask & ~(a->code ^ b->code);
+}
+
+static void CanFilter_BuildFilters(CanFilter_StateType *state, uint32 idMask, uint32 numMb)
+{
+    CanFilter_MbFilterType *filters = state->mbFilters;
+    uint8 i, j;
+
+    /* Start with one exact-match filter per unique ID */
+    state->numMbFilters = 0u;
+    for (i = 0u; i < state->numSubscriptions; i++)
+    {
+        for (j = 0u; j < state->numMbFilters; j++)
+        {
+            if (filters[j].code == state->subscriptions[i].id)
+            {
+                break;
+            }
+        }
+
+        if (j == state->numMbFilters)
+        {
+            filters[j].code = state->subscriptions[i].id;
+            filters[j].mask = idMask;
+            filters[j].numIds = 1u;
+            state->numMbFilters++;
+        }
+    }
+
+    /* Merge the cheapest pair until the filters fit in the mailboxes */
+    while (state->numMbFilters > numMb)
+    {
+        uint8 bestA = 0u;
+        uint8 bestB = 1u;
+        sint32 bestCost = 0x7FFFFFFFL;
+
+        for (i = 0u; i < state->numMbFilters; i++)
+        {
+            for (j = (uint8)(i + 1u); j < state->numMbFilters; j++)
+            {
+                uint32 merged = CanFilter_MergeMask(&filters[i], &filters[j]);
+                /* Number of IDs admitted by the merged filter that neither
+                 * of the two filters admitted before (negative if they overlap) */
+                sint32 cost = (sint32)(1UL << CanFilter_CountDontCare(merged, idMask))
+                            - (sint32)(1UL << CanFilter_CountDontCare(filters[i].mask, idMask))
+                            - (sint32)(1UL << CanFilter_CountDontCare(filters[j].mask, idMask));
+
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestA = i;
+                    bestB = j;
+                }
+            }
+        }
+
+        filters[bestA].mask = CanFilter_MergeMask(&filters[bestA], &filters[bestB]);
+        filters[bestA].code &= filters[bestA].mask;
+        filters[bestA].numIds += filters[bestB].numIds;
+
+        state->numMbFilters--;
+        filters[bestB] = filters[state->numMbFilters];
+    }
+
+    /* Every subscribed ID must still be admitted by one of the filters */
+    for (i = 0u; i < state->numSubscriptions; i++)
+    {
+        for (j = 0u; j < state->numMbFilters; j++)
+        {
+            if ((state->subscriptions[i].id & filters[j].mask) == filters[j].code)
+            {
+                break;
+            }
+        }
+        DEV_ASSERT(j < state->numMbFilters);
+    }
+}
+
+static void CanFilter_Dispatch(CanFilter_StateType *state, uint32 instance, const can_message_t *msg)
+{
+    boolean delivered = false;
+    uint8 i;
+
+    for (i = 0u; i < state->numSubscriptions; i++)
+    {
+        if (state->subscriptions[i].id == msg->id)
+        {
+            state->subscriptions[i].rxNotification(instance, msg);
+            delivered = true;
+        }
+    }
+
+    if (delivered == false)
+    {
+        state->rejectedCount++;
+    }
+}
+
+static void CanFilter_EventCallback(uint32_t instance,
+                                    can_event_t eventType,
+                                    uint32_t objIdx,
+                                    void *driverState)
+{
+    CanFilter_StateType *state = &s_canFilterState[instance];
+
+    (void)driverState;
+
+    if ((eventType == CAN_EVENT_RX_COMPLETE) &&
+        (objIdx >= state->firstMb) &&
+        (objIdx < (state->firstMb + state->numMbFilters)))
+    {
+        const can_message_t *msg = &state->rxBuff[objIdx - state->firstMb];
+
+        CanTrace_Rx(instance, msg);
+        CanFilter_Dispatch(state, instance, msg);
+
+        /* Re-arm the mailbox for the next frame */
+        (void)CAN_Receive(state->canInstance, objIdx, &state->rxBuff[objIdx - state->firstMb]);
+    }
+    else if (eventType == CAN_EVENT_TX_COMPLETE)
+    {
+        CanTrace_TxComplete(instance, objIdx);
+        if (state->txNotification != NULL)
+        {
+            state->txNotification(instance, objIdx);
+        }
+    }
+    else if (((eventType == CAN_EVENT_WAKEUP_MATCH) || (eventType == CAN_EVENT_WAKEUP_TIMEOUT)) &&
+             (state->wakeUpNotification != NULL))
+    {
+        state->wakeUpNotification(instance, eventType);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Register a receive notification for a CAN ID.
+ *
+ * @param instance CAN PAL instance the ID is received on
+ * @param id CAN ID to receive, same ID type as passed to CanFilter_Compile
+ * @param rxNotification called from ISR context for each matching frame
+ * @return STATUS_SUCCESS, STATUS_BUSY after compilation, STATUS_ERROR when
+ *         the subscription table is full
+ *-----------------------------------------------------------------------------
+ */
+status_t CanFilter_Subscribe(const can_instance_t * const instance,
+                             uint32 id,
+                             CanFilter_RxNotificationType rxNotification)
+{
+    CanFilter_StateType *state = CanFilter_GetState(instance);
+
+    DEV_ASSERT(rxNotification != NULL);
+
+    if (state->compiled == true)
+    {
+        return STATUS_BUSY;
+    }
+
+    if (state->numSubscriptions >= CAN_FILTER_MAX_SUBSCRIPTIONS)
+    {
+        return STATUS_ERROR;
+    }
+
+    state->subscriptions[state->numSubscriptions].id = id;
+    state->subscriptions[state->numSubscriptions].rxNotification = rxNotification;
+    state->numSubscriptions++;
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Compile the subscriptions into mailbox filters and program them.
+ *
+ * @param instance CAN PAL instance
+ * @param config buffer configuration used for all reception mailboxes
+ * @param firstMb first mailbox reserved for reception
+ * @param numMb number of consecutive mailboxes reserved for reception
+ * @return STATUS_SUCCESS or the first error returned by the CAN PAL
+ *-----------------------------------------------------------------------------
+ */
+status_t CanFilter_Compile(const can_instance_t * const instance,
+                           const can_buff_config_t *config,
+                           uint32 firstMb,
+                           uint32 numMb)
+{
+    CanFilter_StateType *state = CanFilter_GetState(instance);
+    status_t status = STATUS_SUCCESS;
+    uint32 idMask;
+    uint8 i;
+
+    DEV_ASSERT(config != NULL);
+    DEV_ASSERT((numMb > 0u) && (numMb <= CAN_FILTER_MAX_RX_MB));
+
+    idMask = (config->idType == CAN_MSG_ID_EXT) ? CAN_FILTER_EXT_ID_MASK : CAN_FILTER_STD_ID_MASK;
+
+    CanFilter_BuildFilters(state, idMask, numMb);
+
+    for (i = 0u; (i < state->numMbFilters) && (status == STATUS_SUCCESS); i++)
+    {
+        status = CAN_ConfigRxBuff(instance, firstMb + i, config, state->mbFilters[i].code);
+        if (status == STATUS_SUCCESS)
+        {
+            status = CAN_SetRxFilter(instance, config->idType, firstMb + i, state->mbFilters[i].mask);
+        }
+    }
+
+    state->canInstance = instance;
+    state->firstMb = firstMb;
+    state->compiled = (status == STATUS_SUCCESS);
+
+    return status;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Install the reception callback and arm all compiled mailboxes.
+ *
+ * @param instance CAN PAL instance passed to CanFilter_Compile
+ * @return STATUS_SUCCESS or the first error returned by the CAN PAL
+ *-----------------------------------------------------------------------------
+ */
+status_t CanFilter_Start(const can_instance_t * const instance)
+{
+    CanFilter_StateType *state = CanFilter_GetState(instance);
+    status_t status;
+    uint8 i;
+
+    DEV_ASSERT(state->compiled == true);
+
+    status = CAN_InstallEventCallback(instance, CanFilter_EventCallback, NULL);
+
+    for (i = 0u; (i < state->numMbFilters) && (status == STATUS_SUCCESS); i++)
+    {
+        status = CAN_Receive(instance, state->firstMb + i, &state->rxBuff[i]);
+    }
+
+    return status;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Forward transmit complete events of an instance.
+ *
+ * The CAN PAL holds a single event callback per instance, which is owned by
+ * this module once CanFilter_Start has been called.
+ *
+ * @param instance CAN PAL instance
+ * @param txNotification called from ISR context, NULL to remove
+ *-----------------------------------------------------------------------------
+ */
+void CanFilter_InstallTxNotification(const can_instance_t * const instance,
+                                     CanFilter_TxNotificationType txNotification)
+{
+    CanFilter_GetState(instance)->txNotification = txNotification;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Forward Pretended Networking wake up events of an instance.
+ *
+ * @param instance CAN PAL instance
+ * @param wakeUpNotification called from ISR context, NULL to remove
+ *-----------------------------------------------------------------------------
+ */
+void CanFilter_InstallWakeUpNotification(const can_instance_t * const instance,
+                                         CanFilter_WakeUpNotificationType wakeUpNotification)
+{
+    CanFilter_GetState(instance)->wakeUpNotification = wakeUpNotification;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Deliver a frame to the subscribers as if it had been received.
+ *
+ * Used to replay recorded traffic, must be called with the FlexCAN
+ * interrupts of the instance masked.
+ *
+ * @param instance FlexCAN instance number
+ * @param msg frame to deliver
+ *-----------------------------------------------------------------------------
+ */
+void CanFilter_InjectRx(uint32 instance, const can_message_t *msg)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    CanFilter_Dispatch(&s_canFilterState[instance], instance, msg);
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Get the compiled filter of a reception mailbox.
+ *
+ * @param instance CAN PAL instance
+ * @param mbOffset mailbox offset from firstMb
+ * @return filter, or NULL if the mailbox is not used
+ *-----------------------------------------------------------------------------
+ */
+const CanFilter_MbFilterType *CanFilter_GetMbFilter(const can_instance_t * const instance,
+                                                    uint32 mbOffset)
+{
+    const CanFilter_StateType *state = CanFilter_GetState(instance);
+
+    return (mbOffset < state->numMbFilters) ? &state->mbFilters[mbOffset] : NULL;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Number of frames admitted by a merged mask but not subscribed.
+ *
+ * @param instance CAN PAL instance
+ *-----------------------------------------------------------------------------
+ */
+uint32 CanFilter_GetRejectedCount(const can_instance_t * const instance)
+{
+    return CanFilter_GetState(instance)->rejectedCount;
+}
@@ -0,0 +1,59 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file can_filter.h
+ * @brief CAN reception subscriptions compiled into FlexCAN mailbox filters
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _CAN_FILTER_H_
+#define _CAN_FILTER_H_
+
+#include "Rte_Type.h"
+#include "Cpu.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define CAN_FILTER_MAX_SUBSCRIPTIONS    (16U)
+#define CAN_FILTER_MAX_RX_MB            (8U)
+
+#define CAN_FILTER_STD_ID_MASK          (0x7FFUL)
+#define CAN_FILTER_EXT_ID_MASK          (0x1FFFFFFFUL)
+
+/* Type Define --------------------------------------------------------------*/
+/* Called from the FlexCAN ISR for every received frame whose ID was subscribed */
+typedef void (*CanFilter_RxNotificationType)(uint32 instance, const can_message_t *msg);
+/* Called from the FlexCAN ISR when a transmission from any mailbox completed */
+typedef void (*CanFilter_TxNotificationType)(uint32 instance, uint32 buffIdx);
+/* Called from the FlexCAN ISR on a Pretended Networking wake up event */
+typedef void (*CanFilter_WakeUpNotificationType)(uint32 instance, can_event_t eventType);
+
+typedef struct
+{
+    uint32 code;        /* ID bits that must match */
+    uint32 mask;        /* 1 = bit compared, 0 = don't care */
+    uint8 numIds;       /* Subscribed IDs routed to this mailbox */
+} CanFilter_MbFilterType;
+
+/* Export Parameters --------------------------------------------------------*/
+extern status_t CanFilter_Subscribe(const can_instance_t * const instance,
+                                    uint32 id,
+                                    CanFilter_RxNotificationType rxNotification);
+extern status_t CanFilter_Compile(const can_instance_t * const instance,
+                                  const can_buff_config_t *config,
+                                  uint32 firstMb,
+                                  uint32 numMb);
+extern status_t CanFilter_Start(const can_instance_t * const instance);
+extern void CanFilter_InjectRx(uint32 instance, const can_message_t *msg);
+extern void CanFilter_InstallTxNotification(const can_instance_t * const instance,
+                                            CanFilter_TxNotificationType txNotification);
+extern void CanFilter_InstallWakeUpNotification(const can_instance_t * const instance,
+                                                CanFilter_WakeUpNotificationType wakeUpNotification);
+extern const CanFilter_MbFilterType *CanFilter_GetMbFilter(const can_instance_t * const instance,
+                                                           uint32 mbOffset);
+extern uint32 CanFilter_GetRejectedCount(const can_instance_t * const instance);
+
+#endif
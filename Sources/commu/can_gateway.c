@@ -0,0 +1,355 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file can_gateway.c
+ * @brief Frame routing between the FlexCAN instances
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * Every source ID of the routing table is subscribed through can_filter, so
+ * only routed frames reach the gateway. Forwarding runs entirely in the Rx
+ * complete ISR: the route is found by binary search in a table sorted at
+ * init time, then the frame is queued for the destination bus and loaded
+ * into its reserved Tx mailbox right away if that mailbox is free. The rest
+ * of the queue is drained from the Tx complete ISR of the destination bus.
+ *
+ * CanGw_Init sets all FlexCAN interrupts of the gateway buses to the same
+ * priority, so the ISRs of different buses never preempt each other and
+ * the queues need no lock.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "can_gateway.h"
+#include "cycle_counter.h"
+#include "can_trace.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define CANGW_NO_BUS                (0xFFu)
+#define CANGW_FRAME_DATA_LEN        (8U)
+/* Shared by every FlexCAN interrupt of the gateway buses */
+#define CANGW_IRQ_PRIORITY          (configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY)
+
+/* Type Define --------------------------------------------------------------*/
+typedef struct
+{
+    uint32 id;
+    uint32 rxStamp;
+    uint8 route;
+    uint8 length;
+    uint8 data[CANGW_FRAME_DATA_LEN];
+} CanGw_FrameType;
+
+typedef struct
+{
+    CanGw_FrameType queue[CANGW_TX_QUEUE_LEN];
+    uint8 head;
+    uint8 tail;
+    boolean txBusy;
+} CanGw_BusStateType;
+
+/* Local Parameters ---------------------------------------------------------*/
+static const can_buff_config_t s_canGwBuffConfig =
+{
+    .enableFD = false,
+    .enableBRS = false,
+    .fdPadding = 0U,
+    .idType = CAN_MSG_ID_STD,
+    .isRemote = false
+};
+
+static CanGw_BusStateType s_busState[CANGW_MAX_BUSES];
+/* FlexCAN instance number to bus index */
+static uint8 s_busOfInstance[CAN_INSTANCE_COUNT];
+/* Route indices sorted by (srcBus, srcId) */
+static uint8 s_routeOrder[CANGW_MAX_ROUTES];
+static CanGw_RouteCounterType s_routeCounters[CANGW_MAX_ROUTES];
+
+static const IRQn_Type s_canGwOredIrqs[] = CAN_Bus_Off_IRQS;
+static const IRQn_Type s_canGwErrorIrqs[] = CAN_Error_IRQS;
+static const IRQn_Type s_canGwWakeUpIrqs[] = CAN_Wake_Up_IRQS;
+static const IRQn_Type s_canGwMb0Irqs[] = CAN_ORed_0_15_MB_IRQS;
+static const IRQn_Type s_canGwMb1Irqs[] = CAN_ORed_16_31_MB_IRQS;
+
+/* Local Functions ----------------------------------------------------------*/
+static void CanGw_SetIrqPriority(uint32 instance)
+{
+    const IRQn_Type irqs[] =
+    {
+        s_canGwOredIrqs[instance], s_canGwErrorIrqs[instance], s_canGwWakeUpIrqs[instance],
+        s_canGwMb0Irqs[instance], s_canGwMb1Irqs[instance]
+    };
+    uint8 i;
+
+    for (i = 0u; i < (sizeof(irqs) / sizeof(irqs[0])); i++)
+    {
+        if (irqs[i] != NotAvail_IRQn)
+        {
+            INT_SYS_SetPriority(irqs[i], CANGW_IRQ_PRIORITY);
+        }
+    }
+}
+
+static boolean CanGw_RouteLess(const CanGw_RouteCfgType *a, uint8 srcBus, uint32 srcId)
+{
+    return (a->srcBus < srcBus) || ((a->srcBus == srcBus) && (a->srcId < srcId));
+}
+
+static void CanGw_SortRoutes(void)
+{
+    uint8 i, j;
+
+    /* Stable insertion sort, the table is small and only sorted once */
+    for (i = 0u; i < g_CanGwNumRoutes; i++)
+    {
+        const CanGw_RouteCfgType *cfg = &g_CanGwRouteCfg[i];
+
+        for (j = i; j > 0u; j--)
+        {
+            const CanGw_RouteCfgType *prev = &g_CanGwRouteCfg[s_routeOrder[j - 1u]];
+
+            if (CanGw_RouteLess(cfg, prev->srcBus, prev->srcId) == false)
+            {
+                break;
+            }
+            s_routeOrder[j] = s_routeOrder[j - 1u];
+        }
+        s_routeOrder[j] = i;
+    }
+}
+
+/* Index in s_routeOrder of the first route with key >= (srcBus, srcId) */
+static uint8 CanGw_LowerBound(uint8 srcBus, uint32 srcId)
+{
+    uint8 lo = 0u;
+    uint8 hi = g_CanGwNumRoutes;
+
+    while (lo < hi)
+    {
+        uint8 mid = (uint8)((lo + hi) >> 1u);
+
+        if (CanGw_RouteLess(&g_CanGwRouteCfg[s_routeOrder[mid]], srcBus, srcId))
+        {
+            lo = (uint8)(mid + 1u);
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+/* Load a frame into the Tx mailbox of the bus, false if the PAL refused it */
+static boolean CanGw_Transmit(uint8 bus, const CanGw_FrameType *frame)
+{
+    can_message_t msg;
+    CanGw_RouteCounterType *counter = &s_routeCounters[frame->route];
+    uint32 latency;
+
+    msg.cs = 0U;
+    msg.id = frame->id;
+    msg.length = frame->length;
+    memcpy(msg.data, frame->data, CANGW_FRAME_DATA_LEN);
+
+    /* The Tx mailbox was configured by CanGw_Init, skip the PAL checks */
+    if (CAN_SendFast(g_CanGwBusCfg[bus].instance, g_CanGwBusCfg[bus].txMb, &msg) == STATUS_SUCCESS)
+    {
+        CanTrace_TxRequest(g_CanGwBusCfg[bus].instance, g_CanGwBusCfg[bus].txMb, &msg);
+        s_busState[bus].txBusy = true;
+        counter->forwarded++;
+
+        latency = CycleCounter_Get() - frame->rxStamp;
+        if (latency > counter->maxLatencyCycles)
+        {
+            counter->maxLatencyCycles = latency;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+/* Load queued frames into the Tx mailbox as long as it is free. A frame the
+ * PAL refused stays queued for the next Tx complete or forwarded frame. */
+static void CanGw_Drain(uint8 bus)
+{
+    CanGw_BusStateType *state = &s_busState[bus];
+
+    while ((state->txBusy == false) && (state->head != state->tail))
+    {
+        if (CanGw_Transmit(bus, &state->queue[state->tail]) == false)
+        {
+            break;
+        }
+        state->tail = (uint8)((state->tail + 1u) & (CANGW_TX_QUEUE_LEN - 1u));
+    }
+}
+
+static void CanGw_Forward(uint8 route, const can_message_t *msg, uint32 rxStamp)
+{
+    const CanGw_RouteCfgType *cfg = &g_CanGwRouteCfg[route];
+    CanGw_BusStateType *dst = &s_busState[cfg->dstBus];
+    CanGw_FrameType *frame;
+    uint8 next;
+
+    next = (uint8)((dst->head + 1u) & (CANGW_TX_QUEUE_LEN - 1u));
+    if (next == dst->tail)
+    {
+        s_routeCounters[route].dropped++;
+        return;
+    }
+
+    frame = &dst->queue[dst->head];
+    frame->id = cfg->dstId;
+    frame->rxStamp = rxStamp;
+    frame->route = route;
+    frame->length = (msg->length > CANGW_FRAME_DATA_LEN) ? CANGW_FRAME_DATA_LEN : msg->length;
+    memcpy(frame->data, msg->data, CANGW_FRAME_DATA_LEN);
+    dst->head = next;
+
+    /* A Tx complete event can be missed if it fired before the event
+     * callback of the bus was installed, recover from the mailbox status */
+    if ((dst->txBusy == true) &&
+        (CAN_GetTransferStatus(g_CanGwBusCfg[cfg->dstBus].instance,
+                               g_CanGwBusCfg[cfg->dstBus].txMb) != STATUS_BUSY))
+    {
+        dst->txBusy = false;
+    }
+
+    CanGw_Drain(cfg->dstBus);
+}
+
+static void CanGw_RxNotification(uint32 instance, const can_message_t *msg)
+{
+    uint32 rxStamp = CycleCounter_Get();
+    uint8 bus = s_busOfInstance[instance];
+    uint8 pos;
+
+    if (bus == CANGW_NO_BUS)
+    {
+        return;
+    }
+
+    /* All routes of one source ID are adjacent in the sorted table */
+    for (pos = CanGw_LowerBound(bus, msg->id); pos < g_CanGwNumRoutes; pos++)
+    {
+        uint8 route = s_routeOrder[pos];
+
+        if ((g_CanGwRouteCfg[route].srcBus != bus) || (g_CanGwRouteCfg[route].srcId != msg->id))
+        {
+            break;
+        }
+        CanGw_Forward(route, msg, rxStamp);
+    }
+}
+
+static void CanGw_TxNotification(uint32 instance, uint32 buffIdx)
+{
+    uint8 bus = s_busOfInstance[instance];
+
+    if ((bus == CANGW_NO_BUS) || (buffIdx != g_CanGwBusCfg[bus].txMb))
+    {
+        return;
+    }
+
+    s_busState[bus].txBusy = false;
+    CanGw_Drain(bus);
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Bring up the gateway buses and subscribe the routed IDs.
+ *
+ * Must be called after CAN_Init of the buses initialised by the application
+ * and before their filters are compiled.
+ *
+ * @return STATUS_SUCCESS or the first error returned by the CAN PAL
+ *-----------------------------------------------------------------------------
+ */
+status_t CanGw_Init(void)
+{
+    status_t status = STATUS_SUCCESS;
+    uint8 bus, route;
+
+    DEV_ASSERT(g_CanGwNumBuses <= CANGW_MAX_BUSES);
+    DEV_ASSERT(g_CanGwNumRoutes <= CANGW_MAX_ROUTES);
+
+    /* Latency stamps, keep the counter running if it was started before */
+    if ((CYCLE_COUNTER_DWT_CTRL & CYCLE_COUNTER_CYCCNTENA) == 0u)
+    {
+        CycleCounter_Init();
+    }
+
+    for (bus = 0u; bus < CAN_INSTANCE_COUNT; bus++)
+    {
+        s_busOfInstance[bus] = CANGW_NO_BUS;
+    }
+
+    for (bus = 0u; (bus < g_CanGwNumBuses) && (status == STATUS_SUCCESS); bus++)
+    {
+        const CanGw_BusCfgType *cfg = &g_CanGwBusCfg[bus];
+
+        s_busOfInstance[cfg->instance->instIdx] = bus;
+        CanGw_SetIrqPriority(cfg->instance->instIdx);
+
+        if (cfg->port != NULL)
+        {
+            PINS_DRV_SetMuxModeSel(cfg->port, cfg->rxPin, cfg->pinMux);
+            PINS_DRV_SetMuxModeSel(cfg->port, cfg->txPin, cfg->pinMux);
+        }
+
+        if (cfg->config != NULL)
+        {
+            status = CAN_Init(cfg->instance, cfg->config);
+        }
+        if (status == STATUS_SUCCESS)
+        {
+            status = CAN_ConfigTxBuff(cfg->instance, cfg->txMb, &s_canGwBuffConfig);
+        }
+        CanFilter_InstallTxNotification(cfg->instance, CanGw_TxNotification);
+    }
+
+    CanGw_SortRoutes();
+
+    for (route = 0u; (route < g_CanGwNumRoutes) && (status == STATUS_SUCCESS); route++)
+    {
+        const CanGw_RouteCfgType *cfg = &g_CanGwRouteCfg[route];
+
+        DEV_ASSERT((cfg->srcBus < g_CanGwNumBuses) && (cfg->dstBus < g_CanGwNumBuses));
+        status = CanFilter_Subscribe(g_CanGwBusCfg[cfg->srcBus].instance, cfg->srcId, CanGw_RxNotification);
+    }
+
+    /* Buses owned by the gateway get their filters compiled here */
+    for (bus = 0u; (bus < g_CanGwNumBuses) && (status == STATUS_SUCCESS); bus++)
+    {
+        const CanGw_BusCfgType *cfg = &g_CanGwBusCfg[bus];
+
+        if (cfg->config != NULL)
+        {
+            status = CanFilter_Compile(cfg->instance, &s_canGwBuffConfig, cfg->rxFirstMb, cfg->rxNumMb);
+            if (status == STATUS_SUCCESS)
+            {
+                status = CanFilter_Start(cfg->instance);
+            }
+        }
+    }
+
+    return status;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Get the counters of a route.
+ *
+ * @param routeIdx index in g_CanGwRouteCfg
+ *-----------------------------------------------------------------------------
+ */
+const CanGw_RouteCounterType *CanGw_GetRouteCounters(uint8 routeIdx)
+{
+    DEV_ASSERT(routeIdx < g_CanGwNumRoutes);
+
+    return &s_routeCounters[routeIdx];
+}
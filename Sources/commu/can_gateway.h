@@ -0,0 +1,70 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file can_gateway.h
+ * @brief Frame routing between the FlexCAN instances
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _CAN_GATEWAY_H_
+#define _CAN_GATEWAY_H_
+
+#include "Rte_Type.h"
+#include "Cpu.h"
+#include "string.h"
+#include "pins_driver.h"
+#include "can_filter.h"
+
+/* Macro Define -------------------------------------------------------------*/
+/* The EVB only has a transceiver on CAN0, enable when the other buses are wired */
+#define CAN_GATEWAY_ENABLED         (0U)
+
+#define CANGW_MAX_BUSES             (CAN_INSTANCE_COUNT)
+#define CANGW_MAX_ROUTES            (CAN_FILTER_MAX_SUBSCRIPTIONS)
+#define CANGW_TX_QUEUE_LEN          (16U)   /* Must be a power of two */
+
+/* Type Define --------------------------------------------------------------*/
+typedef struct
+{
+    const can_instance_t *instance;
+    const can_user_config_t *config;    /* NULL: the bus is initialised and its
+                                           filters compiled by the application */
+    uint32 rxFirstMb;                   /* Rx mailboxes, only used if config != NULL */
+    uint32 rxNumMb;
+    uint32 txMb;                        /* Mailbox reserved for forwarded frames */
+    PORT_Type *port;                    /* NULL: pins configured by pin_mux */
+    uint32 rxPin;
+    uint32 txPin;
+    port_mux_t pinMux;
+} CanGw_BusCfgType;
+
+typedef struct
+{
+    uint8 srcBus;                       /* Index in g_CanGwBusCfg */
+    uint8 dstBus;
+    uint32 srcId;
+    uint32 dstId;                       /* Same as srcId unless the ID is remapped */
+} CanGw_RouteCfgType;
+
+typedef struct
+{
+    uint32 forwarded;
+    uint32 dropped;                     /* Destination Tx queue was full */
+    uint32 maxLatencyCycles;            /* Rx complete to Tx mailbox loaded */
+} CanGw_RouteCounterType;
+
+/* Import Parameters --------------------------------------------------------*/
+extern const CanGw_BusCfgType g_CanGwBusCfg[];
+extern const uint8 g_CanGwNumBuses;
+extern const CanGw_RouteCfgType g_CanGwRouteCfg[];
+extern const uint8 g_CanGwNumRoutes;
+
+/* Export Parameters --------------------------------------------------------*/
+extern status_t CanGw_Init(void);
+extern const CanGw_RouteCounterType *CanGw_GetRouteCounters(uint8 routeIdx);
+
+#endif
@@ -0,0 +1,78 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file can_gateway_cfg.c
+ * @brief Bus and routing table of the CAN gateway
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * Bus 0 is the powertrain bus on CAN0 (can_pal1_instance, initialised by
+ * rtos.c), bus 1 the body bus on CAN1 (PTA12 RX / PTA13 TX).
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "can_gateway.h"
+#include "can_app.h"
+
+/* Local Parameters ---------------------------------------------------------*/
+static const can_instance_t s_canGwBodyInstance = {CAN_INST_TYPE_FLEXCAN, 1U};
+
+static const can_user_config_t s_canGwBodyConfig = {
+    .maxBuffNum = 8UL,
+    .mode = CAN_NORMAL_MODE,
+    .peClkSrc = CAN_CLK_SOURCE_OSC,
+    .enableFD = false,
+    .payloadSize = CAN_PAYLOAD_SIZE_8,
+    .nominalBitrate = {
+        .propSeg = 7,
+        .phaseSeg1 = 4,
+        .phaseSeg2 = 1,
+        .preDivider = 0,
+        .rJumpwidth = 1
+    },
+    .dataBitrate = {
+        .propSeg = 7,
+        .phaseSeg1 = 4,
+        .phaseSeg2 = 1,
+        .preDivider = 0,
+        .rJumpwidth = 1
+    },
+    .extension = NULL,
+};
+
+/* Export Parameters --------------------------------------------------------*/
+const CanGw_BusCfgType g_CanGwBusCfg[] =
+{
+    {   /* Powertrain, shares CAN0 with vCanApp */
+        .instance = &can_pal1_instance,
+        .config = NULL,
+        .rxFirstMb = 0u,
+        .rxNumMb = 0u,
+        .txMb = 7u,
+        .port = NULL,
+    },
+    {   /* Body */
+        .instance = &s_canGwBodyInstance,
+        .config = &s_canGwBodyConfig,
+        .rxFirstMb = 0u,
+        .rxNumMb = 6u,
+        .txMb = 6u,
+        .port = PORTA,
+        .rxPin = 12u,
+        .txPin = 13u,
+        .pinMux = PORT_MUX_ALT3,
+    },
+};
+const uint8 g_CanGwNumBuses = (uint8)(sizeof(g_CanGwBusCfg) / sizeof(g_CanGwBusCfg[0]));
+
+const CanGw_RouteCfgType g_CanGwRouteCfg[] =
+{
+    /* srcBus, dstBus, srcId,  dstId */
+    {  0u,     1u,     0x300u, 0x300u },
+    {  0u,     1u,     0x101u, 0x181u },    /* LED command, remapped */
+    {  1u,     0u,     0x200u, 0x200u },
+    {  1u,     0u,     0x201u, 0x280u },
+};
+const uint8 g_CanGwNumRoutes = (uint8)(sizeof(g_CanGwRouteCfg) / sizeof(g_CanGwRouteCfg[0]));
@@ -0,0 +1,260 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file can_pn.c
+ * @brief Pretended Networking low power mode woken by CAN frames
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * The PN filter of CAN0 holds a single (ID, mask) pair, so the wake ID list
+ * is merged into the narrowest pair admitting all of them. While the core is
+ * in VLPS the FlexCAN keeps receiving on its own and copies matching frames
+ * into the wake up message buffers (WMB). After resume the WMBs are checked
+ * against the list: frames of the list are delivered to the can_filter
+ * subscribers exactly like received frames, so the waking frame is not
+ * lost, and a resume caused only by an ID the merged mask let through puts
+ * the core back to sleep.
+ *
+ * The FlexCAN protocol engine clock must keep running in VLPS for the PN
+ * filter to work, check the clockMan1 low power settings when changing
+ * peClkSrc. The FreeRTOS tick stops while sleeping.
+ *
+ * VLPS can only be entered from RUN. CanPn_Sleep refuses to sleep in HSRUN
+ * or VLPR, the caller retries once the run governor went back to RUN; the
+ * governor runs in a task, so the mode cannot change while the scheduler
+ * is suspended around the sleep.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "can_pn.h"
+#include "cycle_counter.h"
+#include "interrupt_manager.h"
+#include "task.h"
+#include "string.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define CAN_PN_SMC_STOPM_VLPS       (2U)
+#define CAN_PN_SMC_PMSTAT_RUN       (0x01U)
+
+/* Local Parameters ---------------------------------------------------------*/
+static const can_instance_t *s_canPnInstance = NULL;
+static flexcan_pn_config_t s_canPnConfig;
+static volatile boolean s_wakeMatched;
+static CanPn_StatsType s_canPnStats;
+
+/* Local Functions ----------------------------------------------------------*/
+static void CanPn_WakeUpNotification(uint32 instance, can_event_t eventType)
+{
+    (void)instance;
+
+    if (eventType == CAN_EVENT_WAKEUP_MATCH)
+    {
+        s_wakeMatched = true;
+    }
+}
+
+static boolean CanPn_IsWakeId(uint32 id)
+{
+    uint8 i;
+
+    for (i = 0u; i < g_CanPnNumWakeIds; i++)
+    {
+        if (g_CanPnWakeIds[i] == id)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Stop the core in VLPS until an enabled interrupt is pending */
+static void CanPn_EnterVlps(void)
+{
+    SMC->PMCTRL = (SMC->PMCTRL & ~SMC_PMCTRL_STOPM_MASK) | SMC_PMCTRL_STOPM(CAN_PN_SMC_STOPM_VLPS);
+    /* Make sure the write completed before WFI */
+    (void)SMC->PMCTRL;
+
+    S32_SCB->SCR |= S32_SCB_SCR_SLEEPDEEP_MASK;
+    __asm volatile ("dsb");
+    __asm volatile ("wfi");
+    __asm volatile ("isb");
+    S32_SCB->SCR &= ~S32_SCB_SCR_SLEEPDEEP_MASK;
+}
+
+/* Deliver the frames of the wake list held in the WMBs, return how many */
+static uint32 CanPn_DeliverWakeFrames(uint32 resumeCycles)
+{
+    uint32 instance = s_canPnInstance->instIdx;
+    uint32 numWmb;
+    uint32 delivered = 0u;
+    uint8 i;
+
+    numWmb = (CAN0->WU_MTC & CAN_WU_MTC_MCOUNTER_MASK) >> CAN_WU_MTC_MCOUNTER_SHIFT;
+    if (numWmb > CAN_PN_NUM_WMB)
+    {
+        numWmb = CAN_PN_NUM_WMB;
+    }
+
+    for (i = 0u; i < numWmb; i++)
+    {
+        flexcan_msgbuff_t wmb;
+        can_message_t msg;
+
+        FLEXCAN_DRV_GetWMB((uint8_t)instance, i, &wmb);
+        if (CanPn_IsWakeId(wmb.msgId) == false)
+        {
+            continue;
+        }
+
+        msg.cs = 0u;
+        msg.id = wmb.msgId;
+        msg.length = (wmb.dataLen > 8u) ? 8u : wmb.dataLen;
+        memcpy(msg.data, wmb.data, 8u);
+
+        INT_SYS_DisableIRQGlobal();
+        CanFilter_InjectRx(instance, &msg);
+        INT_SYS_EnableIRQGlobal();
+
+        if (delivered == 0u)
+        {
+            s_canPnStats.lastLatencyCycles = CycleCounter_Get() - resumeCycles;
+            if (s_canPnStats.lastLatencyCycles > s_canPnStats.maxLatencyCycles)
+            {
+                s_canPnStats.maxLatencyCycles = s_canPnStats.lastLatencyCycles;
+            }
+        }
+        delivered++;
+    }
+
+    return delivered;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Build the PN filter from g_CanPnWakeIds.
+ *
+ * VLPS is allowed by the power boot step, see CAN_PN_PMPROT.
+ *
+ * @param instance CAN PAL instance of CAN0, the only one with PN
+ * @return STATUS_SUCCESS, STATUS_ERROR if the instance has no PN
+ *-----------------------------------------------------------------------------
+ */
+status_t CanPn_Init(const can_instance_t * const instance)
+{
+    uint32 code, mask;
+    uint8 i;
+
+    DEV_ASSERT((g_CanPnNumWakeIds > 0u) && (g_CanPnNumWakeIds <= CAN_PN_MAX_WAKE_IDS));
+
+    if (instance->instIdx != 0u)
+    {
+        return STATUS_ERROR;
+    }
+
+    /* Keep only the bits in which all wake IDs agree */
+    code = g_CanPnWakeIds[0];
+    mask = CAN_FILTER_STD_ID_MASK;
+    for (i = 1u; i < g_CanPnNumWakeIds; i++)
+    {
+        mask &= ~(code ^ g_CanPnWakeIds[i]);
+    }
+    code &= mask;
+
+    s_canPnConfig.wakeUpTimeout = false;
+    s_canPnConfig.wakeUpMatch = true;
+    s_canPnConfig.numMatches = 1u;
+    s_canPnConfig.matchTimeout = 0u;
+    s_canPnConfig.filterComb = FLEXCAN_FILTER_ID;
+    s_canPnConfig.idFilter1.extendedId = false;
+    s_canPnConfig.idFilter1.remoteFrame = false;
+    s_canPnConfig.idFilter1.id = code;
+    /* IDE and RTR are compared as well: standard data frames only */
+    s_canPnConfig.idFilter2.extendedId = true;
+    s_canPnConfig.idFilter2.remoteFrame = true;
+    s_canPnConfig.idFilter2.id = mask;
+    s_canPnConfig.idFilterType = FLEXCAN_FILTER_MATCH_EXACT;
+    s_canPnConfig.payloadFilterType = FLEXCAN_FILTER_MATCH_EXACT;
+
+    s_canPnInstance = instance;
+    CanFilter_InstallWakeUpNotification(instance, CanPn_WakeUpNotification);
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Sleep in VLPS until a frame of the wake list is received.
+ *
+ * Called from task context, returns once the waking frames have been
+ * delivered to the can_filter subscribers.
+ *
+ * @return STATUS_SUCCESS after a wake up, STATUS_ERROR without sleeping if
+ *         the core is not in RUN
+ *-----------------------------------------------------------------------------
+ */
+status_t CanPn_Sleep(void)
+{
+    uint32 instance;
+    uint32 resumeCycles;
+    boolean awake = false;
+
+    DEV_ASSERT(s_canPnInstance != NULL);
+    instance = s_canPnInstance->instIdx;
+
+    vTaskSuspendAll();
+
+    if (SMC->PMSTAT != CAN_PN_SMC_PMSTAT_RUN)
+    {
+        (void)xTaskResumeAll();
+        return STATUS_ERROR;
+    }
+
+    while (awake == false)
+    {
+        s_wakeMatched = false;
+        FLEXCAN_DRV_ConfigPN((uint8_t)instance, true, &s_canPnConfig);
+
+        /* A pending interrupt ends WFI even while PRIMASK is set, the wake
+         * up ISR then runs as soon as interrupts are enabled again */
+        INT_SYS_DisableIRQGlobal();
+        CanPn_EnterVlps();
+        resumeCycles = CycleCounter_Get();
+        INT_SYS_EnableIRQGlobal();
+
+        if (s_wakeMatched == false)
+        {
+            /* Woken by another interrupt, leave the PN mode to serve it */
+            FLEXCAN_DRV_ConfigPN((uint8_t)instance, false, NULL);
+            break;
+        }
+
+        /* Deliver the waking frames, then leave the PN mode */
+        if (CanPn_DeliverWakeFrames(resumeCycles) != 0u)
+        {
+            s_canPnStats.wakeUps++;
+            awake = true;
+        }
+        else
+        {
+            s_canPnStats.spuriousWakeUps++;
+        }
+        FLEXCAN_DRV_ConfigPN((uint8_t)instance, false, NULL);
+    }
+
+    (void)xTaskResumeAll();
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Wake up counters and wake-to-first-frame latency.
+ *-----------------------------------------------------------------------------
+ */
+const CanPn_StatsType *CanPn_GetStats(void)
+{
+    return &s_canPnStats;
+}
@@ -0,0 +1,49 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file can_pn.h
+ * @brief Pretended Networking low power mode woken by CAN frames
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _CAN_PN_H_
+#define _CAN_PN_H_
+
+#include "Rte_Type.h"
+#include "Cpu.h"
+#include "can_filter.h"
+
+/* Macro Define -------------------------------------------------------------*/
+/* Let vCanApp drop into VLPS after CAN_PN_IDLE_TIMEOUT_MS without a wake frame */
+#define CAN_PN_ENABLED              (0U)
+#define CAN_PN_IDLE_TIMEOUT_MS      (5000U)
+
+/* Power modes needed in SMC_PMPROT, written once by the power boot step */
+#define CAN_PN_PMPROT               ((CAN_PN_ENABLED != 0U) ? SMC_PMPROT_AVLP_MASK : 0U)
+
+#define CAN_PN_MAX_WAKE_IDS         (8U)
+#define CAN_PN_NUM_WMB              (4U)    /* Wake up message buffers of CAN0 */
+
+/* Type Define --------------------------------------------------------------*/
+typedef struct
+{
+    uint32 wakeUps;             /* Resumes with at least one wake frame */
+    uint32 spuriousWakeUps;     /* Matched the PN mask but no frame in the list */
+    uint32 lastLatencyCycles;   /* Core resume to waking frame delivered */
+    uint32 maxLatencyCycles;
+} CanPn_StatsType;
+
+/* Import Parameters --------------------------------------------------------*/
+extern const uint32 g_CanPnWakeIds[];
+extern const uint8 g_CanPnNumWakeIds;
+
+/* Export Parameters --------------------------------------------------------*/
+extern status_t CanPn_Init(const can_instance_t * const instance);
+extern status_t CanPn_Sleep(void);
+extern const CanPn_StatsType *CanPn_GetStats(void);
+
+#endif
@@ -0,0 +1,22 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file can_pn_cfg.c
+ * @brief Frames that wake the ECU from the Pretended Networking mode
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "can_pn.h"
+#include "can_app.h"
+
+/* Export Parameters --------------------------------------------------------*/
+const uint32 g_CanPnWakeIds[] =
+{
+    RX_MSG_ID,      /* LED command */
+};
+
+const uint8 g_CanPnNumWakeIds = (uint8)(sizeof(g_CanPnWakeIds) / sizeof(g_CanPnWakeIds[0]));
@@ -0,0 +1,431 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file can_trace.c
+ * @brief CAN frame capture into a binary ring, UART flush and replay
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * Received frames are recorded from the can_filter Rx complete path. A
+ * transmitted frame is announced by its sender once the mailbox is loaded
+ * and recorded when the Tx complete event of that mailbox arrives, so both
+ * directions carry the time the frame was actually on the bus. The
+ * completion may run before the announcement if the sender is preempted,
+ * each Tx mailbox slot therefore remembers which of the two came first.
+ *
+ * Records keep the IDE bit, an extended ID below 0x800 stays extended in
+ * the exports and in the replay.
+ *
+ * Records are 16 bytes and go into a ring that is emptied over LPUART1 in
+ * packets starting with CAN_TRACE_MAGIC. When the ring is full new records
+ * are dropped and counted in the next packet header. Tools/can_trace.py
+ * converts the packets to candump/ASC and back.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "can_trace.h"
+#include "can_filter.h"
+#include "cycle_counter.h"
+#include "interrupt_manager.h"
+#include "boot_seq.h"
+#include "task.h"
+#include "string.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define CAN_TRACE_FLUSH_PERIOD_MS   (100U)
+#define CAN_TRACE_UART_TIMEOUT_MS   (100U)
+/* IDE bit of a FlexCAN mailbox CS word, as copied to can_message_t.cs */
+#define CAN_TRACE_CS_IDE            (1UL << 21U)
+/* 32 bit words per mailbox, 8 data bytes like the records */
+#define CAN_TRACE_MB_WORDS          (4U)
+
+/* Type Define --------------------------------------------------------------*/
+typedef enum
+{
+    CanTrace_TxIdle = 0u,
+    CanTrace_TxPending,         /* Announced, waiting for Tx complete */
+    CanTrace_TxCompleted        /* Tx complete arrived before the announcement */
+} CanTrace_TxSlotStateType;
+
+typedef struct
+{
+    CanTrace_RecordType record;
+    CanTrace_TxSlotStateType state;
+    uint32 completeUs;
+} CanTrace_TxSlotType;
+
+typedef struct
+{
+    uint8 raw[sizeof(CanTrace_PacketHeaderType) + (CAN_TRACE_FLUSH_MAX * sizeof(CanTrace_RecordType))];
+} CanTrace_PacketType;
+
+/* Local Parameters ---------------------------------------------------------*/
+static CanTrace_RecordType s_ring[CAN_TRACE_RING_LEN];
+static volatile uint32 s_head;
+static volatile uint32 s_tail;
+static volatile uint16 s_lost;
+static volatile boolean s_capturing = false;
+
+static CanTrace_TxSlotType s_txSlot[CAN_INSTANCE_COUNT][CAN_TRACE_MAX_TX_MB];
+static CAN_Type * const s_canBases[CAN_INSTANCE_COUNT] = CAN_BASE_PTRS;
+
+/* Microsecond clock extended from the cycle counter on every record */
+static uint32 s_usClock;
+static uint32 s_lastCycles;
+static uint32 s_cycleRemainder;
+
+static CanTrace_PacketType s_packet;
+
+/* Local Functions ----------------------------------------------------------*/
+/* Must be called with interrupts disabled, the counter must not be left
+ * without a record for more than 2^32 cycles */
+static uint32 CanTrace_NowUs(void)
+{
+    uint32 now = CycleCounter_Get();
+    uint32 elapsed = (now - s_lastCycles) + s_cycleRemainder;
+
+    s_lastCycles = now;
+    s_usClock += elapsed / CYCLES_PER_US;
+    s_cycleRemainder = elapsed % CYCLES_PER_US;
+
+    return s_usClock;
+}
+
+static void CanTrace_Fill(CanTrace_RecordType *record, uint32 instance, boolean tx,
+                          const can_message_t *msg, uint32 cs)
+{
+    uint32 length = (msg->length > 8u) ? 8u : msg->length;
+
+    record->stamp = length << CAN_TRACE_DLC_SHIFT;
+    if ((cs & CAN_TRACE_CS_IDE) != 0u)
+    {
+        record->stamp |= CAN_TRACE_IDE_FLAG;
+    }
+    record->id = (msg->id & CAN_TRACE_ID_MASK) | (instance << CAN_TRACE_BUS_SHIFT);
+    if (tx == true)
+    {
+        record->id |= CAN_TRACE_TX_FLAG;
+    }
+    memcpy(record->data, msg->data, sizeof(record->data));
+}
+
+/* Must be called with interrupts disabled */
+static void CanTrace_Commit(const CanTrace_RecordType *record, uint32 timeUs)
+{
+    CanTrace_RecordType *slot;
+
+    if ((s_head - s_tail) >= CAN_TRACE_RING_LEN)
+    {
+        if (s_lost < 0xFFFFu)
+        {
+            s_lost++;
+        }
+        return;
+    }
+
+    slot = &s_ring[s_head & (CAN_TRACE_RING_LEN - 1u)];
+    *slot = *record;
+    slot->stamp = (slot->stamp & ~CAN_TRACE_TIME_MASK) | (timeUs & CAN_TRACE_TIME_MASK);
+    s_head++;
+}
+
+static uint32 CanTrace_RecordTime(const CanTrace_RecordType *record)
+{
+    return record->stamp & CAN_TRACE_TIME_MASK;
+}
+
+/* Busy wait until targetUs microseconds have passed since startCycles */
+static void CanTrace_WaitUntil(uint32 startCycles, uint32 targetUs)
+{
+    uint32 elapsedUs = 0u;
+    uint32 last = startCycles;
+    uint32 remainder = 0u;
+
+    while (elapsedUs < targetUs)
+    {
+        uint32 now = CycleCounter_Get();
+        uint32 elapsed = (now - last) + remainder;
+
+        last = now;
+        elapsedUs += elapsed / CYCLES_PER_US;
+        remainder = elapsed % CYCLES_PER_US;
+    }
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Start recording, the ring keeps the records not flushed yet.
+ *-----------------------------------------------------------------------------
+ */
+void CanTrace_Start(void)
+{
+    INT_SYS_DisableIRQGlobal();
+    (void)CanTrace_NowUs();
+    memset(s_txSlot, 0, sizeof(s_txSlot));
+    s_capturing = true;
+    INT_SYS_EnableIRQGlobal();
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Stop recording.
+ *-----------------------------------------------------------------------------
+ */
+void CanTrace_Stop(void)
+{
+    s_capturing = false;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Record a received frame, called from the Rx complete path.
+ *
+ * @param instance FlexCAN instance the frame was received on
+ * @param msg received frame
+ *-----------------------------------------------------------------------------
+ */
+void CanTrace_Rx(uint32 instance, const can_message_t *msg)
+{
+    CanTrace_RecordType record;
+
+    if (s_capturing == false)
+    {
+        return;
+    }
+
+    CanTrace_Fill(&record, instance, false, msg, msg->cs);
+
+    INT_SYS_DisableIRQGlobal();
+    CanTrace_Commit(&record, CanTrace_NowUs());
+    INT_SYS_EnableIRQGlobal();
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Announce a frame loaded into a Tx mailbox.
+ *
+ * Call after CAN_Send/CAN_SendFast returned STATUS_SUCCESS, the frame is
+ * recorded when the transmission of the mailbox completes.
+ *
+ * @param instance CAN PAL instance
+ * @param buffIdx Tx buffer of the PAL the frame was loaded into
+ * @param msg frame passed to the send function
+ *-----------------------------------------------------------------------------
+ */
+void CanTrace_TxRequest(const can_instance_t * const instance, uint32 buffIdx,
+                        const can_message_t *msg)
+{
+    CanTrace_TxSlotType *slot;
+    CanTrace_RecordType record;
+    uint32 hwBuffIdx;
+
+    if ((s_capturing == false) || (buffIdx >= CAN_TRACE_MAX_TX_MB))
+    {
+        return;
+    }
+
+    /* Senders leave cs empty, the ID type is in the loaded mailbox, which
+     * comes after the Rx FIFO when it is enabled */
+    hwBuffIdx = CAN_GetHwBuffIdx(instance, buffIdx);
+    CanTrace_Fill(&record, instance->instIdx, true, msg,
+                  s_canBases[instance->instIdx]->RAMn[hwBuffIdx * CAN_TRACE_MB_WORDS]);
+    slot = &s_txSlot[instance->instIdx][buffIdx];
+
+    INT_SYS_DisableIRQGlobal();
+    if (slot->state == CanTrace_TxCompleted)
+    {
+        CanTrace_Commit(&record, slot->completeUs);
+        slot->state = CanTrace_TxIdle;
+    }
+    else
+    {
+        slot->record = record;
+        slot->state = CanTrace_TxPending;
+    }
+    INT_SYS_EnableIRQGlobal();
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Record the frame of a mailbox whose transmission completed.
+ *
+ * @param instance FlexCAN instance
+ * @param buffIdx Tx mailbox
+ *-----------------------------------------------------------------------------
+ */
+void CanTrace_TxComplete(uint32 instance, uint32 buffIdx)
+{
+    CanTrace_TxSlotType *slot;
+
+    if ((s_capturing == false) || (buffIdx >= CAN_TRACE_MAX_TX_MB))
+    {
+        return;
+    }
+
+    slot = &s_txSlot[instance][buffIdx];
+
+    INT_SYS_DisableIRQGlobal();
+    if (slot->state == CanTrace_TxPending)
+    {
+        CanTrace_Commit(&slot->record, CanTrace_NowUs());
+        slot->state = CanTrace_TxIdle;
+    }
+    else
+    {
+        slot->completeUs = CanTrace_NowUs();
+        slot->state = CanTrace_TxCompleted;
+    }
+    INT_SYS_EnableIRQGlobal();
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Send one packet of recorded frames over LPUART1.
+ *
+ * Records are only removed from the ring once the packet was sent.
+ *
+ * @return STATUS_SUCCESS (also when the ring is empty), or the LPUART error
+ *-----------------------------------------------------------------------------
+ */
+status_t CanTrace_Flush(void)
+{
+    CanTrace_PacketHeaderType header;
+    status_t status;
+    uint32 count, i;
+
+    count = s_head - s_tail;
+    if (count == 0u)
+    {
+        return STATUS_SUCCESS;
+    }
+    if (count > CAN_TRACE_FLUSH_MAX)
+    {
+        count = CAN_TRACE_FLUSH_MAX;
+    }
+
+    for (i = 0u; i < count; i++)
+    {
+        memcpy(&s_packet.raw[sizeof(header) + (i * sizeof(CanTrace_RecordType))],
+               &s_ring[(s_tail + i) & (CAN_TRACE_RING_LEN - 1u)],
+               sizeof(CanTrace_RecordType));
+    }
+
+    header.magic = CAN_TRACE_MAGIC;
+    header.numRecords = (uint16)count;
+    header.lostRecords = s_lost;
+    memcpy(s_packet.raw, &header, sizeof(header));
+
+    status = LPUART_DRV_SendDataBlocking(INST_LPUART1, s_packet.raw,
+                                         sizeof(header) + (count * sizeof(CanTrace_RecordType)),
+                                         CAN_TRACE_UART_TIMEOUT_MS);
+    if (status == STATUS_SUCCESS)
+    {
+        INT_SYS_DisableIRQGlobal();
+        s_tail += count;
+        s_lost -= header.lostRecords;
+        INT_SYS_EnableIRQGlobal();
+    }
+
+    return status;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Feed the received frames of a trace through the Rx dispatch.
+ *
+ * Frames go through CanFilter_InjectRx exactly as the Rx complete ISR
+ * delivers them, with interrupts disabled so the notifications see the same
+ * context as on the bus. Transmitted frames of the trace are skipped. Runs
+ * in the calling task and busy waits in real time mode, for lab use only.
+ *
+ * @param trace records as produced by CanTrace_Flush / Tools/can_trace.py
+ * @param numRecords number of records in trace
+ * @param realTime true: keep the recorded spacing, false: back to back
+ * @param result dispatch cost of the injected frames
+ *-----------------------------------------------------------------------------
+ */
+void CanTrace_Replay(const CanTrace_RecordType *trace,
+                     uint32 numRecords,
+                     boolean realTime,
+                     CanTrace_ReplayResultType *result)
+{
+    boolean wasCapturing = s_capturing;
+    uint32 startCycles = CycleCounter_Get();
+    uint32 offsetUs = 0u;
+    uint32 i;
+
+    DEV_ASSERT((trace != NULL) && (result != NULL));
+
+    /* Injected frames must not end up in the trace again */
+    s_capturing = false;
+    memset(result, 0, sizeof(*result));
+
+    for (i = 0u; i < numRecords; i++)
+    {
+        const CanTrace_RecordType *record = &trace[i];
+        can_message_t msg;
+        uint32 cycles;
+
+        if (i > 0u)
+        {
+            offsetUs += (CanTrace_RecordTime(record) - CanTrace_RecordTime(&trace[i - 1u])) & CAN_TRACE_TIME_MASK;
+        }
+
+        if ((record->id & CAN_TRACE_TX_FLAG) != 0u)
+        {
+            continue;
+        }
+
+        if (realTime == true)
+        {
+            CanTrace_WaitUntil(startCycles, offsetUs);
+        }
+
+        msg.cs = ((record->stamp & CAN_TRACE_IDE_FLAG) != 0u) ? CAN_TRACE_CS_IDE : 0u;
+        msg.id = record->id & CAN_TRACE_ID_MASK;
+        msg.length = (uint8)(record->stamp >> CAN_TRACE_DLC_SHIFT);
+        memcpy(msg.data, record->data, sizeof(record->data));
+
+        INT_SYS_DisableIRQGlobal();
+        cycles = CycleCounter_Get();
+        CanFilter_InjectRx(record->id >> CAN_TRACE_BUS_SHIFT, &msg);
+        cycles = CycleCounter_Get() - cycles;
+        INT_SYS_EnableIRQGlobal();
+
+        result->frames++;
+        result->totalCycles += cycles;
+        if (cycles > result->maxCycles)
+        {
+            result->maxCycles = cycles;
+        }
+    }
+
+    s_capturing = wasCapturing;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Capture task, records all traffic and streams it over LPUART1.
+ *-----------------------------------------------------------------------------
+ */
+void vCanTraceFlush(void *pvParameters)
+{
+    TickType_t xNextWakeTime;
+    /* Casting pvParameters to void because it is unused */
+    (void)pvParameters;
+
+    (void)BootSeq_Require(BOOT_SEQ_BIT(BOOT_STEP_UART), portMAX_DELAY);
+    CanTrace_Start();
+
+    xNextWakeTime = xTaskGetTickCount();
+    for( ;; )
+    {
+        /* Empty the ring, a failed packet is sent again next period */
+        while ((s_head != s_tail) && (CanTrace_Flush() == STATUS_SUCCESS))
+        {
+        }
+        vTaskDelayUntil(&xNextWakeTime, pdMS_TO_TICKS(CAN_TRACE_FLUSH_PERIOD_MS));
+    }
+}
@@ -0,0 +1,76 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file can_trace.h
+ * @brief CAN frame capture into a binary ring, UART flush and replay
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _CAN_TRACE_H_
+#define _CAN_TRACE_H_
+
+#include "Rte_Type.h"
+#include "Cpu.h"
+#include "lpuart1.h"
+
+/* Macro Define -------------------------------------------------------------*/
+/* The flush shares LPUART1 with print(), enable for field captures only */
+#define CAN_TRACE_ENABLED           (0U)
+
+#define CAN_TRACE_RING_LEN          (256U)  /* Records, must be a power of two */
+#define CAN_TRACE_FLUSH_MAX         (32U)   /* Records sent per UART packet */
+#define CAN_TRACE_MAX_TX_MB         (8U)    /* Tx mailboxes with a pending record */
+
+/* Packet header on the UART, little endian "CTRC" */
+#define CAN_TRACE_MAGIC             (0x43525443UL)
+
+/* Record field layout, shared with Tools/can_trace.py. The ID word has no
+ * spare bit, the IDE flag takes the top bit of the time instead */
+#define CAN_TRACE_TIME_MASK         (0x07FFFFFFUL)  /* Microseconds, wraps */
+#define CAN_TRACE_IDE_FLAG          (1UL << 27U)    /* Extended ID */
+#define CAN_TRACE_DLC_SHIFT         (28U)
+#define CAN_TRACE_ID_MASK           (0x1FFFFFFFUL)
+#define CAN_TRACE_TX_FLAG           (1UL << 29U)
+#define CAN_TRACE_BUS_SHIFT         (30U)
+
+/* Type Define --------------------------------------------------------------*/
+typedef struct
+{
+    uint32 stamp;       /* [26:0] time in us, [27] IDE, [31:28] DLC */
+    uint32 id;          /* [28:0] CAN ID, [29] Tx, [31:30] FlexCAN instance */
+    uint8 data[8];
+} CanTrace_RecordType;
+
+typedef struct
+{
+    uint32 magic;
+    uint16 numRecords;
+    uint16 lostRecords; /* Ring overflows since the previous packet */
+} CanTrace_PacketHeaderType;
+
+typedef struct
+{
+    uint32 frames;
+    uint32 totalCycles; /* Spent in the Rx dispatch of the injected frames */
+    uint32 maxCycles;
+} CanTrace_ReplayResultType;
+
+/* Export Parameters --------------------------------------------------------*/
+extern void CanTrace_Start(void);
+extern void CanTrace_Stop(void);
+extern void CanTrace_Rx(uint32 instance, const can_message_t *msg);
+extern void CanTrace_TxRequest(const can_instance_t * const instance, uint32 buffIdx,
+                               const can_message_t *msg);
+extern void CanTrace_TxComplete(uint32 instance, uint32 buffIdx);
+extern status_t CanTrace_Flush(void);
+extern void CanTrace_Replay(const CanTrace_RecordType *trace,
+                            uint32 numRecords,
+                            boolean realTime,
+                            CanTrace_ReplayResultType *result);
+extern void vCanTraceFlush(void *pvParameters);
+
+#endif
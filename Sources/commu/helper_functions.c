@@ -46,4 +46,35 @@ void floatToStr(const float *srcValue, char *destStr, uint8_t maxLen)
         tempVal *= 10;
     }
     *destStr = 0;
+}
+
+/***********************************
+ * @brief: Convert a value in thousandths to null terminated char array,
+ *         e.g. 4995 -> "4.995", without floating point
+ * @param milli:     source value in thousandths
+ * @param destStr:   pointer to the destination string, at least 12 chars
+ ***********************************/
+void milliToStr(uint32_t milli, char *destStr)
+{
+    char digits[10];
+    uint32_t whole = milli / 1000u;
+    uint32_t frac = milli % 1000u;
+    uint8_t n = 0, i;
+
+    do
+    {
+        digits[n++] = (char)('0' + (whole % 10u));
+        whole /= 10u;
+    } while (whole != 0u);
+    while (n > 0u)
+    {
+        *destStr++ = digits[--n];
+    }
+    *destStr++ = '.';
+    for (i = 0; i < 3u; i++)
+    {
+        destStr[2u - i] = (char)('0' + (frac % 10u));
+        frac /= 10u;
+    }
+    destStr[3] = 0;
 }
\ No newline at end of file
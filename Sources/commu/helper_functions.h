@@ -17,5 +17,6 @@
 #include "stdbool.h"
 
 void floatToStr(const float *srcValue, char *destStr, uint8_t maxLen);
+void milliToStr(uint32_t milli, char *destStr);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,481 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file spi_queue.c
+ * @brief LPSPI master transaction queue: a list of transactions run back to
+ *        back by eDMA scatter/gather, one callback at the end
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * Two channels of the DMA manager per instance, on the LPSPI TX and RX
+ * requests. The TX chain writes, for every transaction, its command word
+ * to TCR and then its frames to TDR; command words go through the transmit
+ * FIFO, so the chip select and frame size change exactly between the frames
+ * of the two transactions. Every transaction runs with CONT set: the chip
+ * select stays asserted between its frames and is negated by the command
+ * word of the next one, unless that one continues it (keepPcs, CONTC). The
+ * chain ends with the TCR value found at the start, which negates the last
+ * chip select and leaves the SDK driver its own configuration.
+ *
+ * The RX chain reads every frame, into a sink when rx is NULL, and only its
+ * last TCD raises an interrupt: the callback runs once, when the last frame
+ * has been received. Nothing runs on the CPU between the frames.
+ *
+ * The queue drives the LPSPI registers itself. SpiQueue_Start refuses to
+ * run while an SDK transfer is in progress, but callers sharing the
+ * instance with other users (the SBC service on LPSPI1) still have to
+ * arbitrate, e.g. with SbcSvc_Lock.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "spi_queue.h"
+#include "dma_mgr.h"
+#include "FreeRTOS.h"
+#include "interrupt_manager.h"
+#include "string.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define SPI_QUEUE_TX_WATER          (2U)    /* As the SDK DMA transfers */
+
+#define SPI_QUEUE_TCR_XFER_MASK     (LPSPI_TCR_PCS_MASK | LPSPI_TCR_FRAMESZ_MASK | LPSPI_TCR_CONT_MASK | \
+                                     LPSPI_TCR_CONTC_MASK | LPSPI_TCR_RXMSK_MASK | LPSPI_TCR_TXMSK_MASK)
+
+#define SPI_QUEUE_SR_W1C            (LPSPI_SR_WCF_MASK | LPSPI_SR_FCF_MASK | LPSPI_SR_TCF_MASK | \
+                                     LPSPI_SR_TEF_MASK | LPSPI_SR_REF_MASK | LPSPI_SR_DMF_MASK)
+
+/* Type Define --------------------------------------------------------------*/
+typedef struct
+{
+    LPSPI_Type *base;
+    uint8 txChannel;
+    uint8 rxChannel;
+    volatile boolean busy;
+    uint8 count;
+    edma_software_tcd_t *stcd;
+    uint32 tcr[SPI_QUEUE_MAX_XFERS + 1u];   /* Command words, then the restored TCR */
+    SpiQueue_CallbackType callback;
+    void *param;
+} SpiQueue_StateType;
+
+/* A scatter/gather chain being built, its first TCD is the channel's own */
+typedef struct
+{
+    uint8 channel;
+    uint8 count;
+    edma_software_tcd_t *next;      /* Next free software TCD */
+    edma_software_tcd_t *last;      /* NULL while the last TCD is the channel's own */
+} SpiQueue_ChainType;
+
+/* Local Parameters ---------------------------------------------------------*/
+static SpiQueue_StateType s_spiQueue[LPSPI_INSTANCE_COUNT];
+
+static const uint32 s_spiQueueTxFill = SPI_QUEUE_TX_FILL;
+static uint32 s_spiQueueRxSink;
+
+static SpiQueue_StatsType s_spiQueueStats;
+
+/* Local Functions ----------------------------------------------------------*/
+static uint8 SpiQueue_Width(uint8 frameBits)
+{
+    if (frameBits <= 8u)
+    {
+        return 1u;
+    }
+    if (frameBits <= 16u)
+    {
+        return 2u;
+    }
+    return 4u;      /* The eDMA has no 3 bytes transfer size */
+}
+
+static edma_transfer_size_t SpiQueue_Size(uint8 width)
+{
+    if (width == 4u)
+    {
+        return EDMA_TRANSFER_SIZE_4B;
+    }
+    if (width == 2u)
+    {
+        return EDMA_TRANSFER_SIZE_2B;
+    }
+    return EDMA_TRANSFER_SIZE_1B;
+}
+
+/* Append a TCD moving count elements of width bytes, one per request */
+static void SpiQueue_ChainAdd(SpiQueue_ChainType *chain, uint32 src, boolean srcInc,
+                              uint32 dst, boolean dstInc, uint8 width, uint16 count)
+{
+    edma_transfer_size_t size = SpiQueue_Size(width);
+
+    if (chain->count == 0u)
+    {
+        edma_transfer_type_t type = EDMA_TRANSFER_PERIPH2PERIPH;
+
+        if (srcInc == true)
+        {
+            type = EDMA_TRANSFER_MEM2PERIPH;
+        }
+        else if (dstInc == true)
+        {
+            type = EDMA_TRANSFER_PERIPH2MEM;
+        }
+
+        /* Also clears the error status an aborted sequence left on the channel */
+        (void)EDMA_DRV_ConfigMultiBlockTransfer(chain->channel, type, src, dst, size, width, count, false);
+        EDMA_DRV_ConfigureInterrupt(chain->channel, EDMA_CHN_MAJOR_LOOP_INT, false);
+    }
+    else
+    {
+        edma_loop_transfer_config_t loop;
+        edma_transfer_config_t transfer;
+
+        memset(&loop, 0, sizeof(loop));
+        loop.majorLoopIterationCount = count;
+
+        memset(&transfer, 0, sizeof(transfer));
+        transfer.srcAddr = src;
+        transfer.destAddr = dst;
+        transfer.srcTransferSize = size;
+        transfer.destTransferSize = size;
+        transfer.srcOffset = (srcInc == true) ? (sint16)width : 0;
+        transfer.destOffset = (dstInc == true) ? (sint16)width : 0;
+        transfer.srcModulo = EDMA_MODULO_OFF;
+        transfer.destModulo = EDMA_MODULO_OFF;
+        transfer.minorByteTransferCount = width;
+        transfer.scatterGatherEnable = false;
+        transfer.interruptEnable = false;
+        transfer.loopTransferConfig = &loop;
+        EDMA_DRV_PushConfigToSTCD(&transfer, chain->next);
+
+        /* Link the previous TCD to this one */
+        if (chain->last == NULL)
+        {
+            EDMA_DRV_SetScatterGatherLink(chain->channel, (uint32)chain->next);
+            DMA->TCD[FEATURE_DMA_VCH_TO_CH(chain->channel)].CSR |= DMA_TCD_CSR_ESG_MASK;
+        }
+        else
+        {
+            chain->last->DLAST_SGA = (sint32)(uint32)chain->next;
+            chain->last->CSR |= DMA_TCD_CSR_ESG_MASK;
+        }
+        chain->last = chain->next;
+        chain->next++;
+    }
+    chain->count++;
+}
+
+/* The last TCD stops the channel requests, and may raise the interrupt */
+static void SpiQueue_ChainEnd(const SpiQueue_ChainType *chain, boolean interrupt)
+{
+    if (chain->last == NULL)
+    {
+        EDMA_DRV_DisableRequestsOnTransferComplete(chain->channel, true);
+        EDMA_DRV_ConfigureInterrupt(chain->channel, EDMA_CHN_MAJOR_LOOP_INT, interrupt);
+    }
+    else
+    {
+        chain->last->CSR |= DMA_TCD_CSR_DREQ_MASK;
+        if (interrupt == true)
+        {
+            chain->last->CSR |= DMA_TCD_CSR_INTMAJOR_MASK;
+        }
+    }
+}
+
+static void SpiQueue_FlushFifos(LPSPI_Type *base)
+{
+    /* Twice, a word may still be in the shifter */
+    base->CR |= LPSPI_CR_RTF_MASK | LPSPI_CR_RRF_MASK;
+    base->CR |= LPSPI_CR_RTF_MASK | LPSPI_CR_RRF_MASK;
+}
+
+/* Stop both channels and negate the chip select */
+static void SpiQueue_Stop(SpiQueue_StateType *queue)
+{
+    queue->base->DER = 0u;
+    (void)EDMA_DRV_StopChannel(queue->txChannel);
+    (void)EDMA_DRV_StopChannel(queue->rxChannel);
+    SpiQueue_FlushFifos(queue->base);
+    queue->base->TCR = queue->tcr[queue->count];
+}
+
+static void SpiQueue_Finish(SpiQueue_StateType *queue, status_t status)
+{
+    queue->base->DER = 0u;
+    DmaMgr_FreeStcd(queue->stcd, (uint8)(3u * queue->count - 1u));
+    queue->busy = false;
+
+    if (queue->callback != NULL)
+    {
+        queue->callback(queue->param, status);
+    }
+}
+
+static void SpiQueue_DmaCallback(void *parameter, edma_chn_status_t status)
+{
+    SpiQueue_StateType *queue = (SpiQueue_StateType *)parameter;
+
+    /* The other channel failing after the sequence was stopped */
+    if (queue->busy == false)
+    {
+        return;
+    }
+
+    if (status == EDMA_CHN_ERROR)
+    {
+        SpiQueue_Stop(queue);
+        s_spiQueueStats.errors++;
+        SpiQueue_Finish(queue, STATUS_ERROR);
+    }
+    else
+    {
+        /* Only the last RX TCD raises the interrupt */
+        SpiQueue_Finish(queue, STATUS_SUCCESS);
+    }
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Take the TX and RX eDMA channels of an LPSPI master instance.
+ *
+ * Call after LPSPI_DRV_MasterInit and DmaMgr_Init. The instance keeps its
+ * SDK configuration (baud rate, polarity, delays), the queue only changes
+ * the chip select and frame size of each transaction.
+ *
+ * @param instance LPSPI instance
+ * @return STATUS_SUCCESS, or the error of the channel allocation
+ *-----------------------------------------------------------------------------
+ */
+status_t SpiQueue_Init(uint32 instance)
+{
+    static LPSPI_Type * const bases[LPSPI_INSTANCE_COUNT] = LPSPI_BASE_PTRS;
+    static const dma_request_source_t rxSources[LPSPI_INSTANCE_COUNT] =
+    {
+        EDMA_REQ_LPSPI0_RX, EDMA_REQ_LPSPI1_RX, EDMA_REQ_LPSPI2_RX
+    };
+    static const dma_request_source_t txSources[LPSPI_INSTANCE_COUNT] =
+    {
+        EDMA_REQ_LPSPI0_TX, EDMA_REQ_LPSPI1_TX, EDMA_REQ_LPSPI2_TX
+    };
+    SpiQueue_StateType *queue;
+    DmaMgr_ChannelReqType req;
+    status_t status;
+
+    DEV_ASSERT(instance < LPSPI_INSTANCE_COUNT);
+    DEV_ASSERT((3u * SPI_QUEUE_MAX_XFERS - 1u) <= DMA_MGR_STCD_POOL_SIZE);
+
+    queue = &s_spiQueue[instance];
+    DEV_ASSERT(queue->base == NULL);
+
+    req.source = rxSources[instance];
+    req.priority = SPI_QUEUE_RX_PRIORITY;
+    req.preemptible = false;
+    req.canPreempt = true;
+    req.callback = SpiQueue_DmaCallback;
+    req.callbackParam = queue;
+    status = DmaMgr_Alloc(&req, &queue->rxChannel);
+    if (status != STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    /* Its interrupt only reports errors */
+    req.source = txSources[instance];
+    req.priority = SPI_QUEUE_TX_PRIORITY;
+    status = DmaMgr_Alloc(&req, &queue->txChannel);
+    if (status != STATUS_SUCCESS)
+    {
+        (void)DmaMgr_Free(queue->rxChannel);
+        return status;
+    }
+
+    /* The callbacks may use the FreeRTOS FromISR API */
+    INT_SYS_SetPriority((IRQn_Type)((uint32)DMA0_IRQn + queue->rxChannel),
+                        configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+    INT_SYS_SetPriority((IRQn_Type)((uint32)DMA0_IRQn + queue->txChannel),
+                        configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+
+    queue->busy = false;
+    queue->base = bases[instance];
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Run a list of transactions back to back.
+ *
+ * The descriptors are only read here, the buffers must stay valid until
+ * the callback. tx and rx are aligned to the frame width in memory.
+ *
+ * @param instance LPSPI instance, set up by SpiQueue_Init
+ * @param xfers Transactions, in bus order
+ * @param count 1 .. SPI_QUEUE_MAX_XFERS
+ * @param callback Called from the eDMA interrupt with the result, may be NULL
+ * @param param Passed to the callback
+ * @return STATUS_SUCCESS, or STATUS_BUSY when the bus is in use or the
+ *         software TCDs are exhausted
+ *-----------------------------------------------------------------------------
+ */
+status_t SpiQueue_Start(uint32 instance, const SpiQueue_XferType *xfers, uint8 count,
+                        SpiQueue_CallbackType callback, void *param)
+{
+    SpiQueue_StateType *queue;
+    SpiQueue_ChainType txChain;
+    SpiQueue_ChainType rxChain;
+    edma_software_tcd_t *stcd;
+    uint32 tcr;
+    uint32 frames = 0u;
+    uint8 i;
+
+    DEV_ASSERT(instance < LPSPI_INSTANCE_COUNT);
+    DEV_ASSERT((xfers != NULL) && (count > 0u) && (count <= SPI_QUEUE_MAX_XFERS));
+
+    queue = &s_spiQueue[instance];
+    DEV_ASSERT(queue->base != NULL);
+
+    INT_SYS_DisableIRQGlobal();
+    if ((queue->busy == true) ||
+        (LPSPI_DRV_MasterGetTransferStatus(instance, NULL) == STATUS_BUSY) ||
+        ((queue->base->SR & LPSPI_SR_MBF_MASK) != 0u))
+    {
+        s_spiQueueStats.busy++;
+        INT_SYS_EnableIRQGlobal();
+        return STATUS_BUSY;
+    }
+    queue->busy = true;
+    INT_SYS_EnableIRQGlobal();
+
+    /* TX: 2n + 1 TCDs, RX: n, the first of each chain is the channel's own */
+    stcd = DmaMgr_AllocStcd((uint8)(3u * count - 1u));
+    if (stcd == NULL)
+    {
+        s_spiQueueStats.busy++;
+        queue->busy = false;
+        return STATUS_BUSY;
+    }
+
+    queue->stcd = stcd;
+    queue->count = count;
+    queue->callback = callback;
+    queue->param = param;
+
+    txChain.channel = queue->txChannel;
+    txChain.count = 0u;
+    txChain.next = stcd;
+    txChain.last = NULL;
+    rxChain.channel = queue->rxChannel;
+    rxChain.count = 0u;
+    rxChain.next = &stcd[2u * count];
+    rxChain.last = NULL;
+
+    tcr = queue->base->TCR;
+    queue->tcr[count] = tcr & ~LPSPI_TCR_CONTC_MASK;
+    tcr &= ~SPI_QUEUE_TCR_XFER_MASK;
+
+    for (i = 0u; i < count; i++)
+    {
+        const SpiQueue_XferType *xfer = &xfers[i];
+        uint8 width = SpiQueue_Width(xfer->frameBits);
+
+        DEV_ASSERT(xfer->pcs <= 3u);
+        DEV_ASSERT((xfer->frameBits >= 8u) && (xfer->frameBits <= 32u));
+        DEV_ASSERT((xfer->frames > 0u) && (xfer->frames <= SPI_QUEUE_MAX_FRAMES));
+        DEV_ASSERT((((uint32)xfer->tx | (uint32)xfer->rx) & (width - 1u)) == 0u);
+        DEV_ASSERT((xfer->keepPcs == false) || ((i > 0u) && (xfers[i - 1u].pcs == xfer->pcs)));
+
+        queue->tcr[i] = tcr | LPSPI_TCR_PCS(xfer->pcs) | LPSPI_TCR_FRAMESZ(xfer->frameBits - 1u) |
+                        LPSPI_TCR_CONT_MASK | ((xfer->keepPcs == true) ? LPSPI_TCR_CONTC_MASK : 0u);
+
+        SpiQueue_ChainAdd(&txChain, (uint32)&queue->tcr[i], true, (uint32)&queue->base->TCR, false, 4u, 1u);
+        if (xfer->tx != NULL)
+        {
+            SpiQueue_ChainAdd(&txChain, (uint32)xfer->tx, true, (uint32)&queue->base->TDR, false,
+                              width, xfer->frames);
+        }
+        else
+        {
+            SpiQueue_ChainAdd(&txChain, (uint32)&s_spiQueueTxFill, false, (uint32)&queue->base->TDR, false,
+                              width, xfer->frames);
+        }
+        if (xfer->rx != NULL)
+        {
+            SpiQueue_ChainAdd(&rxChain, (uint32)&queue->base->RDR, false, (uint32)xfer->rx, true,
+                              width, xfer->frames);
+        }
+        else
+        {
+            SpiQueue_ChainAdd(&rxChain, (uint32)&queue->base->RDR, false, (uint32)&s_spiQueueRxSink, false,
+                              width, xfer->frames);
+        }
+        frames += xfer->frames;
+    }
+    SpiQueue_ChainAdd(&txChain, (uint32)&queue->tcr[count], true, (uint32)&queue->base->TCR, false, 4u, 1u);
+    SpiQueue_ChainEnd(&txChain, false);
+    SpiQueue_ChainEnd(&rxChain, true);
+
+    SpiQueue_FlushFifos(queue->base);
+    queue->base->SR = SPI_QUEUE_SR_W1C;
+    queue->base->FCR = LPSPI_FCR_TXWATER(SPI_QUEUE_TX_WATER) | LPSPI_FCR_RXWATER(0u);
+
+    INT_SYS_DisableIRQGlobal();
+    s_spiQueueStats.sequences++;
+    s_spiQueueStats.transactions += count;
+    s_spiQueueStats.frames += frames;
+    INT_SYS_EnableIRQGlobal();
+
+    (void)EDMA_DRV_StartChannel(queue->rxChannel);
+    (void)EDMA_DRV_StartChannel(queue->txChannel);
+    queue->base->DER = LPSPI_DER_TDDE_MASK | LPSPI_DER_RDDE_MASK;
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Stop the running sequence, its callback gets STATUS_SPI_ABORTED.
+ *-----------------------------------------------------------------------------
+ */
+void SpiQueue_Abort(uint32 instance)
+{
+    SpiQueue_StateType *queue;
+
+    DEV_ASSERT(instance < LPSPI_INSTANCE_COUNT);
+    queue = &s_spiQueue[instance];
+
+    INT_SYS_DisableIRQGlobal();
+    if (queue->busy == true)
+    {
+        SpiQueue_Stop(queue);
+        SpiQueue_Finish(queue, STATUS_SPI_ABORTED);
+    }
+    INT_SYS_EnableIRQGlobal();
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief A sequence is running on the instance.
+ *-----------------------------------------------------------------------------
+ */
+boolean SpiQueue_IsBusy(uint32 instance)
+{
+    DEV_ASSERT(instance < LPSPI_INSTANCE_COUNT);
+
+    return s_spiQueue[instance].busy;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Sequence and error counters.
+ *
+ * @param stats Copy of the counters
+ *-----------------------------------------------------------------------------
+ */
+void SpiQueue_GetStats(SpiQueue_StatsType *stats)
+{
+    INT_SYS_DisableIRQGlobal();
+    *stats = s_spiQueueStats;
+    INT_SYS_EnableIRQGlobal();
+}
@@ -0,0 +1,64 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file spi_queue.h
+ * @brief LPSPI master transaction queue: a list of transactions run back to
+ *        back by eDMA scatter/gather, one callback at the end
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _SPI_QUEUE_H_
+#define _SPI_QUEUE_H_
+
+#include "Rte_Type.h"
+#include "Cpu.h"
+
+/* Macro Define -------------------------------------------------------------*/
+/* Set up the queue on lpspiCom1 in the BOOT_STEP_SPI_QUEUE boot step */
+#define SPI_QUEUE_ENABLED           (0U)
+
+/* A queue of n transactions takes 3n - 1 software TCDs from the DMA manager */
+#define SPI_QUEUE_MAX_XFERS         (6U)
+#define SPI_QUEUE_MAX_FRAMES        (0x7FFFU)   /* CITER without channel link */
+
+#define SPI_QUEUE_TX_FILL           (0xFFFFFFFFUL)  /* Sent when tx is NULL */
+
+#define SPI_QUEUE_RX_PRIORITY       (13U)
+#define SPI_QUEUE_TX_PRIORITY       (12U)
+
+/* Type Define --------------------------------------------------------------*/
+typedef struct
+{
+    uint8 pcs;                      /* 0 .. 3 */
+    uint8 frameBits;                /* 8 .. 32, frames of 1, 2 or 4 bytes in memory */
+    boolean keepPcs;                /* Continue the previous transaction, same pcs */
+    uint16 frames;
+    const void *tx;                 /* NULL: send SPI_QUEUE_TX_FILL */
+    void *rx;                       /* NULL: discard */
+} SpiQueue_XferType;
+
+/* Called from the eDMA interrupt once the last frame is received */
+typedef void (*SpiQueue_CallbackType)(void *param, status_t status);
+
+typedef struct
+{
+    uint32 sequences;
+    uint32 transactions;
+    uint32 frames;
+    uint32 busy;                    /* Bus in use or no free software TCDs */
+    uint32 errors;
+} SpiQueue_StatsType;
+
+/* Export Parameters --------------------------------------------------------*/
+extern status_t SpiQueue_Init(uint32 instance);
+extern status_t SpiQueue_Start(uint32 instance, const SpiQueue_XferType *xfers, uint8 count,
+                               SpiQueue_CallbackType callback, void *param);
+extern void SpiQueue_Abort(uint32 instance);
+extern boolean SpiQueue_IsBusy(uint32 instance);
+extern void SpiQueue_GetStats(SpiQueue_StatsType *stats);
+
+#endif
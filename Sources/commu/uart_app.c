@@ -11,6 +11,26 @@
  *-----------------------------------------------------------------------------
  */
 #include "uart_app.h"
+#include "cycle_counter.h"
+#include "interrupt_manager.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define UART_APP_MEASURE_TIMEOUT_MS     (1000U)
+
+/* Local Parameters ---------------------------------------------------------*/
+static isr_t s_uartAppPrevIsr = NULL;
+static volatile uint32 s_uartAppIrqs;
+static volatile uint32 s_uartAppIsrCycles;
+
+/* Local Functions ----------------------------------------------------------*/
+static void UartApp_CountingIsr(void)
+{
+    uint32 start = CycleCounter_Get();
+
+    s_uartAppPrevIsr();
+    s_uartAppIsrCycles += CycleCounter_Get() - start;
+    s_uartAppIrqs++;
+}
 
 /* Function which sends a string to user via LPUART
  * param sourceStr: pointer to the array of characters
@@ -30,4 +50,71 @@ void print(const char *sourceStr)
     {
         transSts = LPUART_DRV_GetTransmitStatus(INST_LPUART1, &bytesRemaining);
     }
-}
\ No newline at end of file
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Change the LPUART1 baud rate if it can be met closely enough.
+ *
+ * The OSR/SBR pair comes from LPUART_DRV_PlanBaudRate, so the error is the
+ * one of the clock actually feeding LPUART1. Call between transfers.
+ *
+ * @param baudRate Desired baud rate, up to 3 Mbaud with a 48 MHz clock
+ * @param plan Chosen settings and achieved error, filled in any case
+ * @return STATUS_SUCCESS, STATUS_ERROR if the error exceeds
+ *         UART_APP_MAX_BAUD_ERROR_PPM, STATUS_BUSY during a transfer
+ *-----------------------------------------------------------------------------
+ */
+status_t UartApp_SetBaudRate(uint32 baudRate, lpuart_baud_plan_t *plan)
+{
+    status_t status;
+
+    status = LPUART_DRV_PlanBaudRate(INST_LPUART1, baudRate, plan);
+    if (status != STATUS_SUCCESS)
+    {
+        return status;
+    }
+    if ((plan->errorPpm > UART_APP_MAX_BAUD_ERROR_PPM) || (plan->errorPpm < -UART_APP_MAX_BAUD_ERROR_PPM))
+    {
+        return STATUS_ERROR;
+    }
+
+    return LPUART_DRV_SetBaudRate(INST_LPUART1, baudRate);
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Send a buffer on LPUART1 and count the interrupts it took.
+ *
+ * Compares the FIFO and the one char per interrupt modes: build with
+ * UART_APP_FIFO_ENABLED set and cleared and send the same buffer. Blocks
+ * the calling task until the transfer completes.
+ *
+ * @param data Bytes to send
+ * @param size Number of bytes
+ * @param result Interrupts per KiB and handler cycles per byte
+ * @return Status of LPUART_DRV_SendDataBlocking
+ *-----------------------------------------------------------------------------
+ */
+status_t UartApp_MeasureTx(const uint8 *data, uint32 size, UartApp_TxMeasureType *result)
+{
+    status_t status;
+
+    DEV_ASSERT(size > 0u);
+
+    s_uartAppIrqs = 0u;
+    s_uartAppIsrCycles = 0u;
+    INT_SYS_InstallHandler(LPUART1_RxTx_IRQn, UartApp_CountingIsr, &s_uartAppPrevIsr);
+
+    status = LPUART_DRV_SendDataBlocking(INST_LPUART1, data, size, UART_APP_MEASURE_TIMEOUT_MS);
+
+    INT_SYS_InstallHandler(LPUART1_RxTx_IRQn, s_uartAppPrevIsr, NULL);
+
+    result->bytes = size;
+    result->interrupts = s_uartAppIrqs;
+    result->isrCycles = s_uartAppIsrCycles;
+    result->irqPerKiB = (uint32)(((uint64_t)s_uartAppIrqs * 1024u) / size);
+    result->cyclesPerByte = s_uartAppIsrCycles / size;
+
+    return status;
+}
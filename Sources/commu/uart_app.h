@@ -29,6 +29,12 @@
 #include "helper_functions.h"
 
 /* Macro Define -------------------------------------------------------------*/
+/* LPUART1 interrupt transfers through the 4 word FIFOs */
+#define UART_APP_FIFO_ENABLED   (1U)
+
+/* Largest baud rate error UartApp_SetBaudRate accepts, 2 % */
+#define UART_APP_MAX_BAUD_ERROR_PPM     (20000)
+
 #define initOKStr "\r\n Initial OK! \r\n"
 #define welcomeStr "\r\nThis is an example for ADC PAL: it will print the average value of the conversion results in groups of conversions.\
                    \r\nMeasurements are done on ADC0 Input 12\r\n"
@@ -37,8 +43,20 @@
 #define headerStr  "ADC avg result: "
 #define exitStr    "\r\nADC PAL example execution finished successfully.\r\n"
 
+/* Type Define --------------------------------------------------------------*/
+typedef struct
+{
+    uint32 bytes;
+    uint32 interrupts;
+    uint32 isrCycles;           /* Core cycles spent in the LPUART1 handler */
+    uint32 irqPerKiB;
+    uint32 cyclesPerByte;
+} UartApp_TxMeasureType;
+
 /* Export Parameters --------------------------------------------------------*/
 extern void print(const char *sourceStr);
+extern status_t UartApp_SetBaudRate(uint32 baudRate, lpuart_baud_plan_t *plan);
+extern status_t UartApp_MeasureTx(const uint8 *data, uint32 size, UartApp_TxMeasureType *result);
 
 
 
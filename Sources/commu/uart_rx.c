@@ -0,0 +1,426 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file uart_rx.c
+ * @brief Continuous LPUART reception into an eDMA ring buffer, frames
+ *        delimited by the idle line
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * The eDMA channel loops over the ring forever: one byte per request, the
+ * destination wraps with the last address adjustment. The write position is
+ * read back from the remaining major count. Interrupts only come from the
+ * idle line, which marks a frame end, and from the half/full ring points,
+ * which keep the byte count unambiguous while a long frame streams in. A
+ * frame therefore costs one interrupt instead of one per byte.
+ *
+ * The LPUART vector is shared with the transmit side of the SDK driver:
+ * the handler installed here serves the idle line and the receive errors,
+ * then chains to the one LPUART_DRV_Init installed. The error flags are
+ * cleared here so that the SDK does not abort a receive it does not own.
+ *
+ * Positions are free running byte counters, the ring index is the counter
+ * modulo UART_RX_RING_SIZE. Only the reader moves the tail.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "uart_rx.h"
+#include "dma_mgr.h"
+#include "interrupt_manager.h"
+#include "task.h"
+#include "string.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define UART_RX_STAT_ERRORS         (LPUART_STAT_OR_MASK | LPUART_STAT_NF_MASK | \
+                                     LPUART_STAT_FE_MASK | LPUART_STAT_PF_MASK)
+/* Write 1 to clear flags of STAT, kept 0 when writing another one */
+#define UART_RX_STAT_W1C            (LPUART_STAT_LBKDIF_MASK | LPUART_STAT_RXEDGIF_MASK | \
+                                     LPUART_STAT_IDLE_MASK | UART_RX_STAT_ERRORS | \
+                                     LPUART_STAT_MA1F_MASK | LPUART_STAT_MA2F_MASK)
+
+/* Local Parameters ---------------------------------------------------------*/
+static LPUART_Type *s_uartRxBase = NULL;
+static uint8 s_uartRxChannel = DMA_MGR_NO_CHANNEL;
+static isr_t s_uartRxPrevIsr = NULL;
+
+static uint8 s_uartRxRing[UART_RX_RING_SIZE];
+static volatile uint32 s_uartRxHead;        /* Bytes written by the eDMA */
+static volatile uint32 s_uartRxTail;        /* Bytes consumed by the reader */
+static uint32 s_uartRxLastPos;              /* Ring index of s_uartRxHead */
+
+static uint32 s_uartRxFrameEnd[UART_RX_MAX_FRAMES];
+static volatile uint8 s_uartRxFrameHead;
+static volatile uint8 s_uartRxFrameTail;
+
+static TaskHandle_t s_uartRxReader = NULL;
+static UartRx_StatsType s_uartRxStats;
+
+/* Local Functions ----------------------------------------------------------*/
+static void UartRx_ClearStatus(uint32 flags)
+{
+    s_uartRxBase->STAT = (s_uartRxBase->STAT & ~UART_RX_STAT_W1C) | flags;
+}
+
+/* Advance the head to the eDMA position, with interrupts disabled */
+static void UartRx_Update(boolean frameEnd)
+{
+    uint32 pos = UART_RX_RING_SIZE - EDMA_DRV_GetRemainingMajorIterationsCount(s_uartRxChannel);
+    uint32 delta = (pos - s_uartRxLastPos) & (UART_RX_RING_SIZE - 1u);
+
+    s_uartRxLastPos = pos & (UART_RX_RING_SIZE - 1u);
+    s_uartRxHead += delta;
+    s_uartRxStats.bytes += delta;
+
+    if (frameEnd == false)
+    {
+        return;
+    }
+
+    /* Skip the idle line following a frame end already recorded */
+    if ((s_uartRxFrameHead != s_uartRxFrameTail) &&
+        (s_uartRxFrameEnd[(uint8)(s_uartRxFrameHead - 1u) % UART_RX_MAX_FRAMES] == s_uartRxHead))
+    {
+        return;
+    }
+    if (s_uartRxHead == s_uartRxTail)
+    {
+        return;
+    }
+
+    if ((uint8)(s_uartRxFrameHead - s_uartRxFrameTail) >= UART_RX_MAX_FRAMES)
+    {
+        /* Merge into the newest frame */
+        s_uartRxFrameEnd[(uint8)(s_uartRxFrameHead - 1u) % UART_RX_MAX_FRAMES] = s_uartRxHead;
+        s_uartRxStats.frameOverflows++;
+    }
+    else
+    {
+        s_uartRxFrameEnd[s_uartRxFrameHead % UART_RX_MAX_FRAMES] = s_uartRxHead;
+        s_uartRxFrameHead++;
+    }
+    s_uartRxStats.frames++;
+}
+
+static void UartRx_NotifyReader(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    TaskHandle_t reader = s_uartRxReader;
+
+    if (reader != NULL)
+    {
+        s_uartRxReader = NULL;
+        vTaskNotifyGiveFromISR(reader, &xHigherPriorityTaskWoken);
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    }
+}
+
+static void UartRx_DmaCallback(void *parameter, edma_chn_status_t status)
+{
+    (void)parameter;
+    (void)status;
+
+    INT_SYS_DisableIRQGlobal();
+    UartRx_Update(false);
+    s_uartRxStats.interrupts++;
+    INT_SYS_EnableIRQGlobal();
+
+    UartRx_NotifyReader();
+}
+
+static void UartRx_IrqHandler(void)
+{
+    uint32 stat = s_uartRxBase->STAT;
+
+    if ((stat & UART_RX_STAT_ERRORS) != 0u)
+    {
+        UartRx_ClearStatus(stat & UART_RX_STAT_ERRORS);
+        s_uartRxStats.lineErrors++;
+    }
+
+    if ((stat & LPUART_STAT_IDLE_MASK) != 0u)
+    {
+        UartRx_ClearStatus(LPUART_STAT_IDLE_MASK);
+
+        INT_SYS_DisableIRQGlobal();
+        UartRx_Update(true);
+        s_uartRxStats.interrupts++;
+        INT_SYS_EnableIRQGlobal();
+
+        UartRx_NotifyReader();
+    }
+
+    /* Transmit side of the SDK driver */
+    if (s_uartRxPrevIsr != NULL)
+    {
+        s_uartRxPrevIsr();
+    }
+}
+
+/* Drop what the eDMA overwrote and the frame ends already consumed */
+static void UartRx_Trim(void)
+{
+    if ((s_uartRxHead - s_uartRxTail) > UART_RX_RING_SIZE)
+    {
+        /* Keep half a ring, the older half may be under rewrite */
+        s_uartRxTail = s_uartRxHead - (UART_RX_RING_SIZE / 2u);
+        s_uartRxStats.ringOverflows++;
+    }
+
+    while ((s_uartRxFrameHead != s_uartRxFrameTail) &&
+           ((sint32)(s_uartRxFrameEnd[s_uartRxFrameTail % UART_RX_MAX_FRAMES] - s_uartRxTail) <= 0))
+    {
+        s_uartRxFrameTail++;
+    }
+}
+
+/* Block until data (or a whole frame) is there, false on timeout */
+static boolean UartRx_Wait(boolean frame, TickType_t ticksToWait)
+{
+    TimeOut_t timeOut;
+    boolean ready = false;
+
+    vTaskSetTimeOutState(&timeOut);
+
+    for (;;)
+    {
+        INT_SYS_DisableIRQGlobal();
+        UartRx_Update(false);
+        UartRx_Trim();
+        if (frame == true)
+        {
+            ready = (s_uartRxFrameHead != s_uartRxFrameTail) ? true : false;
+        }
+        else
+        {
+            ready = (s_uartRxHead != s_uartRxTail) ? true : false;
+        }
+        s_uartRxReader = (ready == true) ? NULL : xTaskGetCurrentTaskHandle();
+        INT_SYS_EnableIRQGlobal();
+
+        if ((ready == true) || (xTaskCheckForTimeOut(&timeOut, &ticksToWait) == pdTRUE))
+        {
+            break;
+        }
+        (void)ulTaskNotifyTake(pdTRUE, ticksToWait);
+    }
+
+    s_uartRxReader = NULL;
+    return ready;
+}
+
+static void UartRx_CopyOut(uint8 *buf, uint32 size)
+{
+    uint32 index = s_uartRxTail & (UART_RX_RING_SIZE - 1u);
+    uint32 first = UART_RX_RING_SIZE - index;
+
+    if (first > size)
+    {
+        first = size;
+    }
+    memcpy(buf, &s_uartRxRing[index], first);
+    memcpy(&buf[first], s_uartRxRing, size - first);
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Start the continuous reception on an LPUART.
+ *
+ * Call after LPUART_DRV_Init and DmaMgr_Init. The SDK receive functions
+ * must not be used on the instance afterwards, sending still works.
+ *
+ * @param instance LPUART instance
+ * @return STATUS_SUCCESS, or the error of the eDMA channel setup
+ *-----------------------------------------------------------------------------
+ */
+status_t UartRx_Init(uint32 instance)
+{
+    static LPUART_Type * const bases[LPUART_INSTANCE_COUNT] = LPUART_BASE_PTRS;
+    static const IRQn_Type irqs[LPUART_INSTANCE_COUNT] = LPUART_RX_TX_IRQS;
+    static const dma_request_source_t sources[LPUART_INSTANCE_COUNT] =
+    {
+        EDMA_REQ_LPUART0_RX, EDMA_REQ_LPUART1_RX, EDMA_REQ_LPUART2_RX
+    };
+    DmaMgr_ChannelReqType req;
+    edma_loop_transfer_config_t loop;
+    edma_transfer_config_t transfer;
+    status_t status;
+
+    DEV_ASSERT(instance < LPUART_INSTANCE_COUNT);
+    DEV_ASSERT((UART_RX_RING_SIZE & (UART_RX_RING_SIZE - 1u)) == 0u);
+    DEV_ASSERT(s_uartRxBase == NULL);
+
+    req.source = sources[instance];
+    req.priority = UART_RX_DMA_PRIORITY;
+    req.preemptible = false;
+    req.canPreempt = true;
+    req.callback = UartRx_DmaCallback;
+    req.callbackParam = NULL;
+    status = DmaMgr_Alloc(&req, &s_uartRxChannel);
+    if (status != STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    memset(&loop, 0, sizeof(loop));
+    loop.majorLoopIterationCount = UART_RX_RING_SIZE;
+
+    memset(&transfer, 0, sizeof(transfer));
+    transfer.srcAddr = (uint32)&bases[instance]->DATA;
+    transfer.destAddr = (uint32)s_uartRxRing;
+    transfer.srcTransferSize = EDMA_TRANSFER_SIZE_1B;
+    transfer.destTransferSize = EDMA_TRANSFER_SIZE_1B;
+    transfer.srcOffset = 0;
+    transfer.destOffset = 1;
+    transfer.srcLastAddrAdjust = 0;
+    transfer.destLastAddrAdjust = -(sint32)UART_RX_RING_SIZE;
+    transfer.srcModulo = EDMA_MODULO_OFF;
+    transfer.destModulo = EDMA_MODULO_OFF;
+    transfer.minorByteTransferCount = 1u;
+    transfer.scatterGatherEnable = false;
+    transfer.interruptEnable = true;
+    transfer.loopTransferConfig = &loop;
+    status = EDMA_DRV_ConfigLoopTransfer(s_uartRxChannel, &transfer);
+    if (status != STATUS_SUCCESS)
+    {
+        (void)DmaMgr_Free(s_uartRxChannel);
+        s_uartRxChannel = DMA_MGR_NO_CHANNEL;
+        return status;
+    }
+    EDMA_DRV_ConfigureInterrupt(s_uartRxChannel, EDMA_CHN_HALF_MAJOR_LOOP_INT, true);
+
+    s_uartRxBase = bases[instance];
+    s_uartRxHead = 0u;
+    s_uartRxTail = 0u;
+    s_uartRxLastPos = 0u;
+    s_uartRxFrameHead = 0u;
+    s_uartRxFrameTail = 0u;
+
+    /* Both interrupts notify the reader task */
+    INT_SYS_SetPriority((IRQn_Type)((uint32)DMA0_IRQn + s_uartRxChannel),
+                        configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+    INT_SYS_SetPriority(irqs[instance], configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+    INT_SYS_InstallHandler(irqs[instance], UartRx_IrqHandler, &s_uartRxPrevIsr);
+
+    status = EDMA_DRV_StartChannel(s_uartRxChannel);
+
+    UartRx_ClearStatus(UART_RX_STAT_ERRORS | LPUART_STAT_IDLE_MASK);
+    s_uartRxBase->CTRL = (s_uartRxBase->CTRL & ~LPUART_CTRL_IDLECFG_MASK) |
+                         LPUART_CTRL_IDLECFG(UART_RX_IDLE_CFG) | LPUART_CTRL_ILT_MASK |
+                         LPUART_CTRL_ILIE_MASK | LPUART_CTRL_RE_MASK;
+    s_uartRxBase->BAUD |= LPUART_BAUD_RDMAE_MASK;
+
+    return status;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Number of received bytes not read yet.
+ *-----------------------------------------------------------------------------
+ */
+uint32 UartRx_Available(void)
+{
+    uint32 count;
+
+    INT_SYS_DisableIRQGlobal();
+    UartRx_Update(false);
+    UartRx_Trim();
+    count = s_uartRxHead - s_uartRxTail;
+    INT_SYS_EnableIRQGlobal();
+
+    return count;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Read received bytes as a stream, ignoring the frame boundaries.
+ *
+ * Like xStreamBufferReceive: blocks until at least one byte is there, then
+ * returns what fits. One reader task only.
+ *
+ * @param buf Destination
+ * @param size Size of buf
+ * @param ticksToWait Longest wait for the first byte
+ * @return Number of bytes copied, 0 on timeout
+ *-----------------------------------------------------------------------------
+ */
+uint32 UartRx_Read(uint8 *buf, uint32 size, TickType_t ticksToWait)
+{
+    uint32 count;
+
+    DEV_ASSERT(s_uartRxBase != NULL);
+
+    if (UartRx_Wait(false, ticksToWait) == false)
+    {
+        return 0u;
+    }
+
+    count = s_uartRxHead - s_uartRxTail;
+    if (count > size)
+    {
+        count = size;
+    }
+    UartRx_CopyOut(buf, count);
+
+    INT_SYS_DisableIRQGlobal();
+    s_uartRxTail += count;
+    UartRx_Trim();
+    INT_SYS_EnableIRQGlobal();
+
+    return count;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Read the next frame, ended by an idle line.
+ *
+ * The part of a frame that does not fit in buf is dropped. One reader task
+ * only, not mixed with UartRx_Read.
+ *
+ * @param buf Destination
+ * @param size Size of buf
+ * @param ticksToWait Longest wait for a whole frame
+ * @return Number of bytes copied, 0 on timeout
+ *-----------------------------------------------------------------------------
+ */
+uint32 UartRx_ReadFrame(uint8 *buf, uint32 size, TickType_t ticksToWait)
+{
+    uint32 frameEnd;
+    uint32 count;
+
+    DEV_ASSERT(s_uartRxBase != NULL);
+
+    if (UartRx_Wait(true, ticksToWait) == false)
+    {
+        return 0u;
+    }
+
+    frameEnd = s_uartRxFrameEnd[s_uartRxFrameTail % UART_RX_MAX_FRAMES];
+    count = frameEnd - s_uartRxTail;
+    if (count > size)
+    {
+        count = size;
+        s_uartRxStats.truncatedFrames++;
+    }
+    UartRx_CopyOut(buf, count);
+
+    INT_SYS_DisableIRQGlobal();
+    s_uartRxTail = frameEnd;
+    UartRx_Trim();
+    INT_SYS_EnableIRQGlobal();
+
+    return count;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Reception counters since UartRx_Init.
+ *-----------------------------------------------------------------------------
+ */
+void UartRx_GetStats(UartRx_StatsType *stats)
+{
+    INT_SYS_DisableIRQGlobal();
+    *stats = s_uartRxStats;
+    INT_SYS_EnableIRQGlobal();
+}
@@ -0,0 +1,52 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file uart_rx.h
+ * @brief Continuous LPUART reception into an eDMA ring buffer, frames
+ *        delimited by the idle line
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _UART_RX_H_
+#define _UART_RX_H_
+
+#include "FreeRTOS.h"
+#include "Rte_Type.h"
+#include "Cpu.h"
+
+/* Macro Define -------------------------------------------------------------*/
+/* Start the receiver on LPUART1 in the boot sequence */
+#define UART_RX_ENABLED             (0U)
+
+#define UART_RX_RING_SIZE           (256U)  /* Power of 2, 2.5 ms at 1 Mbaud */
+#define UART_RX_MAX_FRAMES          (8U)    /* Frame ends not read yet */
+
+/* Idle characters ending a frame: 2^UART_RX_IDLE_CFG, counted after the stop bit */
+#define UART_RX_IDLE_CFG            (1U)
+
+#define UART_RX_DMA_PRIORITY        (14U)
+
+/* Type Define --------------------------------------------------------------*/
+typedef struct
+{
+    uint32 bytes;
+    uint32 frames;
+    uint32 interrupts;              /* Idle line and eDMA half/full ring */
+    uint32 ringOverflows;           /* Data overwritten before it was read */
+    uint32 frameOverflows;          /* Frame ends lost, frames merged */
+    uint32 truncatedFrames;         /* Longer than the UartRx_ReadFrame buffer */
+    uint32 lineErrors;              /* Overrun, noise, framing or parity */
+} UartRx_StatsType;
+
+/* Export Parameters --------------------------------------------------------*/
+extern status_t UartRx_Init(uint32 instance);
+extern uint32 UartRx_Available(void);
+extern uint32 UartRx_Read(uint8 *buf, uint32 size, TickType_t ticksToWait);
+extern uint32 UartRx_ReadFrame(uint8 *buf, uint32 size, TickType_t ticksToWait);
+extern void UartRx_GetStats(UartRx_StatsType *stats);
+
+#endif
@@ -0,0 +1,569 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file dma_copy.c
+ * @brief Asynchronous memcpy/memset on an eDMA channel, with a CPU copy
+ *        below a size threshold
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * One channel of the DMA manager, fed by the always enabled DMAMUX source so
+ * that all the minor loops of a transfer run after EDMA_DRV_StartChannel.
+ * The transfer size is the widest one (32, 16, 4, 2 or 1 bytes) both
+ * addresses can be aligned to; the bytes before that alignment and after
+ * the last whole minor loop are copied on the CPU before the channel starts,
+ * so the data is complete when the callback runs.
+ *
+ * The CPU copy moves words when the addresses allow it: the newlib-nano
+ * memcpy of this build copies byte by byte.
+ *
+ * DmaCopy_Calibrate times both paths on the target. The threshold becomes
+ * the first size for which the DMA completes no later than the CPU copy, so
+ * a task waiting for the copy never loses and an asynchronous caller gets
+ * the whole copy time back.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "dma_copy.h"
+#include "dma_mgr.h"
+#include "cycle_counter.h"
+#include "interrupt_manager.h"
+#include "task.h"
+#include "string.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define DMA_COPY_MAX_WIDTH          (32U)
+#define DMA_COPY_MAX_MINOR_LOOPS    (0x7FFFU)   /* CITER without channel link */
+#define DMA_COPY_CAL_TIMEOUT        (1000000UL) /* Cycles */
+
+/* Local Parameters ---------------------------------------------------------*/
+static uint8 s_dmaCopyChannel = DMA_MGR_NO_CHANNEL;
+static uint32 s_dmaCopyThreshold = DMA_COPY_THRESHOLD_DEFAULT;
+static volatile boolean s_dmaCopyBusy;
+static DmaCopy_CallbackType s_dmaCopyCallback;
+static void *s_dmaCopyParam;
+static volatile status_t s_dmaCopyWaitStatus;
+
+/* Fill pattern, used through DmaCopy_FillBuf for the alignment */
+static uint8 s_dmaCopyFill[2U * DMA_COPY_MAX_WIDTH];
+
+static volatile uint32 s_dmaCopyCalEnd;
+static DmaCopy_StatsType s_dmaCopyStats;
+
+/* Local Functions ----------------------------------------------------------*/
+static uint8 *DmaCopy_FillBuf(void)
+{
+    return (uint8 *)(((uint32)s_dmaCopyFill + (DMA_COPY_MAX_WIDTH - 1u)) & ~(DMA_COPY_MAX_WIDTH - 1u));
+}
+
+/* Widest transfer size for the low address bits */
+static edma_transfer_size_t DmaCopy_Width(uint32 addrBits)
+{
+    if ((addrBits & 31u) == 0u)
+    {
+        return EDMA_TRANSFER_SIZE_32B;
+    }
+    if ((addrBits & 15u) == 0u)
+    {
+        return EDMA_TRANSFER_SIZE_16B;
+    }
+    if ((addrBits & 3u) == 0u)
+    {
+        return EDMA_TRANSFER_SIZE_4B;
+    }
+    if ((addrBits & 1u) == 0u)
+    {
+        return EDMA_TRANSFER_SIZE_2B;
+    }
+    return EDMA_TRANSFER_SIZE_1B;
+}
+
+static void DmaCopy_CpuCopy(uint8 *dst, const uint8 *src, uint32 size)
+{
+    if ((((uint32)dst ^ (uint32)src) & 3u) == 0u)
+    {
+        uint32 *d;
+        const uint32 *s;
+
+        while (((((uint32)dst) & 3u) != 0u) && (size > 0u))
+        {
+            *dst++ = *src++;
+            size--;
+        }
+
+        d = (uint32 *)dst;
+        s = (const uint32 *)src;
+        while (size >= 16u)
+        {
+            d[0] = s[0];
+            d[1] = s[1];
+            d[2] = s[2];
+            d[3] = s[3];
+            d += 4;
+            s += 4;
+            size -= 16u;
+        }
+        while (size >= 4u)
+        {
+            *d++ = *s++;
+            size -= 4u;
+        }
+        dst = (uint8 *)d;
+        src = (const uint8 *)s;
+    }
+
+    while (size > 0u)
+    {
+        *dst++ = *src++;
+        size--;
+    }
+}
+
+static void DmaCopy_CpuFill(uint8 *dst, uint8 value, uint32 size)
+{
+    uint32 word = (uint32)value * 0x01010101UL;
+    uint32 *d;
+
+    while (((((uint32)dst) & 3u) != 0u) && (size > 0u))
+    {
+        *dst++ = value;
+        size--;
+    }
+
+    d = (uint32 *)dst;
+    while (size >= 16u)
+    {
+        d[0] = word;
+        d[1] = word;
+        d[2] = word;
+        d[3] = word;
+        d += 4;
+        size -= 16u;
+    }
+    while (size >= 4u)
+    {
+        *d++ = word;
+        size -= 4u;
+    }
+
+    dst = (uint8 *)d;
+    while (size > 0u)
+    {
+        *dst++ = value;
+        size--;
+    }
+}
+
+static void DmaCopy_EdmaCallback(void *parameter, edma_chn_status_t status)
+{
+    DmaCopy_CallbackType callback = s_dmaCopyCallback;
+    void *param = s_dmaCopyParam;
+    status_t result = STATUS_SUCCESS;
+
+    (void)parameter;
+
+    if (status == EDMA_CHN_ERROR)
+    {
+        s_dmaCopyStats.errors++;
+        result = STATUS_ERROR;
+    }
+
+    s_dmaCopyCallback = NULL;
+    s_dmaCopyBusy = false;
+
+    if (callback != NULL)
+    {
+        callback(param, result);
+    }
+}
+
+static void DmaCopy_NotifyTask(void *param, status_t status)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    s_dmaCopyWaitStatus = status;
+    vTaskNotifyGiveFromISR((TaskHandle_t)param, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+static void DmaCopy_CalDone(void *param, status_t status)
+{
+    (void)param;
+    (void)status;
+
+    s_dmaCopyCalEnd = CycleCounter_Get();
+}
+
+/* Claim the channel, STATUS_BUSY if a transfer is running */
+static status_t DmaCopy_Claim(DmaCopy_CallbackType callback, void *param)
+{
+    status_t status = STATUS_SUCCESS;
+
+    INT_SYS_DisableIRQGlobal();
+    if (s_dmaCopyBusy == true)
+    {
+        status = STATUS_BUSY;
+    }
+    else
+    {
+        s_dmaCopyBusy = true;
+        s_dmaCopyCallback = callback;
+        s_dmaCopyParam = param;
+    }
+    INT_SYS_EnableIRQGlobal();
+
+    return status;
+}
+
+/* Copy (src != NULL) or fill (src == NULL) on the claimed channel */
+static status_t DmaCopy_Start(uint8 *dst, const uint8 *src, uint8 value, uint32 size)
+{
+    edma_transfer_size_t width;
+    const uint8 *dmaSrc;
+    uint8 *fill;
+    uint32 head, body, tail;
+    status_t status;
+
+    if (src != NULL)
+    {
+        width = DmaCopy_Width((uint32)dst ^ (uint32)src);
+    }
+    else
+    {
+        width = DmaCopy_Width((uint32)dst);
+    }
+    head = (0u - (uint32)dst) & ((1UL << (uint32)width) - 1u);
+    body = (size - head) & ~(DMA_COPY_MINOR_BYTES - 1u);
+    tail = size - head - body;
+    DEV_ASSERT((body / DMA_COPY_MINOR_BYTES) <= DMA_COPY_MAX_MINOR_LOOPS);
+
+    if (src != NULL)
+    {
+        DmaCopy_CpuCopy(dst, src, head);
+        DmaCopy_CpuCopy(&dst[head + body], &src[head + body], tail);
+        dmaSrc = &src[head];
+    }
+    else
+    {
+        DmaCopy_CpuFill(dst, value, head);
+        DmaCopy_CpuFill(&dst[head + body], value, tail);
+        fill = DmaCopy_FillBuf();
+        memset(fill, value, DMA_COPY_MAX_WIDTH);
+        dmaSrc = fill;
+    }
+
+    status = EDMA_DRV_ConfigMultiBlockTransfer(s_dmaCopyChannel, EDMA_TRANSFER_MEM2MEM,
+                                               (uint32)dmaSrc, (uint32)&dst[head], width,
+                                               DMA_COPY_MINOR_BYTES, body / DMA_COPY_MINOR_BYTES,
+                                               true);
+    if ((status == STATUS_SUCCESS) && (src == NULL))
+    {
+        /* Read the same pattern over and over */
+        EDMA_DRV_SetSrcOffset(s_dmaCopyChannel, 0);
+        EDMA_DRV_SetSrcLastAddrAdjustment(s_dmaCopyChannel, 0);
+    }
+    if (status == STATUS_SUCCESS)
+    {
+        status = EDMA_DRV_StartChannel(s_dmaCopyChannel);
+    }
+
+    if (status == STATUS_SUCCESS)
+    {
+        s_dmaCopyStats.dmaCopies++;
+        s_dmaCopyStats.dmaBytes += body;
+    }
+    else
+    {
+        s_dmaCopyCallback = NULL;
+        s_dmaCopyBusy = false;
+    }
+
+    return status;
+}
+
+static boolean DmaCopy_UseDma(uint32 size)
+{
+    return ((s_dmaCopyChannel != DMA_MGR_NO_CHANNEL) && (size >= s_dmaCopyThreshold)) ? true : false;
+}
+
+static status_t DmaCopy_Run(uint8 *dst, const uint8 *src, uint8 value, uint32 size,
+                            DmaCopy_CallbackType callback, void *param)
+{
+    status_t status;
+
+    if (DmaCopy_UseDma(size) == false)
+    {
+        if (src != NULL)
+        {
+            DmaCopy_CpuCopy(dst, src, size);
+        }
+        else
+        {
+            DmaCopy_CpuFill(dst, value, size);
+        }
+        s_dmaCopyStats.cpuCopies++;
+
+        if (callback != NULL)
+        {
+            callback(param, STATUS_SUCCESS);
+        }
+        return STATUS_SUCCESS;
+    }
+
+    status = DmaCopy_Claim(callback, param);
+    if (status == STATUS_SUCCESS)
+    {
+        status = DmaCopy_Start(dst, src, value, size);
+    }
+
+    return status;
+}
+
+static status_t DmaCopy_RunWait(uint8 *dst, const uint8 *src, uint8 value, uint32 size, uint32 timeoutMs)
+{
+    status_t status = STATUS_BUSY;
+
+    if (DmaCopy_UseDma(size) == true)
+    {
+        /* Drop a notification left by an earlier timed out copy */
+        (void)ulTaskNotifyTake(pdTRUE, 0u);
+
+        status = DmaCopy_Claim(DmaCopy_NotifyTask, xTaskGetCurrentTaskHandle());
+        if (status == STATUS_SUCCESS)
+        {
+            status = DmaCopy_Start(dst, src, value, size);
+        }
+        if (status == STATUS_SUCCESS)
+        {
+            if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeoutMs)) == 0u)
+            {
+                INT_SYS_DisableIRQGlobal();
+                s_dmaCopyCallback = NULL;
+                INT_SYS_EnableIRQGlobal();
+                (void)EDMA_DRV_StopChannel(s_dmaCopyChannel);
+                s_dmaCopyBusy = false;
+                s_dmaCopyStats.errors++;
+                return STATUS_TIMEOUT;
+            }
+            return s_dmaCopyWaitStatus;
+        }
+        if (status == STATUS_BUSY)
+        {
+            s_dmaCopyStats.busyFallbacks++;
+        }
+    }
+
+    /* Short copy, no channel, or another copy running */
+    if (src != NULL)
+    {
+        DmaCopy_CpuCopy(dst, src, size);
+    }
+    else
+    {
+        DmaCopy_CpuFill(dst, value, size);
+    }
+    s_dmaCopyStats.cpuCopies++;
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Take the copy channel from the DMA manager.
+ *
+ * Call after DmaMgr_Init and after the drivers reserved their fixed
+ * channels. Until then, or if it fails, every copy is done on the CPU.
+ *
+ * @return Status of DmaMgr_Alloc
+ *-----------------------------------------------------------------------------
+ */
+status_t DmaCopy_Init(void)
+{
+    DmaMgr_ChannelReqType req;
+    status_t status;
+    uint8 channel;
+
+    req.source = EDMA_REQ_DMAMUX_ALWAYS_ENABLED0;
+    req.priority = DMA_COPY_PRIORITY;
+    req.preemptible = true;
+    req.canPreempt = false;
+    req.callback = DmaCopy_EdmaCallback;
+    req.callbackParam = NULL;
+
+    status = DmaMgr_Alloc(&req, &channel);
+    if (status == STATUS_SUCCESS)
+    {
+        /* The completion notifies tasks */
+        INT_SYS_SetPriority((IRQn_Type)((uint32)DMA0_IRQn + channel),
+                            configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+        s_dmaCopyChannel = channel;
+    }
+
+    return status;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Start copying size bytes, the buffers must not overlap.
+ *
+ * Below the threshold the copy is done on the CPU and the callback runs
+ * before the function returns.
+ *
+ * @param dst Destination
+ * @param src Source, not modified until the callback
+ * @param size Number of bytes
+ * @param callback Completion, may be NULL
+ * @param param Passed to callback
+ * @return STATUS_SUCCESS, STATUS_BUSY if another transfer is running
+ *-----------------------------------------------------------------------------
+ */
+status_t DmaCopy_Memcpy(void *dst, const void *src, uint32 size,
+                        DmaCopy_CallbackType callback, void *param)
+{
+    DEV_ASSERT(src != NULL);
+    DEV_ASSERT((((uint32)dst + size) <= (uint32)src) || (((uint32)src + size) <= (uint32)dst));
+
+    return DmaCopy_Run((uint8 *)dst, (const uint8 *)src, 0u, size, callback, param);
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Start filling size bytes with value.
+ *
+ * @param dst Destination
+ * @param value Fill byte
+ * @param size Number of bytes
+ * @param callback Completion, may be NULL
+ * @param param Passed to callback
+ * @return STATUS_SUCCESS, STATUS_BUSY if another transfer is running
+ *-----------------------------------------------------------------------------
+ */
+status_t DmaCopy_Memset(void *dst, uint8 value, uint32 size,
+                        DmaCopy_CallbackType callback, void *param)
+{
+    return DmaCopy_Run((uint8 *)dst, NULL, value, size, callback, param);
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Copy size bytes and block the calling task until it is done.
+ *
+ * The task sleeps on its notification value while the eDMA runs. If the
+ * channel is busy the copy is done on the CPU instead.
+ *
+ * @param dst Destination
+ * @param src Source
+ * @param size Number of bytes
+ * @param timeoutMs Longest wait for the eDMA
+ * @return STATUS_SUCCESS, STATUS_TIMEOUT or STATUS_ERROR
+ *-----------------------------------------------------------------------------
+ */
+status_t DmaCopy_MemcpyWait(void *dst, const void *src, uint32 size, uint32 timeoutMs)
+{
+    DEV_ASSERT(src != NULL);
+    DEV_ASSERT((((uint32)dst + size) <= (uint32)src) || (((uint32)src + size) <= (uint32)dst));
+
+    return DmaCopy_RunWait((uint8 *)dst, (const uint8 *)src, 0u, size, timeoutMs);
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Fill size bytes with value and block until it is done.
+ *
+ * @param dst Destination
+ * @param value Fill byte
+ * @param size Number of bytes
+ * @param timeoutMs Longest wait for the eDMA
+ * @return STATUS_SUCCESS, STATUS_TIMEOUT or STATUS_ERROR
+ *-----------------------------------------------------------------------------
+ */
+status_t DmaCopy_MemsetWait(void *dst, uint8 value, uint32 size, uint32 timeoutMs)
+{
+    return DmaCopy_RunWait((uint8 *)dst, NULL, value, size, timeoutMs);
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Whether an eDMA copy is running.
+ *-----------------------------------------------------------------------------
+ */
+boolean DmaCopy_IsBusy(void)
+{
+    return s_dmaCopyBusy;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Time the CPU and the eDMA copy and set the threshold to the
+ *        crossover size.
+ *
+ * Copies from 2 * DMA_COPY_MINOR_BYTES up to half the scratch buffer,
+ * doubling the size. Needs the eDMA interrupt, call it from a task.
+ *
+ * @param scratch Buffer holding the source and the destination halves
+ * @param size Size of scratch
+ * @return New threshold, unchanged if the DMA never won
+ *-----------------------------------------------------------------------------
+ */
+uint32 DmaCopy_Calibrate(uint8 *scratch, uint32 size)
+{
+    uint32 half = size / 2u;
+    uint32 n;
+    uint32 start, cpuCycles, dmaCycles;
+
+    if (s_dmaCopyChannel == DMA_MGR_NO_CHANNEL)
+    {
+        return s_dmaCopyThreshold;
+    }
+
+    for (n = DMA_COPY_THRESHOLD_MIN; n <= half; n *= 2u)
+    {
+        start = CycleCounter_Get();
+        DmaCopy_CpuCopy(&scratch[half], scratch, n);
+        cpuCycles = CycleCounter_Get() - start;
+
+        if (DmaCopy_Claim(DmaCopy_CalDone, NULL) != STATUS_SUCCESS)
+        {
+            break;
+        }
+        start = CycleCounter_Get();
+        s_dmaCopyCalEnd = start;
+        if (DmaCopy_Start(&scratch[half], scratch, 0u, n) != STATUS_SUCCESS)
+        {
+            break;
+        }
+        while ((s_dmaCopyBusy == true) && ((CycleCounter_Get() - start) < DMA_COPY_CAL_TIMEOUT))
+        {
+        }
+        if (s_dmaCopyBusy == true)
+        {
+            /* The eDMA interrupt is masked */
+            (void)EDMA_DRV_StopChannel(s_dmaCopyChannel);
+            s_dmaCopyBusy = false;
+            break;
+        }
+        dmaCycles = s_dmaCopyCalEnd - start;
+
+        if (dmaCycles <= cpuCycles)
+        {
+            s_dmaCopyThreshold = n;
+            break;
+        }
+    }
+
+    return s_dmaCopyThreshold;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Copy counters since boot.
+ *-----------------------------------------------------------------------------
+ */
+void DmaCopy_GetStats(DmaCopy_StatsType *stats)
+{
+    INT_SYS_DisableIRQGlobal();
+    *stats = s_dmaCopyStats;
+    INT_SYS_EnableIRQGlobal();
+}
@@ -0,0 +1,55 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file dma_copy.h
+ * @brief Asynchronous memcpy/memset on an eDMA channel, with a CPU copy
+ *        below a size threshold
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _DMA_COPY_H_
+#define _DMA_COPY_H_
+
+#include "Rte_Type.h"
+#include "Cpu.h"
+
+/* Macro Define -------------------------------------------------------------*/
+/* Bytes moved per minor loop, the eDMA arbitrates between minor loops */
+#define DMA_COPY_MINOR_BYTES        (64U)
+
+/* Shorter copies are done on the CPU, DmaCopy_Calibrate may change it */
+#define DMA_COPY_THRESHOLD_DEFAULT  (256U)
+#define DMA_COPY_THRESHOLD_MIN      (2U * DMA_COPY_MINOR_BYTES)
+
+#define DMA_COPY_PRIORITY           (0U)    /* Lowest, peripheral channels go first */
+
+/* Type Define --------------------------------------------------------------*/
+/* Called from the eDMA interrupt, or from the caller for CPU copies */
+typedef void (*DmaCopy_CallbackType)(void *param, status_t status);
+
+typedef struct
+{
+    uint32 dmaCopies;
+    uint32 dmaBytes;
+    uint32 cpuCopies;               /* Below the threshold or no channel */
+    uint32 busyFallbacks;           /* DmaCopy_*Wait found the channel busy */
+    uint32 errors;
+} DmaCopy_StatsType;
+
+/* Export Parameters --------------------------------------------------------*/
+extern status_t DmaCopy_Init(void);
+extern status_t DmaCopy_Memcpy(void *dst, const void *src, uint32 size,
+                               DmaCopy_CallbackType callback, void *param);
+extern status_t DmaCopy_Memset(void *dst, uint8 value, uint32 size,
+                               DmaCopy_CallbackType callback, void *param);
+extern status_t DmaCopy_MemcpyWait(void *dst, const void *src, uint32 size, uint32 timeoutMs);
+extern status_t DmaCopy_MemsetWait(void *dst, uint8 value, uint32 size, uint32 timeoutMs);
+extern boolean DmaCopy_IsBusy(void);
+extern uint32 DmaCopy_Calibrate(uint8 *scratch, uint32 size);
+extern void DmaCopy_GetStats(DmaCopy_StatsType *stats);
+
+#endif
@@ -0,0 +1,320 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file dma_mgr.c
+ * @brief eDMA channel manager: on demand channels, priorities, preemption
+ *        and a pool of software TCDs
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * Layered on EDMA_DRV_ChannelInit/EDMA_DRV_ReleaseChannel: the manager owns
+ * the channel state structures, so drivers only ask for a request source
+ * and get a channel number back. Channels are handed out from the highest
+ * number down, the low ones stay free for fixed configurations, which
+ * claim theirs with DmaMgr_Reserve.
+ *
+ * Fixed priority arbitration needs unique channel priorities. Asking for a
+ * priority held by another channel swaps the two, so the set stays a
+ * permutation; set priorities before the channels transfer.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "dma_mgr.h"
+#include "dmaController1.h"
+#include "interrupt_manager.h"
+
+/* Local Parameters ---------------------------------------------------------*/
+static edma_chn_state_t s_dmaMgrChnState[DMA_MGR_NUM_CHANNELS];
+static uint32 s_dmaMgrUsed;             /* Bit n: channel n allocated or reserved */
+static uint32 s_dmaMgrOwned;            /* Bit n: channel n initialized by DmaMgr_Alloc */
+
+/* One spare element leaves room for the 32 bytes alignment */
+static edma_software_tcd_t s_dmaMgrStcdPool[DMA_MGR_STCD_POOL_SIZE + 1u];
+static uint32 s_dmaMgrStcdUsed;         /* Bit n: pool entry n */
+
+static DmaMgr_StatsType s_dmaMgrStats;
+
+/* Local Functions ----------------------------------------------------------*/
+static edma_software_tcd_t *DmaMgr_StcdBase(void)
+{
+    return (edma_software_tcd_t *)STCD_ADDR(s_dmaMgrStcdPool);
+}
+
+static void DmaMgr_SetPriority(uint8 channel, uint8 priority)
+{
+    uint8 index = (uint8)FEATURE_DMA_CHN_TO_DCHPRI_INDEX(channel);
+    uint8 oldPriority = DMA->DCHPRI[index] & DMA_DCHPRI_CHPRI_MASK;
+    uint8 ch;
+
+    if (oldPriority == priority)
+    {
+        return;
+    }
+
+    /* Hand the old priority to the channel holding the requested one */
+    for (ch = 0u; ch < DMA_MGR_NUM_CHANNELS; ch++)
+    {
+        uint8 other = (uint8)FEATURE_DMA_CHN_TO_DCHPRI_INDEX(ch);
+
+        if ((DMA->DCHPRI[other] & DMA_DCHPRI_CHPRI_MASK) == priority)
+        {
+            DMA->DCHPRI[other] = (uint8)((DMA->DCHPRI[other] & ~DMA_DCHPRI_CHPRI_MASK) | DMA_DCHPRI_CHPRI(oldPriority));
+            break;
+        }
+    }
+    DMA->DCHPRI[index] = (uint8)((DMA->DCHPRI[index] & ~DMA_DCHPRI_CHPRI_MASK) | DMA_DCHPRI_CHPRI(priority));
+}
+
+static void DmaMgr_SetPreemption(uint8 channel, boolean preemptible, boolean canPreempt)
+{
+    uint8 index = (uint8)FEATURE_DMA_CHN_TO_DCHPRI_INDEX(channel);
+    uint8 value = DMA->DCHPRI[index] & DMA_DCHPRI_CHPRI_MASK;
+
+    value |= DMA_DCHPRI_ECP((preemptible == true) ? 1u : 0u);
+    value |= DMA_DCHPRI_DPA((canPreempt == true) ? 0u : 1u);
+    DMA->DCHPRI[index] = value;
+}
+
+static void DmaMgr_CountChannels(sint32 delta)
+{
+    s_dmaMgrStats.channelsInUse = (uint8)((sint32)s_dmaMgrStats.channelsInUse + delta);
+    if (s_dmaMgrStats.channelsInUse > s_dmaMgrStats.channelsPeak)
+    {
+        s_dmaMgrStats.channelsPeak = s_dmaMgrStats.channelsInUse;
+    }
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Initialize the eDMA controller without any channel.
+ *
+ * Uses the controller settings of dmaController1, its channel list is
+ * replaced by DmaMgr_Alloc.
+ *
+ * @return Status of EDMA_DRV_Init
+ *-----------------------------------------------------------------------------
+ */
+status_t DmaMgr_Init(void)
+{
+    DEV_ASSERT(DMA_MGR_STCD_POOL_SIZE <= 32U);
+    DEV_ASSERT(dmaController1_InitConfig0.chnArbitration == EDMA_ARBITRATION_FIXED_PRIORITY);
+
+    s_dmaMgrUsed = 0u;
+    s_dmaMgrOwned = 0u;
+    s_dmaMgrStcdUsed = 0u;
+
+    return EDMA_DRV_Init(&dmaController1_State, &dmaController1_InitConfig0, NULL, NULL, 0u);
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Keep a channel out of the pool, for a driver configured with a
+ *        fixed channel number that calls EDMA_DRV_ChannelInit itself.
+ *
+ * @param channel eDMA channel
+ * @return STATUS_SUCCESS, STATUS_BUSY if it is already in use
+ *-----------------------------------------------------------------------------
+ */
+status_t DmaMgr_Reserve(uint8 channel)
+{
+    status_t status = STATUS_SUCCESS;
+
+    DEV_ASSERT(channel < DMA_MGR_NUM_CHANNELS);
+
+    INT_SYS_DisableIRQGlobal();
+    if ((s_dmaMgrUsed & (1UL << channel)) != 0u)
+    {
+        status = STATUS_BUSY;
+    }
+    else
+    {
+        s_dmaMgrUsed |= 1UL << channel;
+        DmaMgr_CountChannels(1);
+    }
+    INT_SYS_EnableIRQGlobal();
+
+    return status;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Allocate and initialize a channel.
+ *
+ * @param req Request source, priority, preemption and callback
+ * @param channel Allocated channel, DMA_MGR_NO_CHANNEL on failure
+ * @return STATUS_SUCCESS, STATUS_BUSY if all channels are in use
+ *-----------------------------------------------------------------------------
+ */
+status_t DmaMgr_Alloc(const DmaMgr_ChannelReqType *req, uint8 *channel)
+{
+    edma_channel_config_t chnConfig;
+    status_t status;
+    uint8 ch = DMA_MGR_NUM_CHANNELS;
+    boolean found = false;
+
+    DEV_ASSERT((req->priority < DMA_MGR_NUM_CHANNELS) || (req->priority == DMA_MGR_PRIORITY_ANY));
+
+    *channel = DMA_MGR_NO_CHANNEL;
+
+    INT_SYS_DisableIRQGlobal();
+    while ((ch > 0u) && (found == false))
+    {
+        ch--;
+        if ((s_dmaMgrUsed & (1UL << ch)) == 0u)
+        {
+            s_dmaMgrUsed |= 1UL << ch;
+            found = true;
+        }
+    }
+    if (found == false)
+    {
+        s_dmaMgrStats.allocFailures++;
+    }
+    INT_SYS_EnableIRQGlobal();
+
+    if (found == false)
+    {
+        return STATUS_BUSY;
+    }
+
+    chnConfig.channelPriority = EDMA_CHN_DEFAULT_PRIORITY;
+    chnConfig.virtChnConfig = ch;
+    chnConfig.source = req->source;
+    chnConfig.callback = req->callback;
+    chnConfig.callbackParam = req->callbackParam;
+    chnConfig.enableTrigger = false;
+    status = EDMA_DRV_ChannelInit(&s_dmaMgrChnState[ch], &chnConfig);
+
+    INT_SYS_DisableIRQGlobal();
+    if (status == STATUS_SUCCESS)
+    {
+        if (req->priority != DMA_MGR_PRIORITY_ANY)
+        {
+            DmaMgr_SetPriority(ch, req->priority);
+        }
+        DmaMgr_SetPreemption(ch, req->preemptible, req->canPreempt);
+        s_dmaMgrOwned |= 1UL << ch;
+        s_dmaMgrStats.allocs++;
+        DmaMgr_CountChannels(1);
+        *channel = ch;
+    }
+    else
+    {
+        s_dmaMgrUsed &= ~(1UL << ch);
+    }
+    INT_SYS_EnableIRQGlobal();
+
+    return status;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Stop and release a channel of DmaMgr_Alloc or DmaMgr_Reserve.
+ *
+ * @param channel eDMA channel
+ * @return Status of EDMA_DRV_ReleaseChannel
+ *-----------------------------------------------------------------------------
+ */
+status_t DmaMgr_Free(uint8 channel)
+{
+    status_t status = STATUS_SUCCESS;
+
+    DEV_ASSERT(channel < DMA_MGR_NUM_CHANNELS);
+    DEV_ASSERT((s_dmaMgrUsed & (1UL << channel)) != 0u);
+
+    if ((s_dmaMgrOwned & (1UL << channel)) != 0u)
+    {
+        /* Allocated here, not reserved */
+        (void)EDMA_DRV_StopChannel(channel);
+        status = EDMA_DRV_ReleaseChannel(channel);
+    }
+
+    INT_SYS_DisableIRQGlobal();
+    s_dmaMgrOwned &= ~(1UL << channel);
+    s_dmaMgrUsed &= ~(1UL << channel);
+    s_dmaMgrStats.releases++;
+    DmaMgr_CountChannels(-1);
+    INT_SYS_EnableIRQGlobal();
+
+    return status;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Take consecutive software TCDs for a scatter/gather chain.
+ *
+ * @param count Number of TCDs
+ * @return First TCD, 32 bytes aligned, NULL if no run of count is free
+ *-----------------------------------------------------------------------------
+ */
+edma_software_tcd_t *DmaMgr_AllocStcd(uint8 count)
+{
+    uint32 mask;
+    uint8 first;
+    edma_software_tcd_t *stcd = NULL;
+
+    DEV_ASSERT((count > 0u) && (count <= DMA_MGR_STCD_POOL_SIZE));
+
+    mask = (count >= 32u) ? 0xFFFFFFFFUL : ((1UL << count) - 1u);
+
+    INT_SYS_DisableIRQGlobal();
+    for (first = 0u; (uint32)first + count <= DMA_MGR_STCD_POOL_SIZE; first++)
+    {
+        if ((s_dmaMgrStcdUsed & (mask << first)) == 0u)
+        {
+            s_dmaMgrStcdUsed |= mask << first;
+            s_dmaMgrStats.stcdInUse = (uint8)(s_dmaMgrStats.stcdInUse + count);
+            if (s_dmaMgrStats.stcdInUse > s_dmaMgrStats.stcdPeak)
+            {
+                s_dmaMgrStats.stcdPeak = s_dmaMgrStats.stcdInUse;
+            }
+            stcd = &DmaMgr_StcdBase()[first];
+            break;
+        }
+    }
+    if (stcd == NULL)
+    {
+        s_dmaMgrStats.stcdFailures++;
+    }
+    INT_SYS_EnableIRQGlobal();
+
+    return stcd;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Return software TCDs of DmaMgr_AllocStcd.
+ *
+ * @param stcd First TCD
+ * @param count Number of TCDs, as allocated
+ *-----------------------------------------------------------------------------
+ */
+void DmaMgr_FreeStcd(const edma_software_tcd_t *stcd, uint8 count)
+{
+    uint32 first = (uint32)(stcd - DmaMgr_StcdBase());
+    uint32 mask = (count >= 32u) ? 0xFFFFFFFFUL : ((1UL << count) - 1u);
+
+    DEV_ASSERT((first + count) <= DMA_MGR_STCD_POOL_SIZE);
+    DEV_ASSERT((s_dmaMgrStcdUsed & (mask << first)) == (mask << first));
+
+    INT_SYS_DisableIRQGlobal();
+    s_dmaMgrStcdUsed &= ~(mask << first);
+    s_dmaMgrStats.stcdInUse = (uint8)(s_dmaMgrStats.stcdInUse - count);
+    INT_SYS_EnableIRQGlobal();
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Usage and contention counters.
+ *
+ * @param stats Copy of the counters
+ *-----------------------------------------------------------------------------
+ */
+void DmaMgr_GetStats(DmaMgr_StatsType *stats)
+{
+    INT_SYS_DisableIRQGlobal();
+    *stats = s_dmaMgrStats;
+    INT_SYS_EnableIRQGlobal();
+}
@@ -0,0 +1,59 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file dma_mgr.h
+ * @brief eDMA channel manager: on demand channels, priorities, preemption
+ *        and a pool of software TCDs
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _DMA_MGR_H_
+#define _DMA_MGR_H_
+
+#include "Rte_Type.h"
+#include "Cpu.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define DMA_MGR_NUM_CHANNELS        (FEATURE_DMA_VIRTUAL_CHANNELS)
+#define DMA_MGR_STCD_POOL_SIZE      (24U)   /* Software TCDs, at most 32 */
+
+#define DMA_MGR_NO_CHANNEL          (0xFFU)
+#define DMA_MGR_PRIORITY_ANY        (0xFFU) /* Keep the reset priority of the channel */
+
+/* Type Define --------------------------------------------------------------*/
+typedef struct
+{
+    dma_request_source_t source;    /* DMAMUX request, EDMA_REQ_DISABLED for SW/linked */
+    uint8 priority;                 /* 0 (lowest) .. 15, or DMA_MGR_PRIORITY_ANY */
+    boolean preemptible;            /* A higher priority channel may suspend it (ECP) */
+    boolean canPreempt;             /* It may suspend a lower priority one (!DPA) */
+    edma_callback_t callback;
+    void *callbackParam;
+} DmaMgr_ChannelReqType;
+
+typedef struct
+{
+    uint32 allocs;
+    uint32 releases;
+    uint32 allocFailures;           /* No free channel */
+    uint32 stcdFailures;            /* No free run of software TCDs */
+    uint8 channelsInUse;
+    uint8 channelsPeak;
+    uint8 stcdInUse;
+    uint8 stcdPeak;
+} DmaMgr_StatsType;
+
+/* Export Parameters --------------------------------------------------------*/
+extern status_t DmaMgr_Init(void);
+extern status_t DmaMgr_Reserve(uint8 channel);
+extern status_t DmaMgr_Alloc(const DmaMgr_ChannelReqType *req, uint8 *channel);
+extern status_t DmaMgr_Free(uint8 channel);
+extern edma_software_tcd_t *DmaMgr_AllocStcd(uint8 count);
+extern void DmaMgr_FreeStcd(const edma_software_tcd_t *stcd, uint8 count);
+extern void DmaMgr_GetStats(DmaMgr_StatsType *stats);
+
+#endif
@@ -21,6 +21,7 @@ void vLedControl(void *pvParameters)
     TickType_t xNextWakeTime;
     LedCtlType uLedCtlSig = LedCtlType_Invalid;
 
+    (void)BootSeq_Require(BOOT_SEQ_BIT(BOOT_STEP_GPIO), portMAX_DELAY);
     // xNextWakeTime = xTaskGetTickCount();
     for( ;; )
     {
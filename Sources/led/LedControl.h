@@ -24,6 +24,7 @@
 #include "pin_mux.h"
 #include "BoardDefines.h"
 #include "uart_app.h"
+#include "boot_seq.h"
 
 /* Macro Define -------------------------------------------------------------*/
 #define userQUEUE_SEND_MS_10            ( 10 / portTICK_PERIOD_MS )
@@ -0,0 +1,139 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file code_ram.c
+ * @brief Code run from SRAM_L: placement, RAM cost and ISR timing
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * Flash fetches take wait states at the core clock of RUN and HSRUN. The
+ * .code section of S32K1xx_flash.ld collects .code_ram (CODE_RAM_FUNC) and a
+ * hot list of kernel and ISR functions written by Tools/code_ram.py from a
+ * profile. It stays in SRAM_L, on the code bus, with the vector table the
+ * startup code copies there unless __flash_vector_table__ is defined.
+ *
+ * The bench times one peripheral vector through a wrapper, like SpiBench,
+ * itself in RAM so it adds no flash fetches. Compare a build with an empty
+ * hot list against one with the list, under the same load. The exception
+ * vectors (PendSV, SysTick) cannot be wrapped: PendSV returns through
+ * EXC_RETURN in lr.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "code_ram.h"
+#include "cycle_counter.h"
+#include "interrupt_manager.h"
+#include "startup.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define CODE_RAM_NO_IRQ             (NotAvail_IRQn)
+
+/* Local Parameters ---------------------------------------------------------*/
+extern uint32_t __VECTOR_RAM[];
+extern uint32_t __RAM_VECTOR_TABLE_SIZE[];
+
+static IRQn_Type s_codeRamIrq = CODE_RAM_NO_IRQ;
+static isr_t s_codeRamPrevIsr = NULL;
+static volatile CodeRam_BenchType s_codeRamBench;
+
+/* Local Functions ----------------------------------------------------------*/
+static void CodeRam_TimingIsr(void) CODE_RAM_FUNC;
+
+static void CodeRam_TimingIsr(void)
+{
+    uint32 start = CycleCounter_Get();
+    uint32 cycles;
+
+    s_codeRamPrevIsr();
+    cycles = CycleCounter_Get() - start;
+
+    s_codeRamBench.count++;
+    s_codeRamBench.totalCycles += cycles;
+    if (cycles < s_codeRamBench.minCycles)
+    {
+        s_codeRamBench.minCycles = cycles;
+    }
+    if (cycles > s_codeRamBench.maxCycles)
+    {
+        s_codeRamBench.maxCycles = cycles;
+    }
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief RAM taken by the code and the vector table, from the linker symbols.
+ *
+ * @param report Destination
+ *-----------------------------------------------------------------------------
+ */
+void CodeRam_GetReport(CodeRam_ReportType *report)
+{
+    report->codeBytes = (uint32)(CODE_RAM_SECTION_END - CODE_RAM_SECTION_START);
+    report->vectorBytes = (uint32)__RAM_VECTOR_TABLE_SIZE;
+    report->vectorInRam = (S32_SCB->VTOR == (uint32)__VECTOR_RAM) ? true : false;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Start timing the handler of a peripheral vector.
+ *
+ * Needs the vector table in RAM. One vector at a time.
+ *
+ * @param irq Peripheral interrupt, not an exception
+ * @return STATUS_BUSY if a bench is running, STATUS_UNSUPPORTED if the
+ *         vector table is in flash
+ *-----------------------------------------------------------------------------
+ */
+status_t CodeRam_BenchStart(IRQn_Type irq)
+{
+    status_t status = STATUS_SUCCESS;
+
+    DEV_ASSERT((int32_t)irq >= 0);
+
+    if (s_codeRamIrq != CODE_RAM_NO_IRQ)
+    {
+        status = STATUS_BUSY;
+    }
+    else if ((uint32)__RAM_VECTOR_TABLE_SIZE == 0u)
+    {
+        status = STATUS_UNSUPPORTED;
+    }
+    else
+    {
+        s_codeRamBench.count = 0u;
+        s_codeRamBench.minCycles = 0xFFFFFFFFUL;
+        s_codeRamBench.maxCycles = 0u;
+        s_codeRamBench.totalCycles = 0u;
+
+        s_codeRamIrq = irq;
+        INT_SYS_DisableIRQGlobal();
+        INT_SYS_InstallHandler(irq, CodeRam_TimingIsr, &s_codeRamPrevIsr);
+        INT_SYS_EnableIRQGlobal();
+    }
+
+    return status;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Restore the handler and copy the timings.
+ *
+ * @param result Destination, minCycles is 0xFFFFFFFF without interrupts
+ *-----------------------------------------------------------------------------
+ */
+void CodeRam_BenchStop(CodeRam_BenchType *result)
+{
+    INT_SYS_DisableIRQGlobal();
+    if (s_codeRamIrq != CODE_RAM_NO_IRQ)
+    {
+        INT_SYS_InstallHandler(s_codeRamIrq, s_codeRamPrevIsr, NULL);
+        s_codeRamIrq = CODE_RAM_NO_IRQ;
+    }
+    result->count = s_codeRamBench.count;
+    result->minCycles = s_codeRamBench.minCycles;
+    result->maxCycles = s_codeRamBench.maxCycles;
+    result->totalCycles = s_codeRamBench.totalCycles;
+    INT_SYS_EnableIRQGlobal();
+}
@@ -0,0 +1,46 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file code_ram.h
+ * @brief Code run from SRAM_L: placement, RAM cost and ISR timing
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _CODE_RAM_H_
+#define _CODE_RAM_H_
+
+#include "Rte_Type.h"
+#include "Cpu.h"
+
+/* Macro Define -------------------------------------------------------------*/
+/* Put on the declaration. The startup code copies .code_ram to SRAM_L, calls
+ * between flash and RAM go through a linker veneer. SDK and kernel functions
+ * are placed by the hot list of S32K1xx_flash.ld instead, see Tools/code_ram.py */
+#define CODE_RAM_FUNC               __attribute__((section(".code_ram"), noinline))
+
+/* Type Define --------------------------------------------------------------*/
+typedef struct
+{
+    uint32 codeBytes;               /* .code_ram and the hot list */
+    uint32 vectorBytes;             /* 0 with __flash_vector_table__ */
+    boolean vectorInRam;            /* VTOR on the RAM copy */
+} CodeRam_ReportType;
+
+typedef struct
+{
+    uint32 count;
+    uint32 minCycles;               /* Handler entry to exit, core cycles */
+    uint32 maxCycles;
+    uint32 totalCycles;
+} CodeRam_BenchType;
+
+/* Export Parameters --------------------------------------------------------*/
+extern void CodeRam_GetReport(CodeRam_ReportType *report);
+extern status_t CodeRam_BenchStart(IRQn_Type irq);
+extern void CodeRam_BenchStop(CodeRam_BenchType *result);
+
+#endif
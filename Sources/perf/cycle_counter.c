@@ -0,0 +1,40 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file cycle_counter.c
+ * @brief Cortex-M4 DWT cycle counter used for latency measurements
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "cycle_counter.h"
+
+/* Core cycles per microsecond, see CYCLES_PER_US */
+volatile uint32 g_CycleCounterPerUs = configCPU_CLOCK_HZ / 1000000UL;
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Enable the trace block and start the cycle counter.
+ *-----------------------------------------------------------------------------
+ */
+void CycleCounter_Init(void)
+{
+    CYCLE_COUNTER_DEMCR |= CYCLE_COUNTER_DEMCR_TRCENA;
+    CYCLE_COUNTER_DWT_CYCCNT = 0u;
+    CYCLE_COUNTER_DWT_CTRL |= CYCLE_COUNTER_CYCCNTENA;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Convert cycles at a new core clock, after a run mode change.
+ *
+ * @param coreHz Core clock in Hz, rounded down to whole MHz, 1 MHz at least
+ *-----------------------------------------------------------------------------
+ */
+void CycleCounter_SetCoreClock(uint32 coreHz)
+{
+    g_CycleCounterPerUs = (coreHz >= 1000000UL) ? (coreHz / 1000000UL) : 1UL;
+}
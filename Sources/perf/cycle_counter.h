@@ -0,0 +1,44 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file cycle_counter.h
+ * @brief Cortex-M4 DWT cycle counter used for latency measurements
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _CYCLE_COUNTER_H_
+#define _CYCLE_COUNTER_H_
+
+#include "FreeRTOS.h"
+#include "Rte_Type.h"
+
+/* Macro Define -------------------------------------------------------------*/
+/* The DWT is not described in the device header, use the ARMv7-M addresses */
+#define CYCLE_COUNTER_DEMCR         (*(volatile uint32 *)0xE000EDFCUL)
+#define CYCLE_COUNTER_DWT_CTRL      (*(volatile uint32 *)0xE0001000UL)
+#define CYCLE_COUNTER_DWT_CYCCNT    (*(volatile uint32 *)0xE0001004UL)
+
+#define CYCLE_COUNTER_DEMCR_TRCENA  (1UL << 24U)
+#define CYCLE_COUNTER_CYCCNTENA     (1UL << 0U)
+
+/* Follows the core clock of the run mode, configCPU_CLOCK_HZ after reset */
+#define CYCLES_PER_US               (g_CycleCounterPerUs)
+#define CYCLES_TO_US(cycles)        ((uint32)(cycles) / CYCLES_PER_US)
+
+/* Export Parameters --------------------------------------------------------*/
+extern volatile uint32 g_CycleCounterPerUs;
+
+extern void CycleCounter_Init(void);
+extern void CycleCounter_SetCoreClock(uint32 coreHz);
+
+/* Free running core clock counter, wraps every 2^32 cycles */
+static inline uint32 CycleCounter_Get(void)
+{
+    return CYCLE_COUNTER_DWT_CYCCNT;
+}
+
+#endif
@@ -0,0 +1,506 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file run_gov.c
+ * @brief Run mode governor: VLPR/RUN/HSRUN chosen from the idle time
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * The idle hook adds up the cycles spent in the idle loop. Every
+ * RUN_GOV_PERIOD_MS the governor task turns them into a load and moves one
+ * mode up or down: RUN <-> HSRUN is only a change of SMC_PMCTRL[RUNM], the
+ * SCG applies the HCCR/RCCR set by clockMan1. VLPR also needs FIRC, SOSC and
+ * SPLL stopped, so RUN is first moved to SIRC, and back to FIRC on exit.
+ *
+ * The clock callbacks given to RunGov_Init get the BEFORE/AFTER/RECOVER
+ * notifications of CLOCK_SYS_UpdateConfiguration, targetClockConfigIndex
+ * holding the target RunGov_ModeType. A callback failing BEFORE vetoes the
+ * switch. Peripherals on SIRCDIV2 (LPUART, LPSPI, LPTMR, ADC) keep their
+ * clock in every mode; the bus clock (PDB, FlexCAN registers) does not.
+ *
+ * After each switch the SysTick reload and CYCLES_PER_US follow the new core
+ * clock, the tick in progress is restarted. Flash cannot be programmed in
+ * HSRUN: limit the governor to RUN and wait for RunGov_GetMode first.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "run_gov.h"
+#include "cycle_counter.h"
+#include "interrupt_manager.h"
+#include "boot_seq.h"
+#include "task.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define RUN_GOV_SMC_TIMEOUT         (10000U)    /* PMSTAT polls */
+
+/* SysTick reload and current value, see port.c */
+#define RUN_GOV_SYST_LOAD           (*(volatile uint32 *)0xE000E014UL)
+#define RUN_GOV_SYST_VAL            (*(volatile uint32 *)0xE000E018UL)
+
+#define RUN_GOV_NUM_SOURCES         (3U)
+
+/* Type Define --------------------------------------------------------------*/
+typedef struct
+{
+    clock_names_t name;
+    clock_source_config_t config;
+} RunGov_SourceType;
+
+/* Local Parameters ---------------------------------------------------------*/
+static const uint32 s_runGovCoreHz[RUN_GOV_MODE_COUNT] =
+{
+    RUN_GOV_VLPR_CORE_HZ, RUN_GOV_RUN_CORE_HZ, RUN_GOV_HSRUN_CORE_HZ
+};
+
+/* SMC_PMCTRL[RUNM] and SMC_PMSTAT of each mode */
+static const uint8 s_runGovRunm[RUN_GOV_MODE_COUNT] = { 2U, 0U, 3U };
+static const uint8 s_runGovPmstat[RUN_GOV_MODE_COUNT] = { 0x04U, 0x01U, 0x80U };
+
+/* Stopped for VLPR in reverse order, restarted as clockMan1 configures them */
+static const RunGov_SourceType s_runGovSources[RUN_GOV_NUM_SOURCES] =
+{
+    { FIRC_CLK, { .enable = true, .outputDiv1 = 1U, .outputDiv2 = 1U } },
+    { SOSC_CLK, { .enable = true, .refClk = XOSC_INT_OSC, .refFreq = 8000000UL,
+                  .outputDiv1 = 1U, .outputDiv2 = 1U } },
+    { SPLL_CLK, { .enable = true, .mul = 28U, .div = 1U, .outputDiv1 = 1U, .outputDiv2 = 1U } },
+};
+
+/* RUN system clock on FIRC (RCCR of clockMan1) and on SIRC around VLPR */
+static const sys_clk_config_t s_runGovRunFirc = { .src = FIRC_CLK, .dividers = { 1U, 2U, 2U } };
+static const sys_clk_config_t s_runGovRunSirc = { .src = SIRC_CLK, .dividers = { 1U, 1U, 2U } };
+
+static clock_manager_callback_user_config_t **s_runGovCallbacks = NULL;
+static uint8 s_runGovCallbackCount = 0u;
+
+static RunGov_ModeType s_runGovMode = RUN_GOV_MODE_RUN;
+static RunGov_ModeType s_runGovMin = RUN_GOV_MODE_RUN;
+static RunGov_ModeType s_runGovMax = RUN_GOV_MODE_HSRUN;
+
+/* Running total, written by the idle task only */
+static volatile uint32 s_runGovIdleCycles;
+static uint32 s_runGovIdleStamp;
+
+static RunGov_StatsType s_runGovStats;
+
+/* Local Functions ----------------------------------------------------------*/
+static void RunGov_RetuneTick(RunGov_ModeType mode)
+{
+    uint32 coreHz = 0u;
+
+    if ((CLOCK_SYS_GetFreq(CORE_CLOCK, &coreHz) != STATUS_SUCCESS) || (coreHz == 0u))
+    {
+        coreHz = s_runGovCoreHz[mode];
+    }
+
+    INT_SYS_DisableIRQGlobal();
+    RUN_GOV_SYST_LOAD = (coreHz / configTICK_RATE_HZ) - 1UL;
+    RUN_GOV_SYST_VAL = 0u;
+    CycleCounter_SetCoreClock(coreHz);
+    INT_SYS_EnableIRQGlobal();
+}
+
+static status_t RunGov_SetRunm(RunGov_ModeType mode)
+{
+    status_t status = STATUS_SUCCESS;
+    uint32 polls;
+
+    INT_SYS_DisableIRQGlobal();
+
+    SMC->PMCTRL = (SMC->PMCTRL & ~SMC_PMCTRL_RUNM_MASK) | SMC_PMCTRL_RUNM(s_runGovRunm[mode]);
+    for (polls = 0u; (polls < RUN_GOV_SMC_TIMEOUT) &&
+         ((SMC->PMSTAT & SMC_PMSTAT_PMSTAT_MASK) != s_runGovPmstat[mode]); polls++)
+    {
+    }
+    if ((SMC->PMSTAT & SMC_PMSTAT_PMSTAT_MASK) != s_runGovPmstat[mode])
+    {
+        status = STATUS_TIMEOUT;
+    }
+
+    /* The core clock changed behind the clock manager */
+    CLOCK_SYS_InvalidateFreqCache();
+
+    INT_SYS_EnableIRQGlobal();
+
+    RunGov_RetuneTick(mode);
+
+    return status;
+}
+
+static status_t RunGov_SetSources(boolean enable)
+{
+    status_t status = STATUS_SUCCESS;
+    clock_source_config_t config;
+    uint8 i;
+    uint8 idx;
+
+    for (i = 0u; (i < RUN_GOV_NUM_SOURCES) && (status == STATUS_SUCCESS); i++)
+    {
+        idx = (enable == true) ? i : (uint8)(RUN_GOV_NUM_SOURCES - 1U - i);
+        config = s_runGovSources[idx].config;
+        config.enable = enable;
+        status = CLOCK_DRV_SetClockSource(s_runGovSources[idx].name, &config);
+    }
+
+    return status;
+}
+
+static status_t RunGov_SetRunClock(const sys_clk_config_t *config)
+{
+    status_t status;
+
+    status = CLOCK_DRV_SetSystemClock(NULL, config);
+    RunGov_RetuneTick(RUN_GOV_MODE_RUN);
+
+    return status;
+}
+
+static status_t RunGov_ExitVlpr(void)
+{
+    status_t status;
+
+    /* RCCR still selects SIRC, which runs in VLPR */
+    status = RunGov_SetRunm(RUN_GOV_MODE_RUN);
+    if (status == STATUS_SUCCESS)
+    {
+        PMC->REGSC &= (uint8)~PMC_REGSC_BIASEN_MASK;
+        status = RunGov_SetSources(true);
+    }
+    if (status == STATUS_SUCCESS)
+    {
+        status = RunGov_SetRunClock(&s_runGovRunFirc);
+    }
+
+    return status;
+}
+
+static status_t RunGov_EnterVlpr(void)
+{
+    status_t status;
+
+    status = RunGov_SetRunClock(&s_runGovRunSirc);
+    if (status == STATUS_SUCCESS)
+    {
+        status = RunGov_SetSources(false);
+    }
+    if (status == STATUS_SUCCESS)
+    {
+        PMC->REGSC |= PMC_REGSC_BIASEN_MASK;
+        status = RunGov_SetRunm(RUN_GOV_MODE_VLPR);
+    }
+    if (status != STATUS_SUCCESS)
+    {
+        /* Back to RUN on FIRC from wherever the sequence stopped */
+        (void)RunGov_ExitVlpr();
+    }
+
+    return status;
+}
+
+static status_t RunGov_Transition(RunGov_ModeType target)
+{
+    status_t status;
+
+    if (target == RUN_GOV_MODE_VLPR)
+    {
+        status = RunGov_EnterVlpr();
+    }
+    else if (s_runGovMode == RUN_GOV_MODE_VLPR)
+    {
+        status = RunGov_ExitVlpr();
+    }
+    else
+    {
+        status = RunGov_SetRunm(target);
+        if (status != STATUS_SUCCESS)
+        {
+            (void)RunGov_SetRunm(s_runGovMode);
+        }
+    }
+
+    return status;
+}
+
+static status_t RunGov_Notify(clock_notify_struct_t *notify, uint8 *failedIdx)
+{
+    status_t status = STATUS_SUCCESS;
+    const clock_manager_callback_user_config_t *callback;
+    clock_manager_callback_type_t skipped;
+    uint8 idx;
+
+    skipped = (notify->notifyType == CLOCK_MANAGER_NOTIFY_BEFORE) ?
+              CLOCK_MANAGER_CALLBACK_AFTER : CLOCK_MANAGER_CALLBACK_BEFORE;
+
+    for (idx = 0u; idx < s_runGovCallbackCount; idx++)
+    {
+        callback = s_runGovCallbacks[idx];
+        if ((callback != NULL) && (callback->callbackType != skipped))
+        {
+            if (callback->callback(notify, callback->callbackData) != STATUS_SUCCESS)
+            {
+                *failedIdx = idx;
+                status = (notify->notifyType == CLOCK_MANAGER_NOTIFY_BEFORE) ?
+                         STATUS_MCU_NOTIFY_BEFORE_ERROR : STATUS_MCU_NOTIFY_AFTER_ERROR;
+                break;
+            }
+        }
+    }
+
+    return status;
+}
+
+static void RunGov_Recover(clock_notify_struct_t *notify, uint8 lastIdx)
+{
+    const clock_manager_callback_user_config_t *callback;
+    uint8 idx = lastIdx;
+
+    notify->notifyType = CLOCK_MANAGER_NOTIFY_RECOVER;
+    for (;;)
+    {
+        callback = s_runGovCallbacks[idx];
+        if (callback != NULL)
+        {
+            (void)callback->callback(notify, callback->callbackData);
+        }
+        if (idx == 0u)
+        {
+            break;
+        }
+        idx--;
+    }
+}
+
+static void RunGov_Switch(RunGov_ModeType target)
+{
+    clock_notify_struct_t notify;
+    status_t status;
+    uint8 failedIdx = 0u;
+
+    notify.targetClockConfigIndex = (uint8_t)target;
+    notify.policy = CLOCK_MANAGER_POLICY_AGREEMENT;
+    notify.notifyType = CLOCK_MANAGER_NOTIFY_BEFORE;
+
+    status = RunGov_Notify(&notify, &failedIdx);
+    if (status != STATUS_SUCCESS)
+    {
+        s_runGovStats.vetoes++;
+        RunGov_Recover(&notify, failedIdx);
+    }
+    else if (RunGov_Transition(target) != STATUS_SUCCESS)
+    {
+        s_runGovStats.failures++;
+        if (s_runGovCallbackCount > 0u)
+        {
+            RunGov_Recover(&notify, s_runGovCallbackCount - 1U);
+        }
+    }
+    else
+    {
+        s_runGovMode = target;
+        s_runGovStats.switches++;
+        notify.notifyType = CLOCK_MANAGER_NOTIFY_AFTER;
+        (void)RunGov_Notify(&notify, &failedIdx);
+    }
+}
+
+static RunGov_ModeType RunGov_Decide(uint32 loadPermille, uint8 *downWindows)
+{
+    RunGov_ModeType target = s_runGovMode;
+    uint32 predicted;
+
+    if (s_runGovMode < s_runGovMin)
+    {
+        target = (RunGov_ModeType)(s_runGovMode + 1U);
+    }
+    else if (s_runGovMode > s_runGovMax)
+    {
+        target = (RunGov_ModeType)(s_runGovMode - 1U);
+    }
+    else if ((loadPermille > RUN_GOV_UP_PERMILLE) && (s_runGovMode < s_runGovMax))
+    {
+        target = (RunGov_ModeType)(s_runGovMode + 1U);
+    }
+    else if (s_runGovMode > s_runGovMin)
+    {
+        /* Same work at the lower core clock */
+        predicted = (loadPermille * (s_runGovCoreHz[s_runGovMode] / 1000UL)) /
+                    (s_runGovCoreHz[s_runGovMode - 1U] / 1000UL);
+        *downWindows = (predicted < RUN_GOV_DOWN_PERMILLE) ? (uint8)(*downWindows + 1U) : 0u;
+        if (*downWindows >= RUN_GOV_DOWN_WINDOWS)
+        {
+            target = (RunGov_ModeType)(s_runGovMode - 1U);
+        }
+    }
+    else
+    {
+        *downWindows = 0u;
+    }
+
+    return target;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Take the clock callbacks to notify.
+ *
+ * Call in RUN, after the clock boot step and CycleCounter_Init. HSRUN and
+ * VLPR are allowed by the power boot step, see RUN_GOV_PMPROT.
+ *
+ * @param callbacks Clock callbacks, g_clockManCallbacksArr
+ * @param count Number of callbacks
+ * @return STATUS_ERROR if the core is not in RUN
+ *-----------------------------------------------------------------------------
+ */
+status_t RunGov_Init(clock_manager_callback_user_config_t **callbacks, uint8 count)
+{
+    DEV_ASSERT((callbacks != NULL) || (count == 0u));
+
+    if ((SMC->PMSTAT & SMC_PMSTAT_PMSTAT_MASK) != s_runGovPmstat[RUN_GOV_MODE_RUN])
+    {
+        return STATUS_ERROR;
+    }
+
+    DEV_ASSERT((SMC->PMPROT & RUN_GOV_PMPROT) == RUN_GOV_PMPROT);
+
+    s_runGovCallbacks = callbacks;
+    s_runGovCallbackCount = count;
+    s_runGovMode = RUN_GOV_MODE_RUN;
+    s_runGovMin = (RUN_GOV_VLPR_ENABLED != 0U) ? RUN_GOV_MODE_VLPR : RUN_GOV_MODE_RUN;
+    s_runGovMax = RUN_GOV_MODE_HSRUN;
+    s_runGovIdleStamp = CycleCounter_Get();
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Restrict the modes the governor may choose, applied at the end of
+ *        the current window.
+ *
+ * @param minMode Lowest mode
+ * @param maxMode Highest mode
+ * @return STATUS_UNSUPPORTED for VLPR without RUN_GOV_VLPR_ENABLED
+ *-----------------------------------------------------------------------------
+ */
+status_t RunGov_SetLimits(RunGov_ModeType minMode, RunGov_ModeType maxMode)
+{
+    DEV_ASSERT((minMode <= maxMode) && (maxMode < RUN_GOV_MODE_COUNT));
+
+    if ((minMode == RUN_GOV_MODE_VLPR) && (RUN_GOV_VLPR_ENABLED == 0U))
+    {
+        return STATUS_UNSUPPORTED;
+    }
+
+    INT_SYS_DisableIRQGlobal();
+    s_runGovMin = minMode;
+    s_runGovMax = maxMode;
+    INT_SYS_EnableIRQGlobal();
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Current run mode.
+ *
+ * @return RunGov_ModeType
+ *-----------------------------------------------------------------------------
+ */
+RunGov_ModeType RunGov_GetMode(void)
+{
+    return s_runGovMode;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Count the idle loop, called from vApplicationIdleHook.
+ *
+ * A gap longer than RUN_GOV_IDLE_GAP_CYCLES since the previous call had a
+ * task or an interrupt in it and counts as busy.
+ *-----------------------------------------------------------------------------
+ */
+void RunGov_IdleHook(void)
+{
+    uint32 now = CycleCounter_Get();
+    uint32 gap = now - s_runGovIdleStamp;
+
+    s_runGovIdleStamp = now;
+    if (gap < RUN_GOV_IDLE_GAP_CYCLES)
+    {
+        s_runGovIdleCycles += gap;
+    }
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Copy the governor statistics.
+ *
+ * @param stats Destination
+ *-----------------------------------------------------------------------------
+ */
+void RunGov_GetStats(RunGov_StatsType *stats)
+{
+    INT_SYS_DisableIRQGlobal();
+    *stats = s_runGovStats;
+    INT_SYS_EnableIRQGlobal();
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Governor task: measure the load of each window and step the mode.
+ *
+ * @param pvParameters Unused
+ *-----------------------------------------------------------------------------
+ */
+void vRunGov(void *pvParameters)
+{
+    TickType_t xNextWakeTime;
+    TickType_t lastTick;
+    uint32 lastCycles;
+    uint32 lastIdle;
+    uint32 cycles;
+    uint32 idle;
+    uint32 loadPermille;
+    uint8 downWindows = 0u;
+    RunGov_ModeType target;
+
+    (void)pvParameters;
+
+    /* LAZY step, RunGov_Init runs on this request */
+    (void)BootSeq_Require(BOOT_SEQ_BIT(BOOT_STEP_RUN_GOV), portMAX_DELAY);
+    xNextWakeTime = xTaskGetTickCount();
+    lastTick = xNextWakeTime;
+    lastCycles = CycleCounter_Get();
+    lastIdle = s_runGovIdleCycles;
+
+    for (;;)
+    {
+        vTaskDelayUntil(&xNextWakeTime, pdMS_TO_TICKS(RUN_GOV_PERIOD_MS));
+
+        cycles = CycleCounter_Get() - lastCycles;
+        idle = s_runGovIdleCycles - lastIdle;
+        loadPermille = 1000u;
+        if (cycles >= 1000u)
+        {
+            loadPermille = ((idle < cycles) ? (cycles - idle) : 0u) / (cycles / 1000u);
+            loadPermille = (loadPermille > 1000u) ? 1000u : loadPermille;
+        }
+
+        s_runGovStats.timeInMode[s_runGovMode] += (uint32)(xNextWakeTime - lastTick) * portTICK_PERIOD_MS;
+        s_runGovStats.loadPermille = (uint16)loadPermille;
+        lastTick = xNextWakeTime;
+
+        target = RunGov_Decide(loadPermille, &downWindows);
+        if (target != s_runGovMode)
+        {
+            RunGov_Switch(target);
+            downWindows = 0u;
+        }
+        s_runGovStats.mode = (uint8)s_runGovMode;
+
+        /* A window never spans two core clocks */
+        lastCycles = CycleCounter_Get();
+        lastIdle = s_runGovIdleCycles;
+    }
+}
@@ -0,0 +1,76 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file run_gov.h
+ * @brief Run mode governor: VLPR/RUN/HSRUN chosen from the idle time
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _RUN_GOV_H_
+#define _RUN_GOV_H_
+
+#include "FreeRTOS.h"
+#include "Rte_Type.h"
+#include "Cpu.h"
+
+/* Macro Define -------------------------------------------------------------*/
+/* Create vRunGov, it starts the RUN_GOV boot step. The idle hook feeds it */
+#define RUN_GOV_ENABLED             (0U)
+
+/* VLPR stops FIRC, SOSC and SPLL: FlexCAN (SOSCDIV2) stops with them */
+#define RUN_GOV_VLPR_ENABLED        (0U)
+
+/* Power modes needed in SMC_PMPROT, written once by the power boot step */
+#define RUN_GOV_PMPROT              ((RUN_GOV_ENABLED != 0U) ? \
+                                     (SMC_PMPROT_AHSRUN_MASK | \
+                                      ((RUN_GOV_VLPR_ENABLED != 0U) ? SMC_PMPROT_AVLP_MASK : 0U)) : 0U)
+
+#define RUN_GOV_PERIOD_MS           (100U)
+#define RUN_GOV_STACK_SIZE          (configMINIMAL_STACK_SIZE + 40U)
+
+/* Load in per mille of the window. Step up above UP, step down when the load
+ * predicted at the lower core clock stays under DOWN for DOWN_WINDOWS windows */
+#define RUN_GOV_UP_PERMILLE         (700U)
+#define RUN_GOV_DOWN_PERMILLE       (500U)
+#define RUN_GOV_DOWN_WINDOWS        (5U)
+
+/* Idle hook calls further apart than this had other work in between */
+#define RUN_GOV_IDLE_GAP_CYCLES     (400U)
+
+/* Core clock of each mode, must match VCCR/RCCR/HCCR of clockMan1_InitConfig0 */
+#define RUN_GOV_VLPR_CORE_HZ        (4000000UL)     /* SIRC / 2 */
+#define RUN_GOV_RUN_CORE_HZ         (48000000UL)    /* FIRC */
+#define RUN_GOV_HSRUN_CORE_HZ       (112000000UL)   /* SPLL, SOSC 8 MHz x 28 / 2 */
+
+/* Type Define --------------------------------------------------------------*/
+typedef enum
+{
+    RUN_GOV_MODE_VLPR = 0U,
+    RUN_GOV_MODE_RUN,
+    RUN_GOV_MODE_HSRUN,
+    RUN_GOV_MODE_COUNT
+} RunGov_ModeType;
+
+typedef struct
+{
+    uint32 timeInMode[RUN_GOV_MODE_COUNT];  /* ms */
+    uint32 switches;
+    uint32 vetoes;                  /* A clock callback refused the switch */
+    uint32 failures;                /* Clock source or SMC transition failed */
+    uint16 loadPermille;            /* Last window */
+    uint8 mode;                     /* RunGov_ModeType */
+} RunGov_StatsType;
+
+/* Export Parameters --------------------------------------------------------*/
+extern status_t RunGov_Init(clock_manager_callback_user_config_t **callbacks, uint8 count);
+extern status_t RunGov_SetLimits(RunGov_ModeType minMode, RunGov_ModeType maxMode);
+extern RunGov_ModeType RunGov_GetMode(void);
+extern void RunGov_IdleHook(void);
+extern void RunGov_GetStats(RunGov_StatsType *stats);
+extern void vRunGov(void *pvParameters);
+
+#endif
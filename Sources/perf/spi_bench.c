@@ -0,0 +1,80 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file spi_bench.c
+ * @brief Cost of the LPSPI interrupt transfers, measured on the target
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * Runs a blocking master transfer through a counting wrapper on the LPSPI
+ * vector, like UartApp_MeasureTx. The handler cycles include the FIFO fill
+ * and drain routines the driver chose for the frame size and buffers, so
+ * tx/rx aligned or not, or NULL, compare the specialised routines with the
+ * byte-wise ones on the same bus setup.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "spi_bench.h"
+#include "cycle_counter.h"
+#include "interrupt_manager.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define SPI_BENCH_TIMEOUT_MS        (1000U)
+
+/* Local Parameters ---------------------------------------------------------*/
+static isr_t s_spiBenchPrevIsr = NULL;
+static volatile uint32 s_spiBenchIrqs;
+static volatile uint32 s_spiBenchIsrCycles;
+
+/* Local Functions ----------------------------------------------------------*/
+static void SpiBench_CountingIsr(void)
+{
+    uint32 start = CycleCounter_Get();
+
+    s_spiBenchPrevIsr();
+    s_spiBenchIsrCycles += CycleCounter_Get() - start;
+    s_spiBenchIrqs++;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Run one interrupt driven master transfer and time its handler.
+ *
+ * The instance must be initialized in interrupt mode and not shared with a
+ * running user (SbcSvc_Lock on LPSPI1). Blocks the calling task until the
+ * transfer completes.
+ *
+ * @param instance LPSPI instance
+ * @param tx Bytes to send, NULL to send zeros
+ * @param rx Received bytes, NULL to discard them
+ * @param size Number of bytes, a multiple of the frame size
+ * @param result Handler cycles per byte
+ * @return Status of LPSPI_DRV_MasterTransferBlocking
+ *-----------------------------------------------------------------------------
+ */
+status_t SpiBench_MeasureIrq(uint32 instance, const uint8 *tx, uint8 *rx, uint16 size,
+                             SpiBench_ResultType *result)
+{
+    static const IRQn_Type irqs[LPSPI_INSTANCE_COUNT] = LPSPI_IRQS;
+    status_t status;
+
+    DEV_ASSERT(instance < LPSPI_INSTANCE_COUNT);
+    DEV_ASSERT(size > 0u);
+
+    s_spiBenchIrqs = 0u;
+    s_spiBenchIsrCycles = 0u;
+    INT_SYS_InstallHandler(irqs[instance], SpiBench_CountingIsr, &s_spiBenchPrevIsr);
+
+    status = LPSPI_DRV_MasterTransferBlocking(instance, tx, rx, size, SPI_BENCH_TIMEOUT_MS);
+
+    INT_SYS_InstallHandler(irqs[instance], s_spiBenchPrevIsr, NULL);
+
+    result->bytes = size;
+    result->interrupts = s_spiBenchIrqs;
+    result->isrCycles = s_spiBenchIsrCycles;
+    result->cyclesPerByte = s_spiBenchIsrCycles / size;
+
+    return status;
+}
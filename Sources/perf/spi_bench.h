@@ -0,0 +1,32 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file spi_bench.h
+ * @brief Cost of the LPSPI interrupt transfers, measured on the target
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _SPI_BENCH_H_
+#define _SPI_BENCH_H_
+
+#include "Rte_Type.h"
+#include "Cpu.h"
+
+/* Type Define --------------------------------------------------------------*/
+typedef struct
+{
+    uint32 bytes;
+    uint32 interrupts;
+    uint32 isrCycles;           /* Core cycles spent in the LPSPI handler */
+    uint32 cyclesPerByte;
+} SpiBench_ResultType;
+
+/* Export Parameters --------------------------------------------------------*/
+extern status_t SpiBench_MeasureIrq(uint32 instance, const uint8 *tx, uint8 *rx, uint16 size,
+                                    SpiBench_ResultType *result);
+
+#endif
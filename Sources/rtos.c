@@ -84,8 +84,20 @@
 /* User def includes */
 #include "LedControl.h"
 #include "adc_app.h"
+#include "adc_cal.h"
+#include "dma_mgr.h"
+#include "dma_copy.h"
+#include "adc_sched.h"
 #include "uart_app.h"
+#include "uart_rx.h"
+#include "spi_queue.h"
 #include "can_app.h"
+#include "can_gateway.h"
+#include "cycle_counter.h"
+#include "can_trace.h"
+#include "sbc_svc.h"
+#include "run_gov.h"
+#include "boot_seq.h"
 
 /* Priorities at which the tasks are created. */
 #define mainQUEUE_RECEIVE_TASK_PRIORITY (tskIDLE_PRIORITY + 2)
@@ -118,10 +130,29 @@ an interrupt on this port. */
 /*-----------------------------------------------------------*/
 
 /*
- * Setup the NVIC, LED outputs, and button inputs.
+ * Run the boot steps needed before the scheduler, see s_bootSteps.
  */
 static void prvSetupHardware(void);
 
+/*
+ * Boot steps of s_bootSteps, one peripheral each.
+ */
+status_t GPIOInit(void);
+status_t ADCInit(void);
+static status_t prvBootClock(void);
+static status_t prvBootPower(void);
+static status_t prvBootPins(void);
+static status_t prvBootDma(void);
+static status_t prvBootCan(void);
+static status_t prvBootCanGateway(void);
+static status_t prvBootUart(void);
+static status_t prvBootDmaCopy(void);
+static status_t prvBootUartRx(void);
+static status_t prvBootSbc(void);
+static status_t prvBootSpiQueue(void);
+static status_t prvBootRunGov(void);
+static status_t prvBootBanner(void);
+
 /*
  * The tasks as described in the comments at the top of this file.
  */
@@ -149,9 +180,32 @@ static TimerHandle_t xButtonLEDTimer = NULL;
 
 static uint8 debug_test = 0u;
 
+/* Boot steps. EARLY ones are on the path to the first CAN frame, TASK ones
+come up in vBootSeq while the application runs, LAZY ones only once a task
+asks for them. The eDMA users follow ADCInit, which reserves the fixed ADC
+channels first. */
+static const BootSeq_StepType s_bootSteps[BOOT_STEP_COUNT] =
+{
+    [BOOT_STEP_CLOCK]       = { "Clock",     prvBootClock,      0u,                                                          BOOT_SEQ_PHASE_EARLY },
+    [BOOT_STEP_POWER]       = { "Power",     prvBootPower,      BOOT_SEQ_BIT(BOOT_STEP_CLOCK),                               BOOT_SEQ_PHASE_EARLY },
+    [BOOT_STEP_PINS]        = { "Pins",      prvBootPins,       BOOT_SEQ_BIT(BOOT_STEP_CLOCK),                               BOOT_SEQ_PHASE_EARLY },
+    [BOOT_STEP_DMA]         = { "DMA",       prvBootDma,        BOOT_SEQ_BIT(BOOT_STEP_CLOCK),                               BOOT_SEQ_PHASE_EARLY },
+    [BOOT_STEP_CAN]         = { "CAN",       prvBootCan,        BOOT_SEQ_BIT(BOOT_STEP_PINS),                                BOOT_SEQ_PHASE_EARLY },
+    [BOOT_STEP_CAN_GATEWAY] = { "CAN_GW",    prvBootCanGateway, BOOT_SEQ_BIT(BOOT_STEP_CAN),                                 BOOT_SEQ_PHASE_EARLY },
+    [BOOT_STEP_GPIO]        = { "GPIO",      GPIOInit,          BOOT_SEQ_BIT(BOOT_STEP_PINS),                                BOOT_SEQ_PHASE_TASK },
+    [BOOT_STEP_UART]        = { "UART",      prvBootUart,       BOOT_SEQ_BIT(BOOT_STEP_PINS),                                BOOT_SEQ_PHASE_TASK },
+    [BOOT_STEP_ADC]         = { "ADC",       ADCInit,           BOOT_SEQ_BIT(BOOT_STEP_PINS) | BOOT_SEQ_BIT(BOOT_STEP_DMA),  BOOT_SEQ_PHASE_TASK },
+    [BOOT_STEP_DMA_COPY]    = { "DMA_Copy",  prvBootDmaCopy,    BOOT_SEQ_BIT(BOOT_STEP_ADC),                                 BOOT_SEQ_PHASE_TASK },
+    [BOOT_STEP_UART_RX]     = { "UART_RX",   prvBootUartRx,     BOOT_SEQ_BIT(BOOT_STEP_UART) | BOOT_SEQ_BIT(BOOT_STEP_ADC),  BOOT_SEQ_PHASE_TASK },
+    [BOOT_STEP_SBC]         = { "SBC",       prvBootSbc,        BOOT_SEQ_BIT(BOOT_STEP_PINS),                                BOOT_SEQ_PHASE_TASK },
+    [BOOT_STEP_SPI_QUEUE]   = { "SPI_Queue", prvBootSpiQueue,   BOOT_SEQ_BIT(BOOT_STEP_SBC) | BOOT_SEQ_BIT(BOOT_STEP_ADC),   BOOT_SEQ_PHASE_TASK },
+    [BOOT_STEP_RUN_GOV]     = { "Run_Gov",   prvBootRunGov,     BOOT_SEQ_BIT(BOOT_STEP_ADC),                                 BOOT_SEQ_PHASE_LAZY },
+    [BOOT_STEP_BANNER]      = { "Banner",    prvBootBanner,     BOOT_SEQ_BIT(BOOT_STEP_UART),                                BOOT_SEQ_PHASE_TASK },
+};
+
 #include "pins_driver.h"
 
-void BoardInit(void)
+static status_t prvBootClock(void)
 {
     /* Initialize and configure clocks
      *  -   Setup system clocks, dividers
@@ -159,19 +213,29 @@ void BoardInit(void)
      */
     CLOCK_SYS_Init(g_clockManConfigsArr, CLOCK_MANAGER_CONFIG_CNT,
                    g_clockManCallbacksArr, CLOCK_MANAGER_CALLBACK_CNT);
-    CLOCK_SYS_UpdateConfiguration(0U, CLOCK_MANAGER_POLICY_AGREEMENT);
+    return CLOCK_SYS_UpdateConfiguration(0U, CLOCK_MANAGER_POLICY_AGREEMENT);
+}
+
+static status_t prvBootPower(void)
+{
+    /* SMC_PMPROT is write once after reset: the only write, for every user */
+    SMC->PMPROT = CAN_PN_PMPROT | RUN_GOV_PMPROT;
+    return STATUS_SUCCESS;
+}
 
+static status_t prvBootPins(void)
+{
     /* Initialize pins
      *  -   See PinSettings component for more info
      */
-    PINS_DRV_Init(NUM_OF_CONFIGURED_PINS, g_pin_mux_InitConfigArr);
     /* Configure ports */
     // PINS_DRV_SetMuxModeSel(LED_PORT, LED1, PORT_MUX_AS_GPIO); 
     // PINS_DRV_SetMuxModeSel(LED_PORT, LED2, PORT_MUX_AS_GPIO);
     // PINS_DRV_SetMuxModeSel(BTN_PORT, BTN_PIN, PORT_MUX_AS_GPIO);
+    return PINS_DRV_Init(NUM_OF_CONFIGURED_PINS, g_pin_mux_InitConfigArr);
 }
 
-void GPIOInit(void)
+status_t GPIOInit(void)
 {
     /* Output direction for LEDs */
     PINS_DRV_SetPinsDirection(GPIO_PORT, (1 << LED1) | (1 << LED2));
@@ -197,26 +261,34 @@ void GPIOInit(void)
     /* The interrupt calls an interrupt safe API function - so its priority must
     be equal to or lower than configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY. */
     INT_SYS_SetPriority(BTN_PORT_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+
+    return STATUS_SUCCESS;
 }
 
-void ADCInit(void)
+status_t ADCInit(void)
 {
+    adc_config_t adcConfig = adc_pal1_InitConfig0;
+    extension_adc_s32k1xx_t adcExtension = *(extension_adc_s32k1xx_t *)(adc_pal1_InitConfig0.extension);
     adc_resolution_t resolution;
     status_t status;
+    uint8 adcBits;
 
-    resolution = ((extension_adc_s32k1xx_t *)(adc_pal1_InitConfig0.extension))->resolution;
+    resolution = adcExtension.resolution;
 
     if (resolution == ADC_RESOLUTION_8BIT)
     {
         adcMax = (uint16_t)(1 << 8);
+        adcBits = 8u;
     }
     else if (resolution == ADC_RESOLUTION_10BIT)
     {
         adcMax = (uint16_t)(1 << 10);
+        adcBits = 10u;
     }
     else
     {
         adcMax = (uint16_t)(1 << 12);
+        adcBits = 12u;
     }
 
     /* Initialize the ADC PAL
@@ -231,20 +303,44 @@ void ADCInit(void)
         DEV_ASSERT(adc_pal1_ChansArray02[i] == ADC_CHN);
     }
     DEV_ASSERT(adc_pal1_instance.instIdx == ADC_INSTANCE);
-    status = ADC_Init(&adc_pal1_instance, &adc_pal1_InitConfig0);
+    /* Restore the calibration saved on the first boot instead of calibrating */
+    adcExtension.calibration = AdcCal_Load();
+    adcConfig.extension = &adcExtension;
+    if (adcExtension.dmaEnable == true)
+    {
+        /* The ADC PAL initializes its fixed eDMA channels itself */
+        status = DmaMgr_Reserve(adcExtension.dmaChannel);
+        DEV_ASSERT(status == STATUS_SUCCESS);
+        status = DmaMgr_Reserve(adcExtension.dmaTrigChannel);
+        DEV_ASSERT(status == STATUS_SUCCESS);
+    }
+    status = ADC_Init(&adc_pal1_instance, &adcConfig);
     DEV_ASSERT(status == STATUS_SUCCESS);
+    if (adcExtension.calibration == NULL)
+    {
+        /* Not fatal, the next boot calibrates again */
+        (void)AdcCal_Save(ADC_INSTANCE, ADC_CAL_TEMP_UNKNOWN);
+    }
+    AdcApp_FilterInit(adcBits);
 
-    /* Send welcome message */
+    /* Start the conversions */
+#if ADC_SCHED_ENABLED
+    /* PDB0 paces the conversions instead of the PAL group */
+    AdcApp_SchedStart();
+#else
     /* Start the selected SW triggered group of conversions */
     status = ADC_StartGroupConversion(&adc_pal1_instance, selectedGroupIndex);
     DEV_ASSERT(status == STATUS_SUCCESS);
+#endif
+
+    return STATUS_SUCCESS;
 }
 
 /*-----------------------------------------------------------*/
 
 void rtos_start(void)
 {
-    /* Configure the NVIC, LED outputs and button inputs. */
+    /* Clock, pins, eDMA and CAN, the rest comes up in vBootSeq. */
     prvSetupHardware();
 
     /* Create the queue. */
@@ -253,10 +349,13 @@ void rtos_start(void)
     /* Creat led control sig queue. */
     xLedCtrlSig = xQueueCreate(mainQUEUE_LENGTH, sizeof(uint8));
     /* voltage signal from adc . */
-    xVolSig = xQueueCreate(mainQUEUE_LENGTH, sizeof(float32));
+    xVolSig = xQueueCreate(mainQUEUE_LENGTH, sizeof(AdcUnits_MvType));
 
     if (xQueue != NULL)
     {
+        /* First, the tasks below wait in BootSeq_Require for their steps */
+        (void)BootSeq_Start();
+
         /* Start the two tasks as described in the comments at the top of this
         file. */
 
@@ -269,6 +368,17 @@ void rtos_start(void)
         xTaskCreate(vAdcApp, "ADC_Voltage_Calculate", TASK_ADC_STACK_SIZE, NULL, mainQUEUE_SEND_TASK_PRIORITY, NULL);
 
         xTaskCreate(vCanApp, "CAN_Communication", TASK_CAN_STACK_SIZE, NULL, mainQUEUE_SEND_TASK_PRIORITY, NULL);
+#if CAN_TRACE_ENABLED
+        xTaskCreate(vCanTraceFlush, "CAN_Trace", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL);
+#endif
+#if SBC_SVC_ENABLED
+        /* Configures the SBC and starts the watchdog, then deletes itself */
+        xTaskCreate(vSbcSvc, "SBC_Service", configMINIMAL_STACK_SIZE, NULL, mainQUEUE_RECEIVE_TASK_PRIORITY, NULL);
+#endif
+#if RUN_GOV_ENABLED
+        /* Above the application tasks so a busy system is seen at once */
+        xTaskCreate(vRunGov, "Run_Governor", RUN_GOV_STACK_SIZE, NULL, mainQUEUE_RECEIVE_TASK_PRIORITY, NULL);
+#endif
 
         /* Create the software timer that is responsible for turning off the LED
         if the button is not pushed within 5000ms, as described at the top of
@@ -374,6 +484,7 @@ static void prvQueueReceiveTask(void *pvParameters)
 
     /* Casting pvParameters to void because it is unused */
     (void)pvParameters;
+    (void)BootSeq_Require(BOOT_SEQ_BIT(BOOT_STEP_GPIO), portMAX_DELAY);
 
     for (;;)
     {
@@ -404,22 +515,104 @@ static void prvQueueReceiveTask(void *pvParameters)
 
 static void prvSetupHardware(void)
 {
-    status_t status;
-    
-    BoardInit();
-    GPIOInit();
-    ADCInit();
+    BootSeq_Init(s_bootSteps, BOOT_STEP_COUNT);
+    BootSeq_RunEarly();
+}
+/*-----------------------------------------------------------*/
+
+static status_t prvBootDma(void)
+{
+    /* eDMA first, drivers take their channels from the manager */
+    return DmaMgr_Init();
+}
+
+static status_t prvBootCan(void)
+{
+    /* Initial CAN */
+    return CAN_Init(&can_pal1_instance, &can_pal1_Config0);
+}
+
+static status_t prvBootCanGateway(void)
+{
+#if CAN_GATEWAY_ENABLED
+    /* Subscribe the routed IDs before vCanApp compiles the CAN0 filters */
+    return CanGw_Init();
+#else
+    return STATUS_SUCCESS;
+#endif
+}
+
+static status_t prvBootUart(void)
+{
+    lpuart_user_config_t uartConfig;
 
     /* Initialize LPUART instance
      *  -   See LPUART component for configuration details
-     * If the initialization failed, trigger an hardware breakpoint
      */
-    status = LPUART_DRV_Init(INST_LPUART1, &lpuart1_State, &lpuart1_InitConfig0);
-    DEV_ASSERT(status == STATUS_SUCCESS);
+    uartConfig = lpuart1_InitConfig0;
+    uartConfig.fifoEnable = (UART_APP_FIFO_ENABLED != 0U) ? true : false;
+    return LPUART_DRV_Init(INST_LPUART1, &lpuart1_State, &uartConfig);
+}
 
-    /* Initial CAN */
-    CAN_Init(&can_pal1_instance, &can_pal1_Config0);
+static status_t prvBootDmaCopy(void)
+{
+    /* After the fixed channels are reserved */
+    return DmaCopy_Init();
+}
+
+static status_t prvBootUartRx(void)
+{
+#if UART_RX_ENABLED
+    /* Receive through the eDMA ring, print() keeps the SDK transmit path */
+    return UartRx_Init(INST_LPUART1);
+#else
+    return STATUS_SUCCESS;
+#endif
+}
+
+static status_t prvBootSbc(void)
+{
+#if SBC_SVC_ENABLED
+    /* The SBC itself is configured by vSbcSvc */
+    return SbcSvc_Init(LPSPICOM1, &lpspiCom1State, &lpspiCom1_MasterConfig0);
+#else
+    return STATUS_SUCCESS;
+#endif
+}
+
+static status_t prvBootSpiQueue(void)
+{
+#if SPI_QUEUE_ENABLED
+    status_t status = STATUS_SUCCESS;
+
+#if (SBC_SVC_ENABLED == 0U)
+    status = LPSPI_DRV_MasterInit(LPSPICOM1, &lpspiCom1State, &lpspiCom1_MasterConfig0);
+#endif
+    if (status == STATUS_SUCCESS)
+    {
+        /* Shares LPSPI1 with the SBC service, run sequences under SbcSvc_Lock */
+        status = SpiQueue_Init(LPSPICOM1);
+    }
+    return status;
+#else
+    return STATUS_SUCCESS;
+#endif
+}
+
+static status_t prvBootRunGov(void)
+{
+#if RUN_GOV_ENABLED
+    /* After ADC: the D-Flash writes of ADCInit are not allowed in HSRUN */
+    return RunGov_Init(g_clockManCallbacksArr, CLOCK_MANAGER_CALLBACK_CNT);
+#else
+    return STATUS_SUCCESS;
+#endif
+}
+
+static status_t prvBootBanner(void)
+{
     print(initOKStr);
+    return STATUS_SUCCESS;
 }
 /*-----------------------------------------------------------*/
 
@@ -458,6 +651,9 @@ void vApplicationIdleHook(void)
     does nothing useful, other than report the amount of FreeRTOS heap that
     remains unallocated. */
     xFreeHeapSpace = xPortGetFreeHeapSize();
+#if RUN_GOV_ENABLED
+    RunGov_IdleHook();
+#endif
 
     if (xFreeHeapSpace > 100)
     {
@@ -0,0 +1,586 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file sbc_svc.c
+ * @brief UJA116x service: window watchdog fed from LPTMR0, SBC events
+ *        delivered through an event group, arbitrated access to the LPSPI
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * The service owns the LPSPI bus of the SBC. Every access is a job: the
+ * watchdog feed, the event read, the event clear, or a task holding the bus
+ * through SbcSvc_Lock. One job runs at a time, the next one is started from
+ * the completion of the previous one, in that priority order. The feed and
+ * event jobs are started from interrupts with SBC_BatchTransferStart and
+ * never wait for a task.
+ *
+ * LPTMR0 fires at SBC_SVC_FEED_NUM / SBC_SVC_FEED_DEN of the nominal period
+ * T. Each feed restarts the SBC watchdog, so a feed delayed by d lands at
+ * 3T/4 + d and the next interval is 3T/4 - d: both leave the window
+ * [T/2, T] at d = T/4, which is the failure point and not a budget. A task
+ * holds the lock for at most T/8 minus one full SPI batch, the batch being
+ * the worst transaction the feed may still wait for. SbcSvc_Unlock counts
+ * the holds over that limit in lockOverruns.
+ *
+ * While the service runs, tasks use the blocking SBC_* functions only
+ * between SbcSvc_Lock and SbcSvc_Unlock. The LPTMR, LPSPI and pin
+ * interrupts share one priority, so the job state needs no locking between
+ * them.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "sbc_svc.h"
+#include "interrupt_manager.h"
+#include "cycle_counter.h"
+#include "boot_seq.h"
+#include "pins_driver.h"
+#include "task.h"
+#include "semphr.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define SBC_SVC_JOB_NONE            (0x00U)
+#define SBC_SVC_JOB_FEED            (0x01U)
+#define SBC_SVC_JOB_EVT_CLEAR       (0x02U)
+#define SBC_SVC_JOB_EVT_READ        (0x04U)
+#define SBC_SVC_JOB_LOCK            (0x08U)
+
+#define SBC_SVC_NUM_EVT_REGS        (5U)
+
+/* Local Parameters ---------------------------------------------------------*/
+static EventGroupHandle_t s_sbcSvcEvents = NULL;
+static SemaphoreHandle_t s_sbcSvcMutex = NULL;
+static TaskHandle_t s_sbcSvcLockWaiter = NULL;
+static boolean s_sbcSvcStarted = false;
+
+static volatile uint8 s_sbcSvcJob = SBC_SVC_JOB_NONE;
+static volatile uint8 s_sbcSvcPending = SBC_SVC_JOB_NONE;
+static uint32 s_sbcSvcFeedCount;
+
+static sbc_reg_op_t s_sbcSvcFeedOp;
+static sbc_reg_op_t s_sbcSvcEvtOps[SBC_SVC_NUM_EVT_REGS];
+static sbc_reg_op_t s_sbcSvcClearOps[SBC_SVC_NUM_EVT_REGS - 1U];
+static uint8 s_sbcSvcClearCount;
+
+static SbcSvc_StatsType s_sbcSvcStats;
+
+/* Longest SPI batch and lock hold in us, start of the current hold */
+static uint32 s_sbcSvcSpiWorstUs;
+static uint32 s_sbcSvcLockLimitUs;
+static uint32 s_sbcSvcLockStamp;
+
+/* Local Functions ----------------------------------------------------------*/
+static void SbcSvc_BatchDone(sbc_reg_op_t *ops, uint8_t count, status_t status, void *param);
+
+static uint32 SbcSvc_PeriodMs(sbc_wtdog_ctr_nwp_t period)
+{
+    switch (period)
+    {
+    case SBC_UJA_WTDOG_CTR_NWP_8:    return 8u;
+    case SBC_UJA_WTDOG_CTR_NWP_16:   return 16u;
+    case SBC_UJA_WTDOG_CTR_NWP_32:   return 32u;
+    case SBC_UJA_WTDOG_CTR_NWP_64:   return 64u;
+    case SBC_UJA_WTDOG_CTR_NWP_128:  return 128u;
+    case SBC_UJA_WTDOG_CTR_NWP_256:  return 256u;
+    case SBC_UJA_WTDOG_CTR_NWP_1024: return 1024u;
+    default:                         return 4096u;
+    }
+}
+
+/*
+ * Start the highest priority pending job if the bus is free. Called from
+ * the service interrupts, or from a task with interrupts disabled.
+ */
+static void SbcSvc_Kick(BaseType_t *higherPriorityTaskWoken)
+{
+    sbc_reg_op_t *ops;
+    uint8 count;
+    uint8 job;
+
+    if ((s_sbcSvcJob != SBC_SVC_JOB_NONE) || (s_sbcSvcPending == SBC_SVC_JOB_NONE))
+    {
+        return;
+    }
+
+    if ((s_sbcSvcPending & SBC_SVC_JOB_FEED) != 0u)
+    {
+        job = SBC_SVC_JOB_FEED;
+        ops = &s_sbcSvcFeedOp;
+        count = 1u;
+    }
+    else if ((s_sbcSvcPending & SBC_SVC_JOB_EVT_CLEAR) != 0u)
+    {
+        job = SBC_SVC_JOB_EVT_CLEAR;
+        ops = s_sbcSvcClearOps;
+        count = s_sbcSvcClearCount;
+    }
+    else if ((s_sbcSvcPending & SBC_SVC_JOB_EVT_READ) != 0u)
+    {
+        job = SBC_SVC_JOB_EVT_READ;
+        ops = s_sbcSvcEvtOps;
+        count = SBC_SVC_NUM_EVT_REGS;
+    }
+    else
+    {
+        /* Hand the bus to the task waiting in SbcSvc_Lock */
+        s_sbcSvcPending &= (uint8)~SBC_SVC_JOB_LOCK;
+        s_sbcSvcJob = SBC_SVC_JOB_LOCK;
+        s_sbcSvcLockStamp = CycleCounter_Get();
+        if (higherPriorityTaskWoken != NULL)
+        {
+            vTaskNotifyGiveFromISR(s_sbcSvcLockWaiter, higherPriorityTaskWoken);
+        }
+        else
+        {
+            xTaskNotifyGive(s_sbcSvcLockWaiter);
+        }
+        return;
+    }
+
+    if (SBC_BatchTransferStart(ops, count, SbcSvc_BatchDone, NULL) == STATUS_SUCCESS)
+    {
+        s_sbcSvcPending &= (uint8)~job;
+        s_sbcSvcJob = job;
+    }
+    else
+    {
+        /* Retried with the next timer or pin interrupt */
+        s_sbcSvcStats.errors++;
+    }
+}
+
+/* Event capture registers read, deliver them and queue the clear */
+static void SbcSvc_EventsRead(BaseType_t *higherPriorityTaskWoken)
+{
+    static const uint8 shifts[SBC_SVC_NUM_EVT_REGS - 1U] =
+    {
+        SBC_SVC_EVT_SYS_SHIFT, SBC_SVC_EVT_SUP_SHIFT, SBC_SVC_EVT_TRANS_SHIFT, SBC_SVC_EVT_WAKE_SHIFT
+    };
+    EventBits_t bits = 0u;
+    uint8 i;
+
+    s_sbcSvcStats.eventReads++;
+    s_sbcSvcClearCount = 0u;
+
+    for (i = 1u; i < SBC_SVC_NUM_EVT_REGS; i++)
+    {
+        uint8 value = s_sbcSvcEvtOps[i].data;
+
+        if (value != 0u)
+        {
+            bits |= (EventBits_t)value << shifts[i - 1u];
+            /* Write 1 to clear */
+            s_sbcSvcClearOps[s_sbcSvcClearCount].regName = s_sbcSvcEvtOps[i].regName;
+            s_sbcSvcClearOps[s_sbcSvcClearCount].isWrite = true;
+            s_sbcSvcClearOps[s_sbcSvcClearCount].data = value;
+            s_sbcSvcClearCount++;
+        }
+    }
+
+    if (s_sbcSvcClearCount != 0u)
+    {
+        s_sbcSvcPending |= SBC_SVC_JOB_EVT_CLEAR;
+    }
+
+    if ((bits & SBC_SVC_EVT_POWER_ON) != 0u)
+    {
+        /* The SBC went through a power-on reset, its registers are defaults */
+        SBC_ShadowInvalidate();
+    }
+
+    if (bits != 0u)
+    {
+        s_sbcSvcStats.events++;
+        (void)xEventGroupSetBitsFromISR(s_sbcSvcEvents, bits, higherPriorityTaskWoken);
+    }
+}
+
+static void SbcSvc_BatchDone(sbc_reg_op_t *ops, uint8_t count, status_t status, void *param)
+{
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    uint8 job = s_sbcSvcJob;
+
+    (void)ops;
+    (void)count;
+    (void)param;
+
+    s_sbcSvcJob = SBC_SVC_JOB_NONE;
+
+    if (status != STATUS_SUCCESS)
+    {
+        s_sbcSvcStats.errors++;
+        (void)xEventGroupSetBitsFromISR(s_sbcSvcEvents, SBC_SVC_EVT_COMM_ERROR, &higherPriorityTaskWoken);
+    }
+    else if (job == SBC_SVC_JOB_FEED)
+    {
+        s_sbcSvcStats.feeds++;
+    }
+    else if (job == SBC_SVC_JOB_EVT_READ)
+    {
+        SbcSvc_EventsRead(&higherPriorityTaskWoken);
+    }
+    else
+    {
+        /* Events cleared */
+    }
+
+    SbcSvc_Kick(&higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+static void SbcSvc_TimerIrqHandler(void)
+{
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+    LPTMR_DRV_ClearCompareFlag(INST_LPTMR1);
+
+    if (s_sbcSvcJob != SBC_SVC_JOB_NONE)
+    {
+        s_sbcSvcStats.deferredFeeds++;
+    }
+    s_sbcSvcPending |= SBC_SVC_JOB_FEED;
+
+#if (SBC_SVC_INT_PIN_ENABLED == 0U)
+    s_sbcSvcFeedCount++;
+    if (s_sbcSvcFeedCount >= SBC_SVC_POLL_FEEDS)
+    {
+        s_sbcSvcFeedCount = 0u;
+        s_sbcSvcPending |= SBC_SVC_JOB_EVT_READ;
+    }
+#endif
+
+    SbcSvc_Kick(&higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+#if SBC_SVC_INT_PIN_ENABLED
+static void SbcSvc_PinIrqHandler(void)
+{
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+    PINS_DRV_ClearPinIntFlagCmd(SBC_SVC_INT_PORT, SBC_SVC_INT_PIN);
+    s_sbcSvcPending |= SBC_SVC_JOB_EVT_READ;
+
+    SbcSvc_Kick(&higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+#endif
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Initialize the LPSPI master of the SBC and the service objects.
+ *
+ * Does not access the SBC, so it can run before the scheduler starts.
+ *
+ * @param instance LPSPI instance wired to the SBC
+ * @param spiState LPSPI driver state
+ * @param spiConfig LPSPI master configuration, 16 bit frames
+ * @return STATUS_SUCCESS or the LPSPI error
+ *-----------------------------------------------------------------------------
+ */
+status_t SbcSvc_Init(uint32 instance, lpspi_state_t *spiState,
+                     const lpspi_master_config_t *spiConfig)
+{
+    status_t status;
+
+    DEV_ASSERT(spiConfig->bitcount == 16u);
+    DEV_ASSERT(s_sbcSvcEvents == NULL);
+
+    status = LPSPI_DRV_MasterInit(instance, spiState, spiConfig);
+    if (status != STATUS_SUCCESS)
+    {
+        return status;
+    }
+    /* Batch completions set event bits and start the next job */
+    INT_SYS_SetPriority(g_lpspiIrqId[instance], configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+    s_sbcSvcSpiWorstUs = ((SBC_UJA_BATCH_MAX_OPS * 16u * 1000000u) + spiConfig->bitsPerSec - 1u) /
+                         spiConfig->bitsPerSec;
+
+    s_sbcSvcEvents = xEventGroupCreate();
+    s_sbcSvcMutex = xSemaphoreCreateMutex();
+    DEV_ASSERT((s_sbcSvcEvents != NULL) && (s_sbcSvcMutex != NULL));
+
+    s_sbcSvcEvtOps[0].regName = SBC_UJA_GL_EVNT_STAT;
+    s_sbcSvcEvtOps[1].regName = SBC_UJA_SYS_EVNT_STAT;
+    s_sbcSvcEvtOps[2].regName = SBC_UJA_SUP_EVNT_STAT;
+    s_sbcSvcEvtOps[3].regName = SBC_UJA_TRANS_EVNT_STAT;
+    s_sbcSvcEvtOps[4].regName = SBC_UJA_WAKE_EVNT_STAT;
+
+    SBC_InitDriver(instance);
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Configure the SBC, switch it to Normal mode with the watchdog in
+ *        Window mode and start feeding it.
+ *
+ * Must run in a task, the SBC driver waits for the LPSPI transfers.
+ *
+ * @param config SBC configuration, its watchdog settings are replaced
+ * @param period Nominal watchdog period
+ * @return STATUS_SUCCESS or the SBC error
+ *-----------------------------------------------------------------------------
+ */
+status_t SbcSvc_Start(const sbc_int_config_t *config, sbc_wtdog_ctr_nwp_t period)
+{
+    sbc_wtdog_ctr_t wtdog;
+    lptmr_config_t tmrConfig;
+    status_t status;
+
+    DEV_ASSERT(s_sbcSvcEvents != NULL);
+    DEV_ASSERT(s_sbcSvcStarted == false);
+
+    /* Keep SbcSvc_Lock callers off the bus until the interrupts own it */
+    (void)xSemaphoreTake(s_sbcSvcMutex, portMAX_DELAY);
+
+    status = SBC_InitDevice(config);
+    if (status == STATUS_SUCCESS)
+    {
+        /* Window mode is only active in Normal mode */
+        wtdog.modeControl = SBC_UJA_WTDOG_CTR_WMC_WIND;
+        wtdog.nominalPeriod = period;
+        status = SBC_SetWatchdog(&wtdog);
+    }
+    if (status == STATUS_SUCCESS)
+    {
+        status = SBC_SetMode(SBC_UJA_MODE_MC_NORMAL);
+    }
+    if (status != STATUS_SUCCESS)
+    {
+        (void)xSemaphoreGive(s_sbcSvcMutex);
+        return status;
+    }
+
+    /* A write of the same settings is the watchdog trigger */
+    s_sbcSvcFeedOp.regName = SBC_UJA_WTDOG_CTR;
+    s_sbcSvcFeedOp.isWrite = true;
+    s_sbcSvcFeedOp.data = (uint8)((uint8)wtdog.modeControl | (uint8)wtdog.nominalPeriod);
+
+    s_sbcSvcLockLimitUs = (SbcSvc_PeriodMs(period) * 1000u) / SBC_SVC_LOCK_DIV;
+    DEV_ASSERT(s_sbcSvcLockLimitUs > s_sbcSvcSpiWorstUs);
+    s_sbcSvcLockLimitUs -= s_sbcSvcSpiWorstUs;
+
+    /* 128 us resolution, up to 8.3 s */
+    tmrConfig = lpTmr1_config0;
+    tmrConfig.workMode = LPTMR_WORKMODE_TIMER;
+    tmrConfig.interruptEnable = true;
+    tmrConfig.freeRun = false;
+    tmrConfig.prescaler = LPTMR_PRESCALE_1024_GLITCHFILTER_512;
+    tmrConfig.bypassPrescaler = false;
+    tmrConfig.counterUnits = LPTMR_COUNTER_UNITS_MICROSECONDS;
+    tmrConfig.compareValue = (SbcSvc_PeriodMs(period) * 1000u * SBC_SVC_FEED_NUM) / SBC_SVC_FEED_DEN;
+    LPTMR_DRV_Init(INST_LPTMR1, &tmrConfig, false);
+
+    INT_SYS_SetPriority(LPTMR0_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+    INT_SYS_InstallHandler(LPTMR0_IRQn, SbcSvc_TimerIrqHandler, (isr_t *)NULL);
+    INT_SYS_EnableIRQ(LPTMR0_IRQn);
+
+#if SBC_SVC_INT_PIN_ENABLED
+    PINS_DRV_SetMuxModeSel(SBC_SVC_INT_PORT, SBC_SVC_INT_PIN, PORT_MUX_AS_GPIO);
+    PINS_DRV_SetPinDirection(SBC_SVC_INT_GPIO, SBC_SVC_INT_PIN, 0u);
+    PINS_DRV_SetPinIntSel(SBC_SVC_INT_PORT, SBC_SVC_INT_PIN, PORT_INT_FALLING_EDGE);
+    INT_SYS_SetPriority(SBC_SVC_INT_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+    INT_SYS_InstallHandler(SBC_SVC_INT_IRQn, SbcSvc_PinIrqHandler, (isr_t *)NULL);
+    INT_SYS_EnableIRQ(SBC_SVC_INT_IRQn);
+#endif
+
+    /* Events latched before the start, the pin edge may be gone already */
+    INT_SYS_DisableIRQGlobal();
+    s_sbcSvcStarted = true;
+    s_sbcSvcPending |= SBC_SVC_JOB_EVT_READ;
+    SbcSvc_Kick(NULL);
+    LPTMR_DRV_StartCounter(INST_LPTMR1);
+    INT_SYS_EnableIRQGlobal();
+
+    (void)xSemaphoreGive(s_sbcSvcMutex);
+    return STATUS_SUCCESS;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Event group with the SBC_SVC_EVT_* bits.
+ *
+ * Subscribers wait on it and clear the bits they handle.
+ *
+ * @return Event group, NULL before SbcSvc_Init
+ *-----------------------------------------------------------------------------
+ */
+EventGroupHandle_t SbcSvc_GetEventGroup(void)
+{
+    return s_sbcSvcEvents;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Take the SBC bus for blocking SBC_* calls.
+ *
+ * Waits for the running feed or event job. Release it with SbcSvc_Unlock
+ * within SbcSvc_GetLockLimitUs, T/8 of the watchdog period minus one SPI
+ * batch; a feed delayed by T/4 already misses the window.
+ *
+ * @param timeoutMs Maximum wait
+ * @return STATUS_SUCCESS or STATUS_TIMEOUT
+ *-----------------------------------------------------------------------------
+ */
+status_t SbcSvc_Lock(uint32 timeoutMs)
+{
+    TickType_t ticks = pdMS_TO_TICKS(timeoutMs);
+    TimeOut_t timeOut;
+    boolean granted;
+
+    vTaskSetTimeOutState(&timeOut);
+    if (xSemaphoreTake(s_sbcSvcMutex, ticks) != pdTRUE)
+    {
+        return STATUS_TIMEOUT;
+    }
+    if (s_sbcSvcStarted == false)
+    {
+        /* No interrupt uses the bus yet */
+        return STATUS_SUCCESS;
+    }
+
+    s_sbcSvcLockWaiter = xTaskGetCurrentTaskHandle();
+
+    INT_SYS_DisableIRQGlobal();
+    if ((s_sbcSvcJob == SBC_SVC_JOB_NONE) && (s_sbcSvcPending == SBC_SVC_JOB_NONE))
+    {
+        s_sbcSvcJob = SBC_SVC_JOB_LOCK;
+        s_sbcSvcLockStamp = CycleCounter_Get();
+        granted = true;
+    }
+    else
+    {
+        /* Granted with a notification when the jobs before are done */
+        s_sbcSvcPending |= SBC_SVC_JOB_LOCK;
+        granted = false;
+    }
+    INT_SYS_EnableIRQGlobal();
+
+    if (granted == true)
+    {
+        return STATUS_SUCCESS;
+    }
+
+    s_sbcSvcStats.lockWaits++;
+    (void)xTaskCheckForTimeOut(&timeOut, &ticks);
+    (void)ulTaskNotifyTake(pdTRUE, ticks);
+
+    INT_SYS_DisableIRQGlobal();
+    granted = (s_sbcSvcJob == SBC_SVC_JOB_LOCK) ? true : false;
+    s_sbcSvcPending &= (uint8)~SBC_SVC_JOB_LOCK;
+    INT_SYS_EnableIRQGlobal();
+
+    if (granted == false)
+    {
+        (void)xSemaphoreGive(s_sbcSvcMutex);
+        return STATUS_TIMEOUT;
+    }
+    /* Granted right after the timeout, drop the notification */
+    (void)ulTaskNotifyTake(pdTRUE, 0u);
+    return STATUS_SUCCESS;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Release the SBC bus taken by SbcSvc_Lock, deferred jobs start now.
+ *-----------------------------------------------------------------------------
+ */
+void SbcSvc_Unlock(void)
+{
+    uint32 heldUs;
+
+    if (s_sbcSvcStarted == true)
+    {
+        INT_SYS_DisableIRQGlobal();
+        heldUs = CYCLES_TO_US(CycleCounter_Get() - s_sbcSvcLockStamp);
+        if (heldUs > s_sbcSvcStats.maxLockUs)
+        {
+            s_sbcSvcStats.maxLockUs = heldUs;
+        }
+        if (heldUs > s_sbcSvcLockLimitUs)
+        {
+            s_sbcSvcStats.lockOverruns++;
+        }
+        s_sbcSvcJob = SBC_SVC_JOB_NONE;
+        SbcSvc_Kick(NULL);
+        INT_SYS_EnableIRQGlobal();
+    }
+    (void)xSemaphoreGive(s_sbcSvcMutex);
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Longest SbcSvc_Lock hold that keeps the feeds inside the window.
+ *
+ * @return Limit in us, 0 before SbcSvc_Start
+ *-----------------------------------------------------------------------------
+ */
+uint32 SbcSvc_GetLockLimitUs(void)
+{
+    return s_sbcSvcLockLimitUs;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Run register accesses in one batched transfer.
+ *
+ * @param ops Register accesses, read data is stored back to it
+ * @param count Number of accesses, up to SBC_UJA_BATCH_MAX_OPS
+ * @param timeoutMs Maximum wait for the bus
+ * @return STATUS_SUCCESS, STATUS_TIMEOUT or the SBC error
+ *-----------------------------------------------------------------------------
+ */
+status_t SbcSvc_Transfer(sbc_reg_op_t *ops, uint8 count, uint32 timeoutMs)
+{
+    status_t status;
+
+    status = SbcSvc_Lock(timeoutMs);
+    if (status != STATUS_SUCCESS)
+    {
+        return status;
+    }
+    status = SBC_BatchTransfer(ops, count);
+    SbcSvc_Unlock();
+
+    return status;
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Copy the service counters.
+ *
+ * @param stats Counters since SbcSvc_Init
+ *-----------------------------------------------------------------------------
+ */
+void SbcSvc_GetStats(SbcSvc_StatsType *stats)
+{
+    INT_SYS_DisableIRQGlobal();
+    *stats = s_sbcSvcStats;
+    INT_SYS_EnableIRQGlobal();
+}
+
+/**
+ *-----------------------------------------------------------------------------
+ * @brief Bring the SBC up with the generated configuration and start the
+ *        service, then end. The SBC driver needs the scheduler running.
+ *
+ * @param pvParameters Unused
+ *-----------------------------------------------------------------------------
+ */
+void vSbcSvc(void *pvParameters)
+{
+    status_t status;
+
+    (void)pvParameters;
+
+    status = BootSeq_Require(BOOT_SEQ_BIT(BOOT_STEP_SBC), portMAX_DELAY);
+    DEV_ASSERT(status == STATUS_SUCCESS);
+    status = SbcSvc_Start(&sbc_uja116x1_InitConfig0, SBC_SVC_WATCHDOG_PERIOD);
+    DEV_ASSERT(status == STATUS_SUCCESS);
+    (void)status;
+
+    vTaskDelete(NULL);
+}
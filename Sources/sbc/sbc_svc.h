@@ -0,0 +1,91 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file sbc_svc.h
+ * @brief UJA116x service: window watchdog fed from LPTMR0, SBC events
+ *        delivered through an event group, arbitrated access to the LPSPI
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _SBC_SVC_H_
+#define _SBC_SVC_H_
+
+#include "FreeRTOS.h"
+#include "event_groups.h"
+#include "Rte_Type.h"
+#include "Cpu.h"
+
+/* Macro Define -------------------------------------------------------------*/
+/* Create vSbcSvc, which starts the service on lpspiCom1 */
+#define SBC_SVC_ENABLED             (0U)
+
+#define SBC_SVC_WATCHDOG_PERIOD     SBC_UJA_WTDOG_CTR_NWP_64
+
+/* Feed at 3/4 of the nominal period, the window is its second half */
+#define SBC_SVC_FEED_NUM            (3U)
+#define SBC_SVC_FEED_DEN            (4U)
+
+/* SbcSvc_Lock is held for at most period / SBC_SVC_LOCK_DIV minus one full
+ * SPI batch, see SbcSvc_GetLockLimitUs */
+#define SBC_SVC_LOCK_DIV            (8U)
+
+/* 1: read the events on a falling edge of the SBC interrupt pin,
+ * 0: read them every SBC_SVC_POLL_FEEDS feeds */
+#define SBC_SVC_INT_PIN_ENABLED     (0U)
+#define SBC_SVC_INT_PORT            PORTE
+#define SBC_SVC_INT_GPIO            PTE
+#define SBC_SVC_INT_PIN             (11U)   /* Board specific */
+#define SBC_SVC_INT_IRQn            PORTE_IRQn
+#define SBC_SVC_POLL_FEEDS          (4U)
+
+/* Event group bits, the event capture registers packed side by side */
+#define SBC_SVC_EVT_SYS_SHIFT       (0U)
+#define SBC_SVC_EVT_SUP_SHIFT       (5U)
+#define SBC_SVC_EVT_TRANS_SHIFT     (8U)
+#define SBC_SVC_EVT_WAKE_SHIFT      (14U)
+
+#define SBC_SVC_EVT_WATCHDOG_FAIL   ((EventBits_t)SBC_UJA_SYS_EVNT_STAT_WDF_MASK << SBC_SVC_EVT_SYS_SHIFT)
+#define SBC_SVC_EVT_SPI_FAIL        ((EventBits_t)SBC_UJA_SYS_EVNT_STAT_SPIF_MASK << SBC_SVC_EVT_SYS_SHIFT)
+#define SBC_SVC_EVT_OVERTEMP        ((EventBits_t)SBC_UJA_SYS_EVNT_STAT_OTW_MASK << SBC_SVC_EVT_SYS_SHIFT)
+#define SBC_SVC_EVT_POWER_ON        ((EventBits_t)SBC_UJA_SYS_EVNT_STAT_PO_MASK << SBC_SVC_EVT_SYS_SHIFT)
+#define SBC_SVC_EVT_V1_UNDER        ((EventBits_t)SBC_UJA_SUP_EVNT_STAT_V1U_MASK << SBC_SVC_EVT_SUP_SHIFT)
+#define SBC_SVC_EVT_V2_UNDER        ((EventBits_t)SBC_UJA_SUP_EVNT_STAT_V2U_MASK << SBC_SVC_EVT_SUP_SHIFT)
+#define SBC_SVC_EVT_V2_OVER         ((EventBits_t)SBC_UJA_SUP_EVNT_STAT_V2O_MASK << SBC_SVC_EVT_SUP_SHIFT)
+#define SBC_SVC_EVT_CAN_WAKE        ((EventBits_t)SBC_UJA_TRANS_EVNT_STAT_CW_MASK << SBC_SVC_EVT_TRANS_SHIFT)
+#define SBC_SVC_EVT_CAN_FAIL        ((EventBits_t)SBC_UJA_TRANS_EVNT_STAT_CF_MASK << SBC_SVC_EVT_TRANS_SHIFT)
+#define SBC_SVC_EVT_CAN_SILENCE     ((EventBits_t)SBC_UJA_TRANS_EVNT_STAT_CBS_MASK << SBC_SVC_EVT_TRANS_SHIFT)
+#define SBC_SVC_EVT_PN_FRAME        ((EventBits_t)SBC_UJA_TRANS_EVNT_STAT_PNFDE_MASK << SBC_SVC_EVT_TRANS_SHIFT)
+#define SBC_SVC_EVT_WAKE_FALLING    ((EventBits_t)SBC_UJA_WAKE_EVNT_STAT_WPF_MASK << SBC_SVC_EVT_WAKE_SHIFT)
+#define SBC_SVC_EVT_WAKE_RISING     ((EventBits_t)SBC_UJA_WAKE_EVNT_STAT_WPR_MASK << SBC_SVC_EVT_WAKE_SHIFT)
+#define SBC_SVC_EVT_COMM_ERROR      ((EventBits_t)1U << 16U)  /* A feed or event read failed */
+
+/* Type Define --------------------------------------------------------------*/
+typedef struct
+{
+    uint32 feeds;
+    uint32 deferredFeeds;           /* Timer fired while the bus was in use */
+    uint32 eventReads;
+    uint32 events;                  /* Event bits delivered */
+    uint32 lockWaits;               /* SbcSvc_Lock waited for the service */
+    uint32 lockOverruns;            /* Lock held longer than the limit */
+    uint32 maxLockUs;               /* Longest lock hold */
+    uint32 errors;
+} SbcSvc_StatsType;
+
+/* Export Parameters --------------------------------------------------------*/
+extern status_t SbcSvc_Init(uint32 instance, lpspi_state_t *spiState,
+                            const lpspi_master_config_t *spiConfig);
+extern status_t SbcSvc_Start(const sbc_int_config_t *config, sbc_wtdog_ctr_nwp_t period);
+extern EventGroupHandle_t SbcSvc_GetEventGroup(void);
+extern status_t SbcSvc_Lock(uint32 timeoutMs);
+extern void SbcSvc_Unlock(void);
+extern uint32 SbcSvc_GetLockLimitUs(void);
+extern status_t SbcSvc_Transfer(sbc_reg_op_t *ops, uint8 count, uint32 timeoutMs);
+extern void SbcSvc_GetStats(SbcSvc_StatsType *stats);
+extern void vSbcSvc(void *pvParameters);
+
+#endif
@@ -0,0 +1,245 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file adc_filter_test.c
+ * @brief Host test of the ADC oversampling pipeline, bit exact outputs
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * The host build takes the plain C path of adc_filter.c, which must match
+ * SMLAD and SSAT on the target. The expected outputs are worked out by hand
+ * from the CIC difference equations and the Q15/Q14 products, including a
+ * saturated SSAT and an SMLAD accumulator that wraps around.
+ *
+ * With order 1 and R = 8 from 12 bit samples the CIC output is the sum of
+ * each block of 8 samples without scaling, so a block of 8 equal samples
+ * feeds the FIR/biquad stage with 8 times their value.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "host_test.h"
+#include "adc_filter.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define TEST_BLOCK                  (8U)
+#define TEST_MAX_OUT                (16U)
+
+/* Local Functions ----------------------------------------------------------*/
+/* One CIC output of value 8 * sample per block of 8 samples */
+static uint32 TestFeedBlocks(AdcFilter_StateType *state, const uint16 *blockValues, uint32 numBlocks,
+                             sint16 *out)
+{
+    uint16 samples[TEST_BLOCK];
+    uint32 b, i, numOut = 0u;
+
+    for (b = 0u; b < numBlocks; b++)
+    {
+        for (i = 0u; i < TEST_BLOCK; i++)
+        {
+            samples[i] = blockValues[b];
+        }
+        numOut += AdcFilter_Process(state, samples, TEST_BLOCK);
+        out[b] = state->last;
+    }
+    return numOut;
+}
+
+static void TestCicOrder1(void)
+{
+    static const AdcFilter_ConfigType cfg = { 12u, 1u, 3u, ADC_FILTER_STAGE_NONE, NULL, 0u };
+    static const uint16 samples[] = { 1000u, 1000u, 1000u, 1000u, 1000u, 1000u, 1000u, 1001u, 4095u, 4095u };
+    AdcFilter_StateType state;
+
+    AdcFilter_Init(&state, &cfg);
+    CHECK_EQ(state.cicShift, 0u);
+
+    /* Seven samples: no output yet, the eighth completes the block */
+    CHECK_EQ(AdcFilter_Process(&state, samples, 7u), 0u);
+    CHECK_EQ(AdcFilter_Process(&state, &samples[7], 3u), 1u);
+    CHECK_EQ(state.last, 8001);
+}
+
+/* Order 2, R = 4: bits = 16, shift 1, gain R^2 / 2 = 8 after the transient */
+static void TestCicOrder2(void)
+{
+    static const AdcFilter_ConfigType cfg = { 12u, 2u, 2u, ADC_FILTER_STAGE_NONE, NULL, 0u };
+    static const sint16 expected[] = { 5000, 8000, 8000 };
+    uint16 samples[12];
+    AdcFilter_StateType state;
+    uint32 i;
+
+    for (i = 0u; i < 12u; i++)
+    {
+        samples[i] = 1000u;
+    }
+    AdcFilter_Init(&state, &cfg);
+    CHECK_EQ(state.cicShift, 1u);
+
+    for (i = 0u; i < 3u; i++)
+    {
+        CHECK_EQ(AdcFilter_Process(&state, &samples[i * 4u], 4u), 1u);
+        CHECK_EQ(state.last, expected[i]);
+    }
+}
+
+/* Order 4, R = 32, 12 bits: exactly 32 bits, the integrators wrap and the
+ * combs cancel it. Full scale settles at 4095 * 2^20 >> 17 after 4 outputs */
+static void TestCicWrap(void)
+{
+    static const AdcFilter_ConfigType cfg = { 12u, 4u, 5u, ADC_FILTER_STAGE_NONE, NULL, 0u };
+    uint16 samples[32];
+    AdcFilter_StateType state;
+    uint32 i;
+
+    for (i = 0u; i < 32u; i++)
+    {
+        samples[i] = 4095u;
+    }
+    AdcFilter_Init(&state, &cfg);
+    CHECK_EQ(state.cicShift, 17u);
+
+    for (i = 0u; i < 12u; i++)
+    {
+        CHECK_EQ(AdcFilter_Process(&state, samples, 32u), 1u);
+        if (i >= 4u)
+        {
+            CHECK_EQ(state.last, 32760);
+        }
+    }
+}
+
+/* Impulse of 0.5 through taps 0.5 0.25 -0.25 0.125 */
+static void TestFirImpulse(void)
+{
+    static const sint16 taps[] = { 16384, 8192, -8192, 4096 };
+    static const AdcFilter_ConfigType cfg = { 12u, 1u, 3u, ADC_FILTER_STAGE_FIR, taps, 4u };
+    static const uint16 blocks[] = { 2048u, 0u, 0u, 0u, 0u, 0u };
+    static const sint16 expected[] = { 8192, 4096, -4096, 2048, 0, 0 };
+    sint16 out[TEST_MAX_OUT];
+    AdcFilter_StateType state;
+    uint32 i;
+
+    AdcFilter_Init(&state, &cfg);
+    CHECK_EQ(TestFeedBlocks(&state, blocks, 6u, out), 6u);
+    for (i = 0u; i < 6u; i++)
+    {
+        CHECK_EQ(out[i], expected[i]);
+    }
+}
+
+/* Two taps of 32767 on 32760: 65518 after the shift, SSAT clamps to 32767 */
+static void TestFirSaturation(void)
+{
+    static const sint16 taps[] = { 32767, 32767 };
+    static const AdcFilter_ConfigType cfg = { 12u, 1u, 3u, ADC_FILTER_STAGE_FIR, taps, 2u };
+    static const uint16 blocks[] = { 4095u, 4095u, 4095u };
+    sint16 out[TEST_MAX_OUT];
+    AdcFilter_StateType state;
+
+    AdcFilter_Init(&state, &cfg);
+    CHECK_EQ(TestFeedBlocks(&state, blocks, 3u, out), 3u);
+    CHECK_EQ(out[0], 32759);
+    CHECK_EQ(out[1], 32767);
+    CHECK_EQ(out[2], 32767);
+}
+
+/* Three taps of 32767 on 32760 wrap to -1074626536, which SSAT clamps to
+ * -32768. Four sum to 4293787680 and wrap to -1179616, -36 after the shift */
+static void TestFirSmladWrap(void)
+{
+    static const sint16 taps[] = { 32767, 32767, 32767, 32767 };
+    static const AdcFilter_ConfigType cfg = { 12u, 1u, 3u, ADC_FILTER_STAGE_FIR, taps, 4u };
+    static const uint16 blocks[] = { 4095u, 4095u, 4095u, 4095u, 4095u };
+    sint16 out[TEST_MAX_OUT];
+    AdcFilter_StateType state;
+
+    AdcFilter_Init(&state, &cfg);
+    CHECK_EQ(TestFeedBlocks(&state, blocks, 5u, out), 5u);
+    CHECK_EQ(out[0], 32759);
+    CHECK_EQ(out[1], 32767);
+    CHECK_EQ(out[2], -32768);
+    CHECK_EQ(out[3], -36);
+    CHECK_EQ(out[4], -36);
+}
+
+/* y = 0.5 x + 0.5 y[n-1] on a step of 16000, truncated by the Q14 shift */
+static void TestBiquadStep(void)
+{
+    static const sint16 coeffs[ADC_FILTER_BIQUAD_COEFFS] = { 8192, 0, 0, -8192, 0 };
+    static const AdcFilter_ConfigType cfg = { 12u, 1u, 3u, ADC_FILTER_STAGE_BIQUAD, coeffs, 0u };
+    static const uint16 blocks[] = { 2000u, 2000u, 2000u, 2000u, 2000u, 2000u, 2000u, 2000u };
+    static const sint16 expected[] = { 8000, 12000, 14000, 15000, 15500, 15750, 15875, 15937 };
+    sint16 out[TEST_MAX_OUT];
+    AdcFilter_StateType state;
+    uint32 i;
+
+    AdcFilter_Init(&state, &cfg);
+    CHECK_EQ(TestFeedBlocks(&state, blocks, 8u, out), 8u);
+    for (i = 0u; i < 8u; i++)
+    {
+        CHECK_EQ(out[i], expected[i]);
+    }
+}
+
+/* b0 of almost 2 on 32760: 65518 after the Q14 shift, SSAT clamps it */
+static void TestBiquadSaturation(void)
+{
+    static const sint16 coeffs[ADC_FILTER_BIQUAD_COEFFS] = { 32767, 0, 0, 0, 0 };
+    static const AdcFilter_ConfigType cfg = { 12u, 1u, 3u, ADC_FILTER_STAGE_BIQUAD, coeffs, 0u };
+    static const uint16 blocks[] = { 4095u, 1000u };
+    sint16 out[TEST_MAX_OUT];
+    AdcFilter_StateType state;
+
+    AdcFilter_Init(&state, &cfg);
+    CHECK_EQ(TestFeedBlocks(&state, blocks, 2u, out), 2u);
+    CHECK_EQ(out[0], 32767);
+    /* 32767 * 8000 >> 14 */
+    CHECK_EQ(out[1], 15999);
+}
+
+/* Outputs 5000 8000 8000 of TestCicOrder2, then restarted accumulators */
+static void TestStats(void)
+{
+    static const AdcFilter_ConfigType cfg = { 12u, 2u, 2u, ADC_FILTER_STAGE_NONE, NULL, 0u };
+    uint16 samples[12];
+    AdcFilter_StateType state;
+    AdcFilter_StatsType stats;
+    uint32 i;
+
+    for (i = 0u; i < 12u; i++)
+    {
+        samples[i] = 1000u;
+    }
+    AdcFilter_Init(&state, &cfg);
+    CHECK_EQ(AdcFilter_Process(&state, samples, 12u), 3u);
+
+    AdcFilter_GetStats(&state, &stats);
+    CHECK_EQ(stats.count, 3u);
+    CHECK_EQ(stats.min, 5000);
+    CHECK_EQ(stats.max, 8000);
+    CHECK_EQ(stats.mean, 7000);
+    /* floor(sqrt((5000^2 + 2 * 8000^2) / 3)) */
+    CHECK_EQ(stats.rms, 7141);
+
+    AdcFilter_GetStats(&state, &stats);
+    CHECK_EQ(stats.count, 0u);
+    CHECK_EQ(stats.mean, 0);
+    CHECK_EQ(stats.rms, 0);
+}
+
+int main(void)
+{
+    TestCicOrder1();
+    TestCicOrder2();
+    TestCicWrap();
+    TestFirImpulse();
+    TestFirSaturation();
+    TestFirSmladWrap();
+    TestBiquadStep();
+    TestBiquadSaturation();
+    TestStats();
+
+    return HOST_TEST_RESULT;
+}
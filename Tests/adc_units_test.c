@@ -0,0 +1,179 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file adc_units_test.c
+ * @brief Host test of the ADC unit conversions against their error budget
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * Every raw code and every Q15 value is converted and compared with the exact
+ * rational result, in integers scaled by 2^15 so no rounding of the reference
+ * hides an error. The budget is the one documented in adc_units.h:
+ *   Q15 value to mV             <= 0.5 mV
+ *   analog input to Q15 to mV   <= 0.15 + 0.5 mV
+ *   mV to CAN signal            < ADC_UNITS_CAN_VOLT_LSB_MV
+ *
+ * The former float path, (uint8)((q15 / 32768.0f) * 5.0f * 50), is kept as
+ * the reference of the CAN signal.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "host_test.h"
+#include "adc_units.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define TEST_SPAN_MV                (ADC_VREFH_MV - ADC_VREFL_MV)
+#define TEST_HALF_MV_Q15            ((long long)ADC_UNITS_Q15_ONE / 2)
+
+/* 0.15 + 0.5 mV in uV, rounded up */
+#define TEST_ANALOG_BUDGET_UV       (653LL)
+#define TEST_ANALOG_STEP_UV         (7LL)
+
+/* Local Functions ----------------------------------------------------------*/
+static long long TestAbs(long long x)
+{
+    return (x < 0) ? -x : x;
+}
+
+/* Right aligned codes of 8 to 15 bits map onto Q15 without loss */
+static void TestRawToQ15(void)
+{
+    uint32 bits, raw;
+    AdcUnits_Q15Type q;
+
+    for (bits = 8u; bits <= 15u; bits++)
+    {
+        for (raw = 0u; raw < (1UL << bits); raw++)
+        {
+            q = AdcUnits_RawToQ15((uint16)raw, (uint8)bits);
+            CHECK(q >= 0);
+            CHECK_EQ(q, raw << (15u - bits));
+        }
+    }
+}
+
+/* |mV - q * span / 2^15| <= 0.5 mV for every Q15 value, monotonic, zero below
+ * zero scale */
+static void TestToMv(void)
+{
+    long long q, err;
+    AdcUnits_MvType mv, lastMv = 0u;
+
+    for (q = -32768; q < 0; q++)
+    {
+        CHECK_EQ(AdcUnits_ToMv(ADC_UNITS_CH_SUPPLY, (AdcUnits_Q15Type)q), ADC_VREFL_MV);
+    }
+
+    for (q = 0; q <= 32767; q++)
+    {
+        mv = AdcUnits_ToMv(ADC_UNITS_CH_SUPPLY, (AdcUnits_Q15Type)q);
+        err = ((long long)mv * (long long)ADC_UNITS_Q15_ONE)
+            - ((q * TEST_SPAN_MV) + ((long long)ADC_VREFL_MV * (long long)ADC_UNITS_Q15_ONE));
+        CHECK(TestAbs(err) <= TEST_HALF_MV_Q15);
+        CHECK(mv >= lastMv);
+        lastMv = mv;
+    }
+    CHECK_EQ(AdcUnits_ToMv(ADC_UNITS_CH_SUPPLY, 0), ADC_VREFL_MV);
+    CHECK_EQ(AdcUnits_ToMv(ADC_UNITS_CH_SUPPLY, 16384), (ADC_VREFH_MV + ADC_VREFL_MV) / 2u);
+    /* One LSB short of full scale */
+    CHECK_EQ(AdcUnits_ToMv(ADC_UNITS_CH_SUPPLY, 32767), ADC_VREFH_MV);
+}
+
+/* Every raw code through RawToQ15 and ToMv, against raw * span / 2^bits */
+static void TestRawToMv(void)
+{
+    uint32 bits, raw;
+    long long err;
+    AdcUnits_MvType mv;
+
+    for (bits = 8u; bits <= 15u; bits++)
+    {
+        for (raw = 0u; raw < (1UL << bits); raw++)
+        {
+            mv = AdcUnits_ToMv(ADC_UNITS_CH_SUPPLY, AdcUnits_RawToQ15((uint16)raw, (uint8)bits));
+            err = ((long long)mv << bits) - ((long long)raw * TEST_SPAN_MV)
+                - ((long long)ADC_VREFL_MV << bits);
+            CHECK(TestAbs(err) <= (1LL << (bits - 1u)));
+        }
+    }
+}
+
+/* An analog input truncated to Q15, then converted: the Q15 quantization and
+ * the mV rounding add up */
+static void TestAnalogToMv(void)
+{
+    long long uv, q, err;
+    AdcUnits_MvType mv;
+
+    for (uv = 0; uv < ((long long)TEST_SPAN_MV * 1000LL); uv += TEST_ANALOG_STEP_UV)
+    {
+        q = (uv * (long long)ADC_UNITS_Q15_ONE) / ((long long)TEST_SPAN_MV * 1000LL);
+        mv = AdcUnits_ToMv(ADC_UNITS_CH_SUPPLY, (AdcUnits_Q15Type)q);
+        err = ((long long)mv * 1000LL) - (uv + ((long long)ADC_VREFL_MV * 1000LL));
+        CHECK(TestAbs(err) <= TEST_ANALOG_BUDGET_UV);
+    }
+}
+
+/* Truncation to the signal LSB, clamped to the 8 bit signal */
+static void TestMvToCan(void)
+{
+    uint32 mv, can;
+
+    for (mv = 0u; mv <= 0xFFFFu; mv++)
+    {
+        can = AdcUnits_MvToCan((AdcUnits_MvType)mv);
+        if (mv < (256u * ADC_UNITS_CAN_VOLT_LSB_MV))
+        {
+            CHECK((can * ADC_UNITS_CAN_VOLT_LSB_MV) <= mv);
+            CHECK(mv < ((can + 1u) * ADC_UNITS_CAN_VOLT_LSB_MV));
+        }
+        else
+        {
+            CHECK_EQ(can, 0xFFu);
+        }
+    }
+}
+
+/* Every Q15 value to the CAN signal: under one LSB from the exact voltage,
+ * as the float path, and one count apart from it only where the 0.5 mV
+ * rounding crosses a step */
+static void TestQ15ToCan(void)
+{
+    long long q, exact, err;
+    uint32 can, floatCan;
+    float32 volts;
+
+    for (q = 0; q <= 32767; q++)
+    {
+        can = AdcUnits_MvToCan(AdcUnits_ToMv(ADC_UNITS_CH_SUPPLY, (AdcUnits_Q15Type)q));
+        volts = ((float32)q / 32768.0f) * ((float32)TEST_SPAN_MV / 1000.0f);
+        floatCan = (uint8)(volts * (1000.0f / (float32)ADC_UNITS_CAN_VOLT_LSB_MV));
+
+        /* Exact mV scaled by 2^15 */
+        exact = (q * TEST_SPAN_MV) + ((long long)ADC_VREFL_MV * (long long)ADC_UNITS_Q15_ONE);
+        err = exact - ((long long)can * ADC_UNITS_CAN_VOLT_LSB_MV * (long long)ADC_UNITS_Q15_ONE);
+        CHECK(err >= -TEST_HALF_MV_Q15);
+        CHECK(err < (((long long)ADC_UNITS_CAN_VOLT_LSB_MV * (long long)ADC_UNITS_Q15_ONE)));
+
+        if (can != floatCan)
+        {
+            CHECK_EQ(can, floatCan + 1u);
+            CHECK(((long long)(floatCan + 1u) * ADC_UNITS_CAN_VOLT_LSB_MV * (long long)ADC_UNITS_Q15_ONE - exact)
+                  <= TEST_HALF_MV_Q15);
+        }
+    }
+}
+
+int main(void)
+{
+    TestRawToQ15();
+    TestToMv();
+    TestRawToMv();
+    TestAnalogToMv();
+    TestMvToCan();
+    TestQ15ToCan();
+
+    return HOST_TEST_RESULT;
+}
@@ -0,0 +1,221 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file can_filter_test.c
+ * @brief Host test of the subscription to mailbox filter compiler
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * The CAN PAL is replaced by stubs recording the (code, mask) pair written
+ * to each mailbox. Every test uses its own instance, the module keeps its
+ * state for the lifetime of the program.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "host_test.h"
+#include "can_filter.h"
+#include "can_trace.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define TEST_MAX_MB                 (32U)
+
+/* Local Parameters ---------------------------------------------------------*/
+static uint32 s_mbCode[TEST_MAX_MB];
+static uint32 s_mbMask[TEST_MAX_MB];
+static uint32 s_rxCount;
+static uint32 s_rxLastId;
+
+static const can_buff_config_t s_stdConfig =
+{
+    .enableFD = false, .enableBRS = false, .fdPadding = 0U, .idType = CAN_MSG_ID_STD, .isRemote = false
+};
+static const can_buff_config_t s_extConfig =
+{
+    .enableFD = false, .enableBRS = false, .fdPadding = 0U, .idType = CAN_MSG_ID_EXT, .isRemote = false
+};
+
+/* CAN PAL and trace stubs --------------------------------------------------*/
+status_t CAN_ConfigRxBuff(const can_instance_t * const instance, uint32_t buffIdx,
+                          const can_buff_config_t *config, uint32_t acceptedId)
+{
+    (void)instance;
+    (void)config;
+    s_mbCode[buffIdx] = acceptedId;
+    return STATUS_SUCCESS;
+}
+
+status_t CAN_SetRxFilter(const can_instance_t * const instance, can_msg_id_type_t idType,
+                         uint32_t buffIdx, uint32_t mask)
+{
+    (void)instance;
+    (void)idType;
+    s_mbMask[buffIdx] = mask;
+    return STATUS_SUCCESS;
+}
+
+status_t CAN_InstallEventCallback(const can_instance_t * const instance, can_callback_t callback,
+                                  void *callbackParam)
+{
+    (void)instance;
+    (void)callback;
+    (void)callbackParam;
+    return STATUS_SUCCESS;
+}
+
+status_t CAN_Receive(const can_instance_t * const instance, uint32_t buffIdx, can_message_t *message)
+{
+    (void)instance;
+    (void)buffIdx;
+    (void)message;
+    return STATUS_SUCCESS;
+}
+
+void CanTrace_Rx(uint32 instance, const can_message_t *msg)
+{
+    (void)instance;
+    (void)msg;
+}
+
+void CanTrace_TxComplete(uint32 instance, uint32 buffIdx)
+{
+    (void)instance;
+    (void)buffIdx;
+}
+
+/* Local Functions ----------------------------------------------------------*/
+static void TestRxNotification(uint32 instance, const can_message_t *msg)
+{
+    (void)instance;
+    s_rxCount++;
+    s_rxLastId = msg->id;
+}
+
+static void TestInject(uint32 instIdx, uint32 id)
+{
+    can_message_t msg = { 0u, id, { 0u }, 0u };
+
+    CanFilter_InjectRx(instIdx, &msg);
+}
+
+/* Mailbox of the first filter admitting id, TEST_MAX_MB if none */
+static uint32 TestFindMb(uint32 firstMb, uint32 numMb, uint32 id)
+{
+    uint32 mb;
+
+    for (mb = firstMb; mb < (firstMb + numMb); mb++)
+    {
+        if ((id & s_mbMask[mb]) == s_mbCode[mb])
+        {
+            return mb;
+        }
+    }
+    return TEST_MAX_MB;
+}
+
+/* Fewer unique IDs than mailboxes: one exact filter per ID, duplicates folded */
+static void TestExactFilters(void)
+{
+    const can_instance_t inst = { CAN_INST_TYPE_FLEXCAN, 0u };
+    const CanFilter_MbFilterType *filter;
+
+    CHECK_EQ(CanFilter_Subscribe(&inst, 0x123u, TestRxNotification), STATUS_SUCCESS);
+    CHECK_EQ(CanFilter_Subscribe(&inst, 0x456u, TestRxNotification), STATUS_SUCCESS);
+    CHECK_EQ(CanFilter_Subscribe(&inst, 0x123u, TestRxNotification), STATUS_SUCCESS);
+    CHECK_EQ(CanFilter_Compile(&inst, &s_stdConfig, 4u, 4u), STATUS_SUCCESS);
+
+    CHECK_EQ(s_mbCode[4], 0x123u);
+    CHECK_EQ(s_mbMask[4], CAN_FILTER_STD_ID_MASK);
+    CHECK_EQ(s_mbCode[5], 0x456u);
+    CHECK_EQ(s_mbMask[5], CAN_FILTER_STD_ID_MASK);
+
+    filter = CanFilter_GetMbFilter(&inst, 0u);
+    CHECK((filter != NULL) && (filter->numIds == 1u));
+    CHECK(CanFilter_GetMbFilter(&inst, 2u) == NULL);
+
+    /* The list is frozen once compiled */
+    CHECK_EQ(CanFilter_Subscribe(&inst, 0x789u, TestRxNotification), STATUS_BUSY);
+
+    /* Both subscriptions of 0x123 are notified */
+    s_rxCount = 0u;
+    TestInject(0u, 0x123u);
+    CHECK_EQ(s_rxCount, 2u);
+}
+
+/* Four adjacent extended IDs in two mailboxes: the zero cost pairs merge */
+static void TestMergeCheapestPairs(void)
+{
+    const can_instance_t inst = { CAN_INST_TYPE_FLEXCAN, 1u };
+    const uint32 ids[] = { 0x18DAF100u, 0x18DAF101u, 0x18DAF102u, 0x18DAF103u };
+    uint32 i;
+
+    for (i = 0u; i < 4u; i++)
+    {
+        CHECK_EQ(CanFilter_Subscribe(&inst, ids[i], TestRxNotification), STATUS_SUCCESS);
+    }
+    CHECK_EQ(CanFilter_Compile(&inst, &s_extConfig, 8u, 2u), STATUS_SUCCESS);
+
+    CHECK_EQ(s_mbCode[8], 0x18DAF100u);
+    CHECK_EQ(s_mbMask[8], CAN_FILTER_EXT_ID_MASK & ~1UL);
+    CHECK_EQ(s_mbCode[9], 0x18DAF102u);
+    CHECK_EQ(s_mbMask[9], CAN_FILTER_EXT_ID_MASK & ~1UL);
+    CHECK_EQ(CanFilter_GetMbFilter(&inst, 0u)->numIds, 2u);
+    CHECK_EQ(CanFilter_GetMbFilter(&inst, 1u)->numIds, 2u);
+}
+
+/* A full table in three mailboxes: every subscribed ID passes the hardware,
+ * the extra IDs a merged mask lets through are rejected and counted */
+static void TestMergedMaskRejects(void)
+{
+    const can_instance_t inst = { CAN_INST_TYPE_FLEXCAN, 2u };
+    uint32 ids[CAN_FILTER_MAX_SUBSCRIPTIONS];
+    uint32 i, id;
+
+    for (i = 0u; i < CAN_FILTER_MAX_SUBSCRIPTIONS; i++)
+    {
+        /* Spread over the ID space, with a few neighbours */
+        ids[i] = ((i * 0x95u) + (i >> 2u)) & CAN_FILTER_STD_ID_MASK;
+        CHECK_EQ(CanFilter_Subscribe(&inst, ids[i], TestRxNotification), STATUS_SUCCESS);
+    }
+    CHECK_EQ(CanFilter_Subscribe(&inst, 0x7FFu, TestRxNotification), STATUS_ERROR);
+    CHECK_EQ(CanFilter_Compile(&inst, &s_stdConfig, 16u, 3u), STATUS_SUCCESS);
+
+    for (i = 0u; i < CAN_FILTER_MAX_SUBSCRIPTIONS; i++)
+    {
+        CHECK(TestFindMb(16u, 3u, ids[i]) != TEST_MAX_MB);
+        CHECK_EQ(s_mbCode[16u + (i % 3u)] & ~s_mbMask[16u + (i % 3u)], 0u);
+    }
+
+    /* First ID that passes a merged mask without a subscriber */
+    for (id = 0u; id <= CAN_FILTER_STD_ID_MASK; id++)
+    {
+        for (i = 0u; (i < CAN_FILTER_MAX_SUBSCRIPTIONS) && (ids[i] != id); i++)
+        {
+        }
+        if ((i == CAN_FILTER_MAX_SUBSCRIPTIONS) && (TestFindMb(16u, 3u, id) != TEST_MAX_MB))
+        {
+            break;
+        }
+    }
+    CHECK(id <= CAN_FILTER_STD_ID_MASK);
+
+    s_rxCount = 0u;
+    TestInject(2u, id);
+    CHECK_EQ(s_rxCount, 0u);
+    CHECK_EQ(CanFilter_GetRejectedCount(&inst), 1u);
+
+    TestInject(2u, ids[5]);
+    CHECK_EQ(s_rxCount, 1u);
+    CHECK_EQ(s_rxLastId, ids[5]);
+    CHECK_EQ(CanFilter_GetRejectedCount(&inst), 1u);
+}
+
+int main(void)
+{
+    TestExactFilters();
+    TestMergeCheapestPairs();
+    TestMergedMaskRejects();
+
+    return HOST_TEST_RESULT;
+}
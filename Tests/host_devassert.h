@@ -0,0 +1,23 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file host_devassert.h
+ * @brief DEV_ASSERT of the host tests, selected with CUSTOM_DEVASSERT
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _HOST_DEVASSERT_H_
+#define _HOST_DEVASSERT_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* A failed check ends the test with its location instead of a BKPT */
+#define DEV_ASSERT(x)   ((x) ? (void)0 : \
+                         (fprintf(stderr, "%s:%d: DEV_ASSERT(%s)\n", __FILE__, __LINE__, #x), abort()))
+
+#endif
@@ -0,0 +1,48 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file host_test.h
+ * @brief Checks shared by the host tests
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * A test is a main() calling CHECK/CHECK_EQ and returning HOST_TEST_RESULT,
+ * ctest counts a non-zero exit as a failure.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _HOST_TEST_H_
+#define _HOST_TEST_H_
+
+#include <stdio.h>
+
+static unsigned int s_hostTestFailures;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) \
+        { \
+            s_hostTestFailures++; \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        } \
+    } while (0)
+
+/* Integer comparison, prints both values */
+#define CHECK_EQ(actual, expected) \
+    do { \
+        long long a_ = (long long)(actual); \
+        long long e_ = (long long)(expected); \
+        if (a_ != e_) \
+        { \
+            s_hostTestFailures++; \
+            fprintf(stderr, "%s:%d: %s == %lld (0x%llx), expected %lld (0x%llx)\n", \
+                    __FILE__, __LINE__, #actual, a_, (unsigned long long)a_, e_, (unsigned long long)e_); \
+        } \
+    } while (0)
+
+#define HOST_TEST_RESULT \
+    ((s_hostTestFailures == 0u) ? (printf("passed\n"), 0) : (printf("%u failed\n", s_hostTestFailures), 1))
+
+#endif
@@ -0,0 +1,344 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file lpspi_fifo_test.c
+ * @brief Host test of the LPSPI FIFO fill/drain routines against the byte-wise ones
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * g_lpspiBase points at a register block in RAM, the read only FSR and RDR
+ * are written through a cast. Before each call the FIFO stub sets the TX/RX counts in FSR for the free or filled space of a
+ * schedule, loads RDR and marks TDR with TEST_NO_WRITE. A register in RAM
+ * keeps only the last word of a call, so:
+ *   - with a schedule of one word per call the whole word stream is checked
+ *   - with the other schedules the routine chosen by
+ *     LPSPI_DRV_SelectFifoRoutines must leave the same TDR, TCR, counts and
+ *     buffer positions as LPSPI_DRV_FillupTxBuffer/ReadRXBuffer after every
+ *     call, and the same rx buffer at the end
+ * The order of the first words of a call in the unrolled loops is not seen,
+ * only their count and the last one.
+ *
+ * Frames of 1, 2, 4, 8 and 12 bytes are run with continuous PCS, a NULL tx
+ * buffer and misaligned buffers. The rest of lpspi_shared_function.c is
+ * dropped by the linker, see CMakeLists.txt.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include <string.h>
+#include "host_test.h"
+#include "lpspi_shared_function.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define TEST_INSTANCE               (0U)
+#define TEST_FIFO_SIZE              (4U)
+#define TEST_MAX_BYTES              (48U)
+#define TEST_MAX_CALLS              (128U)
+#define TEST_NO_WRITE               (0xDEADBEEFUL)
+#define TEST_GUARD                  (0xCCU)
+
+#define TEST_NUM(array)             (sizeof(array) / sizeof((array)[0]))
+
+/* Type Define --------------------------------------------------------------*/
+typedef void (*TestFifoFnType)(uint32_t instance);
+
+/* Registers and state after one call */
+typedef struct
+{
+    uint32_t data;                  /* Last TDR write, or RDR of the call */
+    uint32_t tcr;
+    uint32_t offset;                /* Buffer position */
+    uint16_t count;                 /* txCount or rxCount */
+} TestStepType;
+
+typedef struct
+{
+    uint32_t numCalls;
+    TestStepType steps[TEST_MAX_CALLS];
+    uint8_t rx[TEST_MAX_BYTES + 8U];
+} TestRunType;
+
+typedef struct
+{
+    const uint8_t *spaces;          /* Free or filled FIFO words per call */
+    uint32_t numSpaces;
+} TestScheduleType;
+
+/* Local Parameters ---------------------------------------------------------*/
+static LPSPI_Type s_regs;
+static lpspi_state_t s_state;
+
+/* 4 byte aligned, offset by one for the misaligned runs */
+static uint32_t s_txWords[(TEST_MAX_BYTES / 4U) + 2U];
+static uint32_t s_rxWords[(TEST_MAX_BYTES / 4U) + 4U];
+
+static TestRunType s_ref;
+static TestRunType s_new;
+
+static const uint8_t s_oneWord[] = { 1U };
+static const uint8_t s_fullFifo[] = { 4U };
+static const uint8_t s_mixed[] = { 2U, 4U, 1U, 3U };
+static const uint8_t s_stalls[] = { 0U, 3U, 4U, 0U, 1U, 2U };
+
+static const TestScheduleType s_schedules[] =
+{
+    { s_oneWord, TEST_NUM(s_oneWord) },
+    { s_fullFifo, TEST_NUM(s_fullFifo) },
+    { s_mixed, TEST_NUM(s_mixed) },
+    { s_stalls, TEST_NUM(s_stalls) },
+};
+
+static const uint16_t s_bytesPerFrame[] = { 1U, 2U, 4U, 8U, 12U };
+
+/* Local Functions ----------------------------------------------------------*/
+/* Start of a transfer as LPSPI_DRV_MasterStartTransfer sets it up */
+static void TestStart(uint16_t bytesPerFrame, bool isPcsContinuous, const uint8_t *txBuff,
+                      uint8_t *rxBuff, uint16_t byteCount)
+{
+    memset(&s_state, 0, sizeof(s_state));
+    s_state.bytesPerFrame = bytesPerFrame;
+    s_state.bitsPerFrame = (uint16_t)(bytesPerFrame * 8U);
+    s_state.isPcsContinuous = isPcsContinuous;
+    s_state.fifoSize = TEST_FIFO_SIZE;
+    s_state.txBuff = txBuff;
+    s_state.rxBuff = rxBuff;
+    s_state.txCount = (uint16_t)(byteCount + (isPcsContinuous ? 1U : 0U));
+    s_state.rxCount = (rxBuff != NULL) ? byteCount : 0U;
+
+    g_lpspiBase[TEST_INSTANCE] = &s_regs;
+    g_lpspiStatePtr[TEST_INSTANCE] = &s_state;
+    LPSPI_DRV_SelectFifoRoutines(&s_state);
+}
+
+/* Call fill until every byte and the PCS command are in the FIFO */
+static void TestRunTx(TestFifoFnType fill, const TestScheduleType *schedule, TestRunType *run)
+{
+    const uint8_t *txStart = s_state.txBuff;
+    TestStepType *step;
+    uint32_t space;
+
+    for (run->numCalls = 0U; (s_state.txCount != 0U) && (run->numCalls < TEST_MAX_CALLS); run->numCalls++)
+    {
+        space = schedule->spaces[run->numCalls % schedule->numSpaces];
+        *(volatile uint32_t *)&s_regs.FSR = LPSPI_FSR_TXCOUNT(TEST_FIFO_SIZE - space);
+        s_regs.TDR = TEST_NO_WRITE;
+        s_regs.TCR = LPSPI_TCR_CONTC_MASK;
+
+        fill(TEST_INSTANCE);
+
+        step = &run->steps[run->numCalls];
+        step->data = s_regs.TDR;
+        step->tcr = s_regs.TCR;
+        step->offset = (txStart != NULL) ? (uint32_t)(s_state.txBuff - txStart) : 0U;
+        step->count = s_state.txCount;
+    }
+}
+
+/* Call drain until every byte is received, RDR holds a new word per call */
+static void TestRunRx(TestFifoFnType drain, const TestScheduleType *schedule, TestRunType *run)
+{
+    const uint8_t *rxStart = s_state.rxBuff;
+    TestStepType *step;
+    uint32_t word;
+
+    for (run->numCalls = 0U; (s_state.rxCount != 0U) && (run->numCalls < TEST_MAX_CALLS); run->numCalls++)
+    {
+        word = 0x01020304UL * (run->numCalls + 1U);
+        *(volatile uint32_t *)&s_regs.FSR = LPSPI_FSR_RXCOUNT(schedule->spaces[run->numCalls % schedule->numSpaces]);
+        *(volatile uint32_t *)&s_regs.RDR = word;
+
+        drain(TEST_INSTANCE);
+
+        step = &run->steps[run->numCalls];
+        step->data = word;
+        step->tcr = 0U;
+        step->offset = (uint32_t)(s_state.rxBuff - rxStart);
+        step->count = s_state.rxCount;
+    }
+}
+
+static void TestCompareRuns(void)
+{
+    uint32_t i;
+
+    CHECK(s_new.numCalls < TEST_MAX_CALLS);
+    CHECK_EQ(s_new.numCalls, s_ref.numCalls);
+    for (i = 0U; (i < s_new.numCalls) && (i < s_ref.numCalls); i++)
+    {
+        CHECK_EQ(s_new.steps[i].data, s_ref.steps[i].data);
+        CHECK_EQ(s_new.steps[i].tcr, s_ref.steps[i].tcr);
+        CHECK_EQ(s_new.steps[i].offset, s_ref.steps[i].offset);
+        CHECK_EQ(s_new.steps[i].count, s_ref.steps[i].count);
+    }
+    CHECK(memcmp(s_new.rx, s_ref.rx, sizeof(s_new.rx)) == 0);
+}
+
+/* Little endian FIFO word i of a buffer of words of width bytes */
+static uint32_t TestWord(const uint8_t *buff, uint32_t width, uint32_t i)
+{
+    uint32_t word = 0U;
+    uint32_t j;
+
+    for (j = 0U; j < width; j++)
+    {
+        word |= (uint32_t)buff[(i * width) + j] << (j * 8U);
+    }
+    return word;
+}
+
+/* One word per call: the stream itself, then the PCS command alone */
+static void TestCheckTxStream(const uint8_t *txBuff, uint16_t bytesPerFrame, bool isPcsContinuous,
+                              uint16_t byteCount)
+{
+    uint32_t width = (bytesPerFrame < 4U) ? bytesPerFrame : 4U;
+    uint32_t numWords = byteCount / width;
+    uint32_t i;
+
+    CHECK_EQ(s_new.numCalls, numWords + (isPcsContinuous ? 1U : 0U));
+    for (i = 0U; (i < numWords) && (i < s_new.numCalls); i++)
+    {
+        CHECK_EQ(s_new.steps[i].data, (txBuff != NULL) ? TestWord(txBuff, width, i) : 0U);
+        CHECK_EQ(s_new.steps[i].tcr, LPSPI_TCR_CONTC_MASK);
+    }
+    if (isPcsContinuous && (numWords < s_new.numCalls))
+    {
+        CHECK_EQ(s_new.steps[numWords].data, TEST_NO_WRITE);
+        CHECK_EQ(s_new.steps[numWords].tcr, 0U);
+    }
+}
+
+static void TestCheckRxStream(uint16_t bytesPerFrame, uint32_t rxOffset, uint16_t byteCount)
+{
+    uint32_t width = (bytesPerFrame < 4U) ? bytesPerFrame : 4U;
+    uint32_t i;
+
+    for (i = 0U; i < (byteCount / width); i++)
+    {
+        CHECK_EQ(TestWord(&s_new.rx[rxOffset], width, i),
+                 (0x01020304UL * (i + 1U)) & (0xFFFFFFFFUL >> (32U - (width * 8U))));
+    }
+    CHECK_EQ(s_new.rx[rxOffset + byteCount], TEST_GUARD);
+}
+
+/* The routine the transfer start picked, and the byte-wise reference */
+static void TestTxCase(uint16_t bytesPerFrame, bool isPcsContinuous, bool hasTxBuff, uint32_t txOffset,
+                       uint16_t byteCount, const TestScheduleType *schedule)
+{
+    const uint8_t *txBuff = hasTxBuff ? &((const uint8_t *)s_txWords)[txOffset] : NULL;
+    uint32_t width = (bytesPerFrame < 4U) ? bytesPerFrame : 4U;
+
+    TestStart(bytesPerFrame, isPcsContinuous, txBuff, NULL, byteCount);
+    TestRunTx(LPSPI_DRV_FillupTxBuffer, schedule, &s_ref);
+
+    TestStart(bytesPerFrame, isPcsContinuous, txBuff, NULL, byteCount);
+    if ((txBuff != NULL) && ((txOffset % width) != 0U))
+    {
+        CHECK(s_state.txFill == LPSPI_DRV_FillupTxBuffer);
+    }
+    else
+    {
+        CHECK(s_state.txFill != LPSPI_DRV_FillupTxBuffer);
+    }
+    TestRunTx(s_state.txFill, schedule, &s_new);
+
+    memset(s_ref.rx, 0, sizeof(s_ref.rx));
+    memset(s_new.rx, 0, sizeof(s_new.rx));
+    TestCompareRuns();
+    if (schedule->spaces == s_oneWord)
+    {
+        TestCheckTxStream(txBuff, bytesPerFrame, isPcsContinuous, byteCount);
+    }
+}
+
+static void TestRxCase(uint16_t bytesPerFrame, uint32_t rxOffset, uint16_t byteCount,
+                       const TestScheduleType *schedule)
+{
+    uint8_t *rxBuff = &((uint8_t *)s_rxWords)[rxOffset];
+    uint32_t width = (bytesPerFrame < 4U) ? bytesPerFrame : 4U;
+
+    memset(s_rxWords, TEST_GUARD, sizeof(s_rxWords));
+    TestStart(bytesPerFrame, false, NULL, rxBuff, byteCount);
+    TestRunRx(LPSPI_DRV_ReadRXBuffer, schedule, &s_ref);
+    memcpy(s_ref.rx, s_rxWords, sizeof(s_ref.rx));
+
+    memset(s_rxWords, TEST_GUARD, sizeof(s_rxWords));
+    TestStart(bytesPerFrame, false, NULL, rxBuff, byteCount);
+    if ((rxOffset % width) != 0U)
+    {
+        CHECK(s_state.rxDrain == LPSPI_DRV_ReadRXBuffer);
+    }
+    else
+    {
+        CHECK(s_state.rxDrain != LPSPI_DRV_ReadRXBuffer);
+    }
+    TestRunRx(s_state.rxDrain, schedule, &s_new);
+    memcpy(s_new.rx, s_rxWords, sizeof(s_new.rx));
+
+    TestCompareRuns();
+    if (schedule->spaces == s_oneWord)
+    {
+        TestCheckRxStream(bytesPerFrame, rxOffset, byteCount);
+    }
+}
+
+static void TestTx(void)
+{
+    uint32_t f, s, offset, cont;
+    uint16_t bytesPerFrame, byteCount;
+
+    for (f = 0U; f < TEST_NUM(s_bytesPerFrame); f++)
+    {
+        bytesPerFrame = s_bytesPerFrame[f];
+        for (byteCount = bytesPerFrame; byteCount <= TEST_MAX_BYTES; byteCount += bytesPerFrame)
+        {
+            for (s = 0U; s < TEST_NUM(s_schedules); s++)
+            {
+                for (cont = 0U; cont < 2U; cont++)
+                {
+                    for (offset = 0U; offset < 4U; offset++)
+                    {
+                        TestTxCase(bytesPerFrame, cont != 0U, true, offset, byteCount, &s_schedules[s]);
+                    }
+                    TestTxCase(bytesPerFrame, cont != 0U, false, 0U, byteCount, &s_schedules[s]);
+                }
+            }
+        }
+    }
+}
+
+static void TestRx(void)
+{
+    uint32_t f, s, offset;
+    uint16_t bytesPerFrame, byteCount;
+
+    for (f = 0U; f < TEST_NUM(s_bytesPerFrame); f++)
+    {
+        bytesPerFrame = s_bytesPerFrame[f];
+        for (byteCount = bytesPerFrame; byteCount <= TEST_MAX_BYTES; byteCount += bytesPerFrame)
+        {
+            for (s = 0U; s < TEST_NUM(s_schedules); s++)
+            {
+                for (offset = 0U; offset < 4U; offset++)
+                {
+                    TestRxCase(bytesPerFrame, offset, byteCount, &s_schedules[s]);
+                }
+            }
+        }
+    }
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    for (i = 0U; i < sizeof(s_txWords); i++)
+    {
+        ((uint8_t *)s_txWords)[i] = (uint8_t)((i * 37U) + 11U);
+    }
+
+    TestTx();
+    TestRx();
+
+    return HOST_TEST_RESULT;
+}
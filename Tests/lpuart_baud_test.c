@@ -0,0 +1,229 @@
+/**
+ *-----------------------------------------------------------------------------
+ * @file lpuart_baud_test.c
+ * @brief Host test of the LPUART baud rate planner against the former search
+ * @author shibo jiang
+ * @version 0.0.0.1
+ * @date 2026-10-18
+ * @note [change history]
+ *
+ * LPUART_DRV_PlanBaudRate runs on a stubbed clock manager over 2-80 MHz and
+ * the standard rates from 9600 baud to 3 Mbaud. For each pair the chosen
+ * OSR/SBR is compared, as an exact fraction, with:
+ *   - the search LPUART_DRV_SetBaudRate used before the planner, copied
+ *     below with its truncated divisors and baud rates, which must never win
+ *   - every OSR/SBR pair the hardware accepts, which must not beat it
+ *
+ * The rest of lpuart_driver.c is dropped by the linker, see CMakeLists.txt.
+ *
+ * @copyright NAAA_
+ *-----------------------------------------------------------------------------
+ */
+#include "host_test.h"
+#include "lpuart_driver.h"
+
+/* Macro Define -------------------------------------------------------------*/
+#define TEST_INSTANCE               (1U)
+#define TEST_SBR_MAX                (8191U)
+#define TEST_MHZ                    (1000000UL)
+
+/* Type Define --------------------------------------------------------------*/
+typedef struct
+{
+    uint32_t osr;
+    uint32_t sbr;
+} TestDividerType;
+
+/* Local Parameters ---------------------------------------------------------*/
+static uint32_t s_clockHz;
+
+static const uint32_t s_bauds[] =
+{
+    9600U, 14400U, 19200U, 38400U, 57600U, 115200U, 230400U, 460800U,
+    500000U, 921600U, 1000000U, 1500000U, 2000000U, 3000000U
+};
+
+/* Crystal and PLL frequencies that are not whole MHz */
+static const uint32_t s_oddClocks[] =
+{
+    3686400U, 7372800U, 11059200U, 14745600U, 18432000U, 29491200U, 36864000U, 73728000U
+};
+
+/* Clock manager stub -------------------------------------------------------*/
+status_t CLOCK_SYS_GetFreq(clock_names_t clockName, uint32_t *frequency)
+{
+    (void)clockName;
+    *frequency = s_clockHz;
+    return STATUS_SUCCESS;
+}
+
+/* Local Functions ----------------------------------------------------------*/
+/* |clock - baud * osr * sbr|, the error times osr * sbr */
+static uint64_t TestErrNum(uint32_t clock, uint32_t baud, TestDividerType div)
+{
+    uint64_t target = (uint64_t)baud * div.osr * div.sbr;
+
+    return (target > clock) ? (target - clock) : (clock - target);
+}
+
+/* Error of a strictly lower than error of b */
+static bool TestBetter(uint32_t clock, uint32_t baud, TestDividerType a, TestDividerType b)
+{
+    return (TestErrNum(clock, baud, a) * ((uint64_t)b.osr * b.sbr))
+         < (TestErrNum(clock, baud, b) * ((uint64_t)a.osr * a.sbr));
+}
+
+/* The search of LPUART_DRV_SetBaudRate before the planner */
+static TestDividerType TestOldSearch(uint32_t clock, uint32_t baud)
+{
+    TestDividerType div;
+    uint16_t sbr, sbrTemp, i;
+    uint32_t osr, tempDiff, calculatedBaud, baudDiff, maxOsr;
+
+    osr = 4;
+    sbr = (uint16_t)(clock / (baud * osr));
+    calculatedBaud = (clock / (osr * sbr));
+    baudDiff = (calculatedBaud > baud) ? (calculatedBaud - baud) : (baud - calculatedBaud);
+    maxOsr = clock / baud;
+    if (maxOsr > 32U)
+    {
+        maxOsr = 32U;
+    }
+    for (i = 5U; i <= maxOsr; i++)
+    {
+        sbrTemp = (uint16_t)(clock / (baud * i));
+        calculatedBaud = (clock / (i * sbrTemp));
+        tempDiff = (calculatedBaud > baud) ? (calculatedBaud - baud) : (baud - calculatedBaud);
+        if (tempDiff <= baudDiff)
+        {
+            baudDiff = tempDiff;
+            osr = i;
+            sbr = sbrTemp;
+        }
+    }
+
+    div.osr = osr;
+    div.sbr = sbr;
+    return div;
+}
+
+/* Plan at the given clock, checks the fields derived from osr/sbr */
+static bool TestPlan(uint32_t clock, uint32_t baud, lpuart_baud_plan_t *plan)
+{
+    uint64_t den, target;
+
+    s_clockHz = clock;
+    if (LPUART_DRV_PlanBaudRate(TEST_INSTANCE, baud, plan) != STATUS_SUCCESS)
+    {
+        return false;
+    }
+
+    CHECK((plan->osr >= 4U) && (plan->osr <= 32U));
+    CHECK((plan->sbr >= 1U) && (plan->sbr <= TEST_SBR_MAX));
+    CHECK_EQ(plan->bothEdge, plan->osr < 8U);
+
+    den = (uint64_t)plan->osr * plan->sbr;
+    target = (uint64_t)baud * den;
+    CHECK_EQ(plan->achievedBaudRate, ((uint64_t)clock + (den / 2U)) / den);
+    CHECK_EQ(plan->errorPpm, (((int64_t)clock - (int64_t)target) * 1000000) / (int64_t)target);
+    return true;
+}
+
+static void TestSweepPair(uint32_t clock, uint32_t baud)
+{
+    lpuart_baud_plan_t plan;
+    TestDividerType planned, old, div;
+
+    if (clock < (baud * 4U))
+    {
+        s_clockHz = clock;
+        CHECK_EQ(LPUART_DRV_PlanBaudRate(TEST_INSTANCE, baud, &plan), STATUS_ERROR);
+        return;
+    }
+
+    CHECK(TestPlan(clock, baud, &plan));
+    planned.osr = plan.osr;
+    planned.sbr = plan.sbr;
+
+    old = TestOldSearch(clock, baud);
+    CHECK(!TestBetter(clock, baud, old, planned));
+
+    for (div.osr = 4U; div.osr <= 32U; div.osr++)
+    {
+        for (div.sbr = 1U; div.sbr <= TEST_SBR_MAX; div.sbr++)
+        {
+            if (TestBetter(clock, baud, div, planned))
+            {
+                /* Fails with the clock and baud rate in the report */
+                CHECK_EQ(clock, 0U);
+                CHECK_EQ(baud, 0U);
+                return;
+            }
+        }
+    }
+}
+
+static void TestSweep(void)
+{
+    uint32_t c, b;
+
+    for (c = 2U; c <= 80U; c++)
+    {
+        for (b = 0U; b < (sizeof(s_bauds) / sizeof(s_bauds[0])); b++)
+        {
+            TestSweepPair(c * TEST_MHZ, s_bauds[b]);
+        }
+    }
+    for (c = 0U; c < (sizeof(s_oddClocks) / sizeof(s_oddClocks[0])); c++)
+    {
+        for (b = 0U; b < (sizeof(s_bauds) / sizeof(s_bauds[0])); b++)
+        {
+            TestSweepPair(s_oddClocks[c], s_bauds[b]);
+        }
+    }
+}
+
+/* Pairs the old search got wrong, and exact rates at 48 MHz */
+static void TestSpotChecks(void)
+{
+    static const uint32_t exact48[] = { 1000000U, 1500000U, 2000000U, 3000000U };
+    lpuart_baud_plan_t plan;
+    uint32_t i;
+
+    /* Old: osr 17, sbr 2, +2.1 %. Now -0.8 % with both edges */
+    CHECK(TestPlan(8U * TEST_MHZ, 230400U, &plan));
+    CHECK_EQ(plan.osr, 7U);
+    CHECK_EQ(plan.sbr, 5U);
+    CHECK_EQ(plan.errorPpm, -7936);
+    CHECK(plan.bothEdge == true);
+
+    /* Old: osr 8, sbr 1, +8.5 %. Now -3.5 % */
+    CHECK(TestPlan(8U * TEST_MHZ, 921600U, &plan));
+    CHECK_EQ(plan.osr, 9U);
+    CHECK_EQ(plan.sbr, 1U);
+    CHECK_EQ(plan.errorPpm, -35493);
+    CHECK(plan.bothEdge == false);
+
+    for (i = 0U; i < (sizeof(exact48) / sizeof(exact48[0])); i++)
+    {
+        CHECK(TestPlan(48U * TEST_MHZ, exact48[i], &plan));
+        CHECK_EQ(plan.errorPpm, 0);
+        CHECK_EQ(plan.achievedBaudRate, exact48[i]);
+    }
+
+    /* The lowest osr, with both edges */
+    CHECK(TestPlan(16U * TEST_MHZ, 4000000U, &plan));
+    CHECK_EQ(plan.osr, 4U);
+    CHECK(plan.bothEdge == true);
+
+    s_clockHz = 8U * TEST_MHZ;
+    CHECK_EQ(LPUART_DRV_PlanBaudRate(TEST_INSTANCE, 0U, &plan), STATUS_ERROR);
+}
+
+int main(void)
+{
+    TestSpotChecks();
+    TestSweep();
+
+    return HOST_TEST_RESULT;
+}
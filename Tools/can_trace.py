@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+# -----------------------------------------------------------------------------
+#  File Name      :  can_trace.py
+#  Author         :  shibo jiang
+#  Instructions   :  Convert CAN trace captures of Sources/commu/can_trace.c
+#                    to candump/ASC logs and back.            2026/10/18  V0.1
+#
+#  decode  raw UART capture (CTRC packets, text in between is skipped)
+#          -> candump log or Vector ASC
+#  encode  candump log or Vector ASC
+#          -> raw packets, or a C array of CanTrace_RecordType for
+#             CanTrace_Replay()
+# -----------------------------------------------------------------------------
+import argparse
+import re
+import struct
+import sys
+
+MAGIC = 0x43525443
+HEADER = struct.Struct("<IHH")
+RECORD = struct.Struct("<II8s")
+TIME_MASK = 0x07FFFFFF
+IDE_FLAG = 1 << 27
+ID_MASK = 0x1FFFFFFF
+TX_FLAG = 1 << 29
+PACKET_MAX = 32
+
+
+class Frame:
+    def __init__(self, time_us, bus, can_id, ext, tx, data):
+        self.time_us = time_us
+        self.bus = bus
+        self.can_id = can_id
+        self.ext = ext
+        self.tx = tx
+        self.data = data
+
+
+def decode_packets(raw):
+    frames, lost = [], 0
+    last, base = None, 0
+    pos = raw.find(struct.pack("<I", MAGIC))
+    while pos >= 0 and pos + HEADER.size <= len(raw):
+        _, count, dropped = HEADER.unpack_from(raw, pos)
+        end = pos + HEADER.size + count * RECORD.size
+        if count > PACKET_MAX or end > len(raw):
+            pos = raw.find(struct.pack("<I", MAGIC), pos + 1)
+            continue
+        lost += dropped
+        for off in range(pos + HEADER.size, end, RECORD.size):
+            stamp, word, data = RECORD.unpack_from(raw, off)
+            t = stamp & TIME_MASK
+            # Unwrap the 27 bit microsecond counter
+            if last is not None and t < last:
+                base += TIME_MASK + 1
+            last = t
+            dlc = min(stamp >> 28, 8)
+            frames.append(Frame(base + t, word >> 30, word & ID_MASK, bool(stamp & IDE_FLAG),
+                                bool(word & TX_FLAG), data[:dlc]))
+        pos = raw.find(struct.pack("<I", MAGIC), end)
+    return frames, lost
+
+
+def write_candump(frames, out):
+    for f in frames:
+        ident = "%08X" % f.can_id if f.ext else "%03X" % f.can_id
+        out.write("(%d.%06d) can%d %s#%s\n" % (f.time_us // 1000000, f.time_us % 1000000,
+                                                f.bus, ident, f.data.hex().upper()))
+
+
+def write_asc(frames, out):
+    out.write("date Thu Jan 1 00:00:00 am 1970\nbase hex  timestamps absolute\n")
+    for f in frames:
+        ident = "%Xx" % f.can_id if f.ext else "%X" % f.can_id
+        out.write("%11.6f %d  %-15s %s   d %d %s\n" % (f.time_us / 1e6, f.bus + 1, ident,
+                                                      "Tx" if f.tx else "Rx", len(f.data),
+                                                      " ".join("%02X" % b for b in f.data)))
+
+
+CANDUMP_RE = re.compile(r"\((\d+)\.(\d+)\)\s+\D*(\d+)\s+([0-9A-Fa-f]+)#([0-9A-Fa-f]*)")
+ASC_RE = re.compile(r"\s*([\d.]+)\s+(\d+)\s+([0-9A-Fa-f]+)(x?)\s+(Rx|Tx)\s+d\s+(\d+)((?:\s+[0-9A-Fa-f]{2})*)")
+
+
+def read_log(text):
+    frames = []
+    for line in text.splitlines():
+        m = CANDUMP_RE.match(line)
+        if m:
+            t = int(m.group(1)) * 1000000 + int(m.group(2).ljust(6, "0")[:6])
+            # candump writes extended IDs with 8 digits
+            frames.append(Frame(t, int(m.group(3)), int(m.group(4), 16), len(m.group(4)) == 8,
+                                False, bytes.fromhex(m.group(5))))
+            continue
+        m = ASC_RE.match(line)
+        if m:
+            frames.append(Frame(int(round(float(m.group(1)) * 1e6)), int(m.group(2)) - 1,
+                                int(m.group(3), 16), m.group(4) == "x", m.group(5) == "Tx",
+                                bytes.fromhex("".join(m.group(7).split()))[:int(m.group(6))]))
+    return frames
+
+
+def pack_record(f):
+    word = (f.can_id & ID_MASK) | ((f.bus & 3) << 30) | (TX_FLAG if f.tx else 0)
+    stamp = (len(f.data) << 28) | (IDE_FLAG if f.ext else 0) | (f.time_us & TIME_MASK)
+    return RECORD.pack(stamp, word,
+                       f.data.ljust(8, b"\0"))
+
+
+def write_packets(frames, out):
+    for i in range(0, len(frames), PACKET_MAX):
+        chunk = frames[i:i + PACKET_MAX]
+        out.write(HEADER.pack(MAGIC, len(chunk), 0))
+        for f in chunk:
+            out.write(pack_record(f))
+
+
+def write_c_array(frames, out, name):
+    out.write("const CanTrace_RecordType %s[] =\n{\n" % name)
+    for f in frames:
+        stamp, word, data = RECORD.unpack(pack_record(f))
+        out.write("    {0x%08XUL, 0x%08XUL, {%s}},\n" % (stamp, word,
+                                                       ", ".join("0x%02Xu" % b for b in data)))
+    out.write("};\nconst uint32 %sLen = %du;\n" % (name, len(frames)))
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    sub = parser.add_subparsers(dest="cmd", required=True)
+    dec = sub.add_parser("decode", help="raw UART capture to candump/ASC")
+    dec.add_argument("input")
+    dec.add_argument("-f", "--format", choices=("candump", "asc"), default="candump")
+    dec.add_argument("-o", "--output")
+    enc = sub.add_parser("encode", help="candump/ASC to raw packets or C array")
+    enc.add_argument("input")
+    enc.add_argument("-f", "--format", choices=("bin", "c"), default="bin")
+    enc.add_argument("-n", "--name", default="g_CanTraceReplay")
+    enc.add_argument("-o", "--output", required=True)
+    args = parser.parse_args()
+
+    if args.cmd == "decode":
+        with open(args.input, "rb") as f:
+            frames, lost = decode_packets(f.read())
+        out = open(args.output, "w") if args.output else sys.stdout
+        (write_asc if args.format == "asc" else write_candump)(frames, out)
+        if lost:
+            sys.stderr.write("warning: %d records lost on target\n" % lost)
+    else:
+        with open(args.input) as f:
+            frames = sorted(read_log(f.read()), key=lambda fr: fr.time_us)
+        if args.format == "c":
+            with open(args.output, "w") as out:
+                write_c_array(frames, out, args.name)
+        else:
+            with open(args.output, "wb") as out:
+                write_packets(frames, out)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+# -----------------------------------------------------------------------------
+#  File Name      :  code_ram.py
+#  Author         :  shibo jiang
+#  Instructions   :  RAM code placement of S32K1xx_flash.ld from a profile,
+#                    and its cost from the linker map.     2026/10/18  V0.1
+#
+#  report  linker map -> bytes of each function in .code, RAM vector table
+#          and SRAM_L use
+#  hot     linker map + profile -> hot list of .code in the linker script,
+#          the most samples per byte first, within a RAM budget
+#
+#  A profile is one function name per line, e.g. PC samples resolved with
+#  arm-none-eabi-addr2line -f, or "name count" lines. '#' starts a comment.
+# -----------------------------------------------------------------------------
+import argparse
+import collections
+import os
+import re
+import sys
+
+LD_SCRIPT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "Project_Settings",
+                         "Linker_Files", "S32K1xx_flash.ld")
+HOT_BEGIN = "/* code_ram hot list begin"
+HOT_END = "/* code_ram hot list end */"
+SRAM_L = "m_data"
+# Run before startup copies .code to RAM
+NOT_IN_RAM = ("Reset_Handler", "SystemInit", "init_data_bss")
+
+Input = collections.namedtuple("Input", "output name addr size obj symbol")
+
+OUTPUT_RE = re.compile(r"^(\.\S+)(?:\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+))?")
+INPUT_RE = re.compile(r"^ (\.\S+)(?:\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(\S.*))?$")
+CONT_RE = re.compile(r"^\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)(?:\s+(\S.*))?$")
+SYMBOL_RE = re.compile(r"^\s+0x[0-9a-fA-F]+\s+([A-Za-z_]\w*)$")
+REGION_RE = re.compile(r"^(\w+)\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)")
+
+
+def read_map(text):
+    """Output section sizes, input sections and memory regions of a GNU ld map."""
+    outputs, inputs, regions = {}, [], {}
+    output, pending_output, pending_input, in_memory = None, None, None, False
+    for line in text.splitlines():
+        if line.startswith("Memory Configuration"):
+            in_memory = True
+        elif line.startswith("Linker script and memory map"):
+            in_memory = False
+        elif in_memory:
+            m = REGION_RE.match(line)
+            if m:
+                regions[m.group(1)] = (int(m.group(2), 16), int(m.group(3), 16))
+        elif pending_output or pending_input:
+            # Long section names put address, size and object on the next line
+            m = CONT_RE.match(line)
+            if m and pending_output:
+                outputs[pending_output] = (int(m.group(1), 16), int(m.group(2), 16))
+            elif m:
+                inputs.append(Input(output, pending_input, int(m.group(1), 16),
+                                    int(m.group(2), 16), (m.group(3) or "").strip(), None))
+            pending_output, pending_input = None, None
+        elif line and not line[0].isspace():
+            m = OUTPUT_RE.match(line)
+            output = m.group(1) if m else None
+            if m and m.group(3):
+                outputs[output] = (int(m.group(2), 16), int(m.group(3), 16))
+            elif m:
+                pending_output = output
+        elif output is not None:
+            m = INPUT_RE.match(line)
+            if m and m.group(2):
+                inputs.append(Input(output, m.group(1), int(m.group(2), 16), int(m.group(3), 16),
+                                    m.group(4).strip(), None))
+            elif m:
+                pending_input = m.group(1)
+            else:
+                m = SYMBOL_RE.match(line)
+                if m and inputs and inputs[-1].output == output and inputs[-1].symbol is None:
+                    inputs[-1] = inputs[-1]._replace(symbol=m.group(1))
+    return outputs, inputs, regions
+
+
+def function_name(item):
+    if item.name.startswith(".text."):
+        return item.name[len(".text."):]
+    return item.symbol or item.name
+
+
+def report(outputs, inputs, regions, out):
+    code = sorted((i for i in inputs if i.output == ".code" and i.size), key=lambda i: -i.size)
+    out.write("%-40s %6s  %s\n" % ("RAM code", "bytes", "object"))
+    for i in code:
+        out.write("%-40s %6d  %s\n" % (function_name(i), i.size, os.path.basename(i.obj)))
+    code_bytes = outputs.get(".code", (0, 0))[1]
+    vector_bytes = outputs.get(".interrupts_ram", (0, 0))[1]
+    out.write("\n.code            %6d bytes in %d input sections\n" % (code_bytes, len(code)))
+    out.write(".interrupts_ram  %6d bytes\n" % vector_bytes)
+    if SRAM_L in regions:
+        origin, length = regions[SRAM_L]
+        used = sum(size for addr, size in outputs.values() if origin <= addr < origin + length)
+        out.write("%-16s %6d of %d bytes, %d free\n" % (SRAM_L, used, length, length - used))
+
+
+def read_profile(text):
+    counts = collections.Counter()
+    for line in text.splitlines():
+        words = line.split("#", 1)[0].replace(",", " ").split()
+        if not words or words[0] == "??":
+            continue
+        counts[words[0]] += int(words[1]) if len(words) > 1 and words[1].isdigit() else 1
+    return counts
+
+
+def choose(counts, inputs, budget):
+    """Most samples per byte first, while the total fits the budget."""
+    sizes = {}
+    for i in inputs:
+        if i.name.startswith(".text.") and i.size:
+            sizes[i.name[len(".text."):]] = sizes.get(i.name[len(".text."):], 0) + i.size
+    missing = [name for name in counts if name not in sizes]
+    ranked = sorted((name for name in counts if name in sizes and name not in NOT_IN_RAM),
+                    key=lambda name: (-counts[name] / sizes[name], name))
+    chosen, total = [], 0
+    for name in ranked:
+        # Thumb functions are 2-aligned, allow for the padding
+        size = (sizes[name] + 1) & ~1
+        if total + size <= budget:
+            chosen.append(name)
+            total += size
+    return chosen, total, missing
+
+
+def write_hot_list(script, names):
+    with open(script) as f:
+        text = f.read()
+    begin = text.find(HOT_BEGIN)
+    end = text.find(HOT_END)
+    if begin < 0 or end < begin:
+        sys.exit("error: no hot list markers in %s" % script)
+    indent = text[text.rfind("\n", 0, begin) + 1:begin]
+    body = "".join("%s*(.text.%s)\n" % (indent, name) for name in names)
+    head = text[:text.index("\n", begin) + 1]
+    with open(script, "w") as f:
+        f.write(head + body + indent + text[end:])
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    sub = parser.add_subparsers(dest="cmd", required=True)
+    rep = sub.add_parser("report", help="RAM cost of the code placed in RAM")
+    rep.add_argument("map")
+    hot = sub.add_parser("hot", help="write the hot list of the linker script from a profile")
+    hot.add_argument("map")
+    hot.add_argument("profile")
+    hot.add_argument("-b", "--budget", type=lambda v: int(v, 0), default=0x1000,
+                     help="bytes of RAM for the hot list (default 4096)")
+    hot.add_argument("-s", "--script", default=LD_SCRIPT)
+    hot.add_argument("-n", "--dry-run", action="store_true")
+    args = parser.parse_args()
+
+    with open(args.map) as f:
+        outputs, inputs, regions = read_map(f.read())
+
+    if args.cmd == "report":
+        report(outputs, inputs, regions, sys.stdout)
+    else:
+        with open(args.profile) as f:
+            counts = read_profile(f.read())
+        chosen, total, missing = choose(counts, inputs, args.budget)
+        for name in chosen:
+            sys.stdout.write("%-40s %8d samples\n" % (name, counts[name]))
+        sys.stdout.write("%d functions, %d bytes of %d\n" % (len(chosen), total, args.budget))
+        if missing:
+            sys.stderr.write("warning: not a .text.<name> section, skipped: %s\n"
+                             % " ".join(sorted(missing)))
+        if not args.dry_run:
+            write_hot_list(args.script, chosen)
+
+
+if __name__ == "__main__":
+    main()